@@ -6,9 +6,15 @@
 
 #include "core/fdrm/fx_crypt.h"
 
+#include "core/fdrm/fx_crypt_cpu.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
 
+#if defined(FX_CRYPT_HAS_X86_ACCELERATION)
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#endif
+
 #define mulby2(x) (((x & 0x7F) << 1) ^ (x & 0x80 ? 0x1B : 0))
 #define GET_32BIT_MSB_FIRST(cp)                    \
   (((unsigned long)(unsigned char)(cp)[3]) |       \
@@ -634,6 +640,113 @@ void aes_encrypt_cbc(unsigned char* dest,
   memcpy(ctx->iv, iv, sizeof(iv));
 }
 
+#if defined(FX_CRYPT_HAS_X86_ACCELERATION)
+// The key schedules, like the IV, are stored as big-endian words. AES-NI
+// operates on the same round keys in byte order, so convert on load.
+FX_CRYPT_TARGET("sse2")
+__m128i aesni_load_words(const unsigned int* words) {
+  unsigned char bytes[16];
+  for (int i = 0; i < 4; i++)
+    PUT_32BIT_MSB_FIRST(bytes + 4 * i, words[i]);
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+}
+
+FX_CRYPT_TARGET("sse2")
+void aesni_store_words(__m128i value, unsigned int* words) {
+  unsigned char bytes[16];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), value);
+  for (int i = 0; i < 4; i++)
+    words[i] = GET_32BIT_MSB_FIRST(bytes + 4 * i);
+}
+
+// |invkeysched| holds the round keys for the equivalent inverse cipher, in
+// decryption order, which is exactly the layout AESDEC expects.
+FX_CRYPT_TARGET("aes,sse2")
+void aes_decrypt_cbc_aesni(unsigned char* dest,
+                           const unsigned char* src,
+                           int len,
+                           CRYPT_aes_context* ctx) {
+  DCHECK_EQ((len & 15), 0);
+  const int nr = ctx->Nr;
+  __m128i rk[CRYPT_aes_context::kMaxNr + 1];
+  for (int i = 0; i <= nr; i++)
+    rk[i] = aesni_load_words(ctx->invkeysched + i * 4);
+
+  __m128i iv = aesni_load_words(ctx->iv);
+  // CBC decryption has no dependency between blocks, so interleave four of
+  // them to keep the AES unit pipeline full.
+  while (len >= 64) {
+    const __m128i* in = reinterpret_cast<const __m128i*>(src);
+    __m128i c0 = _mm_loadu_si128(in);
+    __m128i c1 = _mm_loadu_si128(in + 1);
+    __m128i c2 = _mm_loadu_si128(in + 2);
+    __m128i c3 = _mm_loadu_si128(in + 3);
+    __m128i x0 = _mm_xor_si128(c0, rk[0]);
+    __m128i x1 = _mm_xor_si128(c1, rk[0]);
+    __m128i x2 = _mm_xor_si128(c2, rk[0]);
+    __m128i x3 = _mm_xor_si128(c3, rk[0]);
+    for (int i = 1; i < nr; i++) {
+      x0 = _mm_aesdec_si128(x0, rk[i]);
+      x1 = _mm_aesdec_si128(x1, rk[i]);
+      x2 = _mm_aesdec_si128(x2, rk[i]);
+      x3 = _mm_aesdec_si128(x3, rk[i]);
+    }
+    x0 = _mm_aesdeclast_si128(x0, rk[nr]);
+    x1 = _mm_aesdeclast_si128(x1, rk[nr]);
+    x2 = _mm_aesdeclast_si128(x2, rk[nr]);
+    x3 = _mm_aesdeclast_si128(x3, rk[nr]);
+    __m128i* out = reinterpret_cast<__m128i*>(dest);
+    _mm_storeu_si128(out, _mm_xor_si128(x0, iv));
+    _mm_storeu_si128(out + 1, _mm_xor_si128(x1, c0));
+    _mm_storeu_si128(out + 2, _mm_xor_si128(x2, c1));
+    _mm_storeu_si128(out + 3, _mm_xor_si128(x3, c2));
+    iv = c3;
+    dest += 64;
+    src += 64;
+    len -= 64;
+  }
+  while (len > 0) {
+    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i x = _mm_xor_si128(c, rk[0]);
+    for (int i = 1; i < nr; i++)
+      x = _mm_aesdec_si128(x, rk[i]);
+    x = _mm_aesdeclast_si128(x, rk[nr]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), _mm_xor_si128(x, iv));
+    iv = c;
+    dest += 16;
+    src += 16;
+    len -= 16;
+  }
+  aesni_store_words(iv, ctx->iv);
+}
+
+FX_CRYPT_TARGET("aes,sse2")
+void aes_encrypt_cbc_aesni(unsigned char* dest,
+                           const unsigned char* src,
+                           int len,
+                           CRYPT_aes_context* ctx) {
+  DCHECK_EQ((len & 15), 0);
+  const int nr = ctx->Nr;
+  __m128i rk[CRYPT_aes_context::kMaxNr + 1];
+  for (int i = 0; i <= nr; i++)
+    rk[i] = aesni_load_words(ctx->keysched + i * 4);
+
+  __m128i iv = aesni_load_words(ctx->iv);
+  while (len > 0) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    x = _mm_xor_si128(_mm_xor_si128(x, iv), rk[0]);
+    for (int i = 1; i < nr; i++)
+      x = _mm_aesenc_si128(x, rk[i]);
+    iv = _mm_aesenclast_si128(x, rk[nr]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), iv);
+    dest += 16;
+    src += 16;
+    len -= 16;
+  }
+  aesni_store_words(iv, ctx->iv);
+}
+#endif  // defined(FX_CRYPT_HAS_X86_ACCELERATION)
+
 }  // namespace
 
 void CRYPT_AESSetKey(CRYPT_aes_context* context,
@@ -651,6 +764,12 @@ void CRYPT_AESDecrypt(CRYPT_aes_context* context,
                       uint8_t* dest,
                       const uint8_t* src,
                       uint32_t size) {
+#if defined(FX_CRYPT_HAS_X86_ACCELERATION)
+  if (CRYPT_CPUHasAESInstructions()) {
+    aes_decrypt_cbc_aesni(dest, src, size, context);
+    return;
+  }
+#endif
   aes_decrypt_cbc(dest, src, size, context);
 }
 
@@ -658,5 +777,11 @@ void CRYPT_AESEncrypt(CRYPT_aes_context* context,
                       uint8_t* dest,
                       const uint8_t* src,
                       uint32_t size) {
+#if defined(FX_CRYPT_HAS_X86_ACCELERATION)
+  if (CRYPT_CPUHasAESInstructions()) {
+    aes_encrypt_cbc_aesni(dest, src, size, context);
+    return;
+  }
+#endif
   aes_encrypt_cbc(dest, src, size, context);
 }
@@ -0,0 +1,80 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fdrm/fx_crypt_cpu.h"
+
+#if defined(FX_CRYPT_HAS_X86_ACCELERATION)
+#include <cpuid.h>
+#endif
+
+namespace {
+
+bool g_bForceScalarCrypto = false;
+
+#if defined(FX_CRYPT_HAS_X86_ACCELERATION)
+// CPUID.01H:ECX bits.
+constexpr unsigned int kSSSE3Bit = 1u << 9;
+constexpr unsigned int kSSE41Bit = 1u << 19;
+constexpr unsigned int kAESBit = 1u << 25;
+
+// CPUID.(EAX=07H, ECX=0):EBX bits.
+constexpr unsigned int kSHABit = 1u << 29;
+
+struct CPUFeatures {
+  bool aes = false;
+  bool sha = false;
+};
+
+CPUFeatures DetectCPUFeatures() {
+  CPUFeatures features;
+  unsigned int eax = 0;
+  unsigned int ebx = 0;
+  unsigned int ecx = 0;
+  unsigned int edx = 0;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return features;
+
+  const bool has_ssse3 = (ecx & kSSSE3Bit) != 0;
+  const bool has_sse41 = (ecx & kSSE41Bit) != 0;
+  features.aes = has_sse41 && (ecx & kAESBit) != 0;
+  if (__get_cpuid_max(0, nullptr) < 7)
+    return features;
+
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  features.sha = has_ssse3 && has_sse41 && (ebx & kSHABit) != 0;
+  return features;
+}
+
+const CPUFeatures& GetCPUFeatures() {
+  static const CPUFeatures features = DetectCPUFeatures();
+  return features;
+}
+#endif  // defined(FX_CRYPT_HAS_X86_ACCELERATION)
+
+}  // namespace
+
+bool CRYPT_CPUHasAESInstructions() {
+#if defined(FX_CRYPT_HAS_X86_ACCELERATION)
+  return !g_bForceScalarCrypto && GetCPUFeatures().aes;
+#else
+  return false;
+#endif
+}
+
+bool CRYPT_CPUHasSHAInstructions() {
+#if defined(FX_CRYPT_HAS_X86_ACCELERATION)
+  return !g_bForceScalarCrypto && GetCPUFeatures().sha;
+#else
+  return false;
+#endif
+}
+
+ScopedForceScalarCrypto::ScopedForceScalarCrypto()
+    : m_bPrevious(g_bForceScalarCrypto) {
+  g_bForceScalarCrypto = true;
+}
+
+ScopedForceScalarCrypto::~ScopedForceScalarCrypto() {
+  g_bForceScalarCrypto = m_bPrevious;
+}
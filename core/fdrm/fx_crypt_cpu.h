@@ -0,0 +1,36 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FDRM_FX_CRYPT_CPU_H_
+#define CORE_FDRM_FX_CRYPT_CPU_H_
+
+#include "build/build_config.h"
+
+// Hardware-accelerated code paths are only compiled for x86 with compilers
+// that allow enabling instruction sets on a per-function basis, so that the
+// rest of PDFium keeps building for the baseline ISA.
+#if defined(ARCH_CPU_X86_FAMILY) && (defined(__clang__) || defined(__GNUC__))
+#define FX_CRYPT_HAS_X86_ACCELERATION 1
+#define FX_CRYPT_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// Runtime CPU feature checks. The results are computed once and cached.
+// Always false when FX_CRYPT_HAS_X86_ACCELERATION is not defined.
+bool CRYPT_CPUHasAESInstructions();
+bool CRYPT_CPUHasSHAInstructions();
+
+// Makes the checks above return false while in scope, so that tests can run
+// the portable code on any CPU.
+class ScopedForceScalarCrypto {
+ public:
+  ScopedForceScalarCrypto();
+  ScopedForceScalarCrypto(const ScopedForceScalarCrypto&) = delete;
+  ScopedForceScalarCrypto& operator=(const ScopedForceScalarCrypto&) = delete;
+  ~ScopedForceScalarCrypto();
+
+ private:
+  const bool m_bPrevious;
+};
+
+#endif  // CORE_FDRM_FX_CRYPT_CPU_H_
@@ -6,6 +6,12 @@
 
 #include "core/fdrm/fx_crypt.h"
 
+#include "core/fdrm/fx_crypt_cpu.h"
+
+#if defined(FX_CRYPT_HAS_X86_ACCELERATION)
+#include <immintrin.h>
+#endif
+
 #define SHA_GET_UINT32(n, b, i)                                         \
   {                                                                     \
     (n) = ((uint32_t)(b)[(i)] << 24) | ((uint32_t)(b)[(i) + 1] << 16) | \
@@ -242,6 +248,99 @@ void sha256_process(CRYPT_sha2_context* ctx, const uint8_t data[64]) {
   ctx->state[7] += H;
 }
 
+#if defined(FX_CRYPT_HAS_X86_ACCELERATION)
+const uint32_t sha256_constants[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1,
+    0x923F82A4, 0xAB1C5ED5, 0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+    0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174, 0xE49B69C1, 0xEFBE4786,
+    0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147,
+    0x06CA6351, 0x14292967, 0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+    0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85, 0xA2BFE8A1, 0xA81A664B,
+    0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A,
+    0x5B9CCA4F, 0x682E6FF3, 0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+    0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+// SHA-256 compression using the Intel SHA extensions. Each iteration of the
+// inner loop performs four rounds; the message schedule for the next group is
+// derived from the previous four groups held in |msg|.
+FX_CRYPT_TARGET("sha,sse4.1,ssse3")
+void sha256_process_shani(uint32_t state[8],
+                          const uint8_t* data,
+                          uint32_t blocks) {
+  const __m128i byte_swap =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  // Rearrange the state from ABCD/EFGH into the ABEF/CDGH halves that
+  // SHA256RNDS2 operates on.
+  __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+  __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+  tmp = _mm_shuffle_epi32(tmp, 0xB1);
+  state1 = _mm_shuffle_epi32(state1, 0x1B);
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+  while (blocks--) {
+    const __m128i abef_save = state0;
+    const __m128i cdgh_save = state1;
+    __m128i msg[4];
+    for (int i = 0; i < 16; ++i) {
+      if (i < 4) {
+        msg[i] = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)),
+            byte_swap);
+      }
+      __m128i w = _mm_add_epi32(
+          msg[i % 4], _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                          sha256_constants + 4 * i)));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, w);
+      if (i >= 3 && i < 15) {
+        __m128i& next = msg[(i + 1) % 4];
+        next = _mm_add_epi32(
+            next, _mm_alignr_epi8(msg[i % 4], msg[(i + 3) % 4], 4));
+        next = _mm_sha256msg2_epu32(next, msg[i % 4]);
+      }
+      w = _mm_shuffle_epi32(w, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, w);
+      if (i >= 1 && i < 13) {
+        __m128i& prev = msg[(i + 3) % 4];
+        prev = _mm_sha256msg1_epu32(prev, msg[i % 4]);
+      }
+    }
+    state0 = _mm_add_epi32(state0, abef_save);
+    state1 = _mm_add_epi32(state1, cdgh_save);
+    data += 64;
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1B);
+  state1 = _mm_shuffle_epi32(state1, 0xB1);
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+  state1 = _mm_alignr_epi8(state1, tmp, 8);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+}
+#endif  // defined(FX_CRYPT_HAS_X86_ACCELERATION)
+
+void sha256_process_blocks(CRYPT_sha2_context* ctx,
+                           const uint8_t* data,
+                           uint32_t blocks) {
+#if defined(FX_CRYPT_HAS_X86_ACCELERATION)
+  if (CRYPT_CPUHasSHAInstructions()) {
+    uint32_t state[8];
+    for (int i = 0; i < 8; ++i)
+      state[i] = static_cast<uint32_t>(ctx->state[i]);
+    sha256_process_shani(state, data, blocks);
+    for (int i = 0; i < 8; ++i)
+      ctx->state[i] = state[i];
+    return;
+  }
+#endif
+  for (uint32_t i = 0; i < blocks; ++i)
+    sha256_process(ctx, data + 64 * i);
+}
+
 const uint8_t sha256_padding[64] = {
     0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
     0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -449,15 +548,16 @@ void CRYPT_SHA256Update(CRYPT_sha2_context* context,
   context->total_bytes += size;
   if (left && size >= fill) {
     memcpy(context->buffer + left, data, fill);
-    sha256_process(context, context->buffer);
+    sha256_process_blocks(context, context->buffer, 1);
     size -= fill;
     data += fill;
     left = 0;
   }
-  while (size >= 64) {
-    sha256_process(context, data);
-    size -= 64;
-    data += 64;
+  if (size >= 64) {
+    uint32_t blocks = size / 64;
+    sha256_process_blocks(context, data, blocks);
+    size -= blocks * 64;
+    data += blocks * 64;
   }
   if (size)
     memcpy(context->buffer + left, data, size);
@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "core/fdrm/fx_crypt_cpu.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/utils/hash.h"
 #include "third_party/base/cxx17_backports.h"
@@ -29,6 +30,20 @@ void CheckArcFourContext(const CRYPT_rc4_context& context,
     EXPECT_EQ(expected_permutation[i], context.m[i]) << i;
 }
 
+// Runs |check| through the code CRYPT_* picks on this CPU, which is the
+// accelerated one when the CPU supports it, and then through the portable
+// code.
+template <typename T>
+void CheckAllCodePaths(T check) {
+  {
+    SCOPED_TRACE("default code path");
+    check();
+  }
+  ScopedForceScalarCrypto force_scalar;
+  SCOPED_TRACE("portable code path");
+  check();
+}
+
 }  // namespace
 
 // Originally from chromium's /src/base/md5_unittest.cc.
@@ -237,45 +252,202 @@ TEST(FXCRYPT, Sha1TestA2) {
 }
 
 TEST(FXCRYPT, Sha256Empty) {
-  static const char kInput[] = "";
-  static const uint8_t kExpected[32] = {
-      0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4,
-      0xc8, 0x99, 0x6f, 0xb9, 0x24, 0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b,
-      0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55};
-  uint8_t actual[32];
-  CRYPT_SHA256Generate(reinterpret_cast<const uint8_t*>(kInput), strlen(kInput),
-                       actual);
-  for (size_t i = 0; i < pdfium::size(kExpected); ++i)
-    EXPECT_EQ(kExpected[i], actual[i]) << " at byte " << i;
+  CheckAllCodePaths([] {
+    static const char kInput[] = "";
+    static const uint8_t kExpected[32] = {
+        0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4,
+        0xc8, 0x99, 0x6f, 0xb9, 0x24, 0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b,
+        0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55};
+    uint8_t actual[32];
+    CRYPT_SHA256Generate(reinterpret_cast<const uint8_t*>(kInput),
+                         strlen(kInput), actual);
+    for (size_t i = 0; i < pdfium::size(kExpected); ++i)
+      EXPECT_EQ(kExpected[i], actual[i]) << " at byte " << i;
+  });
 }
 
 TEST(FXCRYPT, Sha256TestB1) {
-  // Example B.1 from FIPS 180-2: one-block message.
-  static const char kInput[] = "abc";
-  static const uint8_t kExpected[32] = {
-      0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40,
-      0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17,
-      0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
-  uint8_t actual[32];
-  CRYPT_SHA256Generate(reinterpret_cast<const uint8_t*>(kInput), strlen(kInput),
-                       actual);
-  for (size_t i = 0; i < pdfium::size(kExpected); ++i)
-    EXPECT_EQ(kExpected[i], actual[i]) << " at byte " << i;
+  CheckAllCodePaths([] {
+    // Example B.1 from FIPS 180-2: one-block message.
+    static const char kInput[] = "abc";
+    static const uint8_t kExpected[32] = {
+        0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40,
+        0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17,
+        0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+    uint8_t actual[32];
+    CRYPT_SHA256Generate(reinterpret_cast<const uint8_t*>(kInput),
+                         strlen(kInput), actual);
+    for (size_t i = 0; i < pdfium::size(kExpected); ++i)
+      EXPECT_EQ(kExpected[i], actual[i]) << " at byte " << i;
+  });
 }
 
 TEST(FXCRYPT, Sha256TestB2) {
-  // Example B.2 from FIPS 180-2: multi-block message.
-  static const char kInput[] =
-      "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
-  static const uint8_t kExpected[32] = {
-      0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26,
-      0x93, 0x0c, 0x3e, 0x60, 0x39, 0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff,
-      0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1};
-  uint8_t actual[32];
-  CRYPT_SHA256Generate(reinterpret_cast<const uint8_t*>(kInput), strlen(kInput),
-                       actual);
-  for (size_t i = 0; i < pdfium::size(kExpected); ++i)
-    EXPECT_EQ(kExpected[i], actual[i]) << " at byte " << i;
+  CheckAllCodePaths([] {
+    // Example B.2 from FIPS 180-2: multi-block message.
+    static const char kInput[] =
+        "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    static const uint8_t kExpected[32] = {
+        0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26,
+        0x93, 0x0c, 0x3e, 0x60, 0x39, 0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff,
+        0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1};
+    uint8_t actual[32];
+    CRYPT_SHA256Generate(reinterpret_cast<const uint8_t*>(kInput),
+                         strlen(kInput), actual);
+    for (size_t i = 0; i < pdfium::size(kExpected); ++i)
+      EXPECT_EQ(kExpected[i], actual[i]) << " at byte " << i;
+  });
+}
+
+TEST(FXCRYPT, Sha256TestLongData) {
+  CheckAllCodePaths([] {
+    // One million repetitions of 'a', from the FIPS 180-2 examples. Fed in
+    // uneven chunks to exercise both the buffered and multi-block paths.
+    const std::vector<uint8_t> data(1000000, 'a');
+    static const uint8_t kExpected[32] = {
+        0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7,
+        0xe2, 0x84, 0xd7, 0x3e, 0x67, 0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97,
+        0x20, 0x0e, 0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0};
+    uint8_t actual[32];
+    CRYPT_SHA256Generate(data.data(), data.size(), actual);
+    for (size_t i = 0; i < pdfium::size(kExpected); ++i)
+      EXPECT_EQ(kExpected[i], actual[i]) << " at byte " << i;
+
+    CRYPT_sha2_context context;
+    CRYPT_SHA256Start(&context);
+    uint32_t offset = 0;
+    for (uint32_t chunk = 1; offset < data.size(); chunk = chunk * 7 % 1021) {
+      uint32_t size = std::min<uint32_t>(chunk, data.size() - offset);
+      CRYPT_SHA256Update(&context, data.data() + offset, size);
+      offset += size;
+    }
+    CRYPT_SHA256Finish(&context, actual);
+    for (size_t i = 0; i < pdfium::size(kExpected); ++i)
+      EXPECT_EQ(kExpected[i], actual[i]) << " at byte " << i;
+  });
+}
+
+TEST(FXCRYPT, ForceScalarCrypto) {
+  const bool has_aes = CRYPT_CPUHasAESInstructions();
+  const bool has_sha = CRYPT_CPUHasSHAInstructions();
+  {
+    ScopedForceScalarCrypto force_scalar;
+    EXPECT_FALSE(CRYPT_CPUHasAESInstructions());
+    EXPECT_FALSE(CRYPT_CPUHasSHAInstructions());
+  }
+  EXPECT_EQ(has_aes, CRYPT_CPUHasAESInstructions());
+  EXPECT_EQ(has_sha, CRYPT_CPUHasSHAInstructions());
+}
+
+TEST(FXCRYPT, AESCBCKnownAnswer) {
+  CheckAllCodePaths([] {
+    // Test vectors F.2.1 through F.2.6 from NIST SP 800-38A.
+    static const uint8_t kIV[16] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+                                    0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+                                    0x0c, 0x0d, 0x0e, 0x0f};
+    static const uint8_t kPlaintext[64] = {
+        0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+        0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03,
+        0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51, 0x30,
+        0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19,
+        0x1a, 0x0a, 0x52, 0xef, 0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b,
+        0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10};
+    static const uint8_t kKey128[16] = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae,
+                                        0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88,
+                                        0x09, 0xcf, 0x4f, 0x3c};
+    static const uint8_t kCiphertext128[64] = {
+        0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e,
+        0x9b, 0x12, 0xe9, 0x19, 0x7d, 0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72,
+        0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2, 0x73,
+        0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e,
+        0x22, 0x22, 0x95, 0x16, 0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac,
+        0x09, 0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7};
+    static const uint8_t kKey192[24] = {
+        0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b,
+        0x80, 0x90, 0x79, 0xe5, 0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b};
+    static const uint8_t kCiphertext192[64] = {
+        0x4f, 0x02, 0x1d, 0xb2, 0x43, 0xbc, 0x63, 0x3d, 0x71, 0x78, 0x18,
+        0x3a, 0x9f, 0xa0, 0x71, 0xe8, 0xb4, 0xd9, 0xad, 0xa9, 0xad, 0x7d,
+        0xed, 0xf4, 0xe5, 0xe7, 0x38, 0x76, 0x3f, 0x69, 0x14, 0x5a, 0x57,
+        0x1b, 0x24, 0x20, 0x12, 0xfb, 0x7a, 0xe0, 0x7f, 0xa9, 0xba, 0xac,
+        0x3d, 0xf1, 0x02, 0xe0, 0x08, 0xb0, 0xe2, 0x79, 0x88, 0x59, 0x88,
+        0x81, 0xd9, 0x20, 0xa9, 0xe6, 0x4f, 0x56, 0x15, 0xcd};
+    static const uint8_t kKey256[32] = {
+        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae,
+        0xf0, 0x85, 0x7d, 0x77, 0x81, 0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61,
+        0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4};
+    static const uint8_t kCiphertext256[64] = {
+        0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba, 0x77, 0x9e, 0xab,
+        0xfb, 0x5f, 0x7b, 0xfb, 0xd6, 0x9c, 0xfc, 0x4e, 0x96, 0x7e, 0xdb,
+        0x80, 0x8d, 0x67, 0x9f, 0x77, 0x7b, 0xc6, 0x70, 0x2c, 0x7d, 0x39,
+        0xf2, 0x33, 0x69, 0xa9, 0xd9, 0xba, 0xcf, 0xa5, 0x30, 0xe2, 0x63,
+        0x04, 0x23, 0x14, 0x61, 0xb2, 0xeb, 0x05, 0xe2, 0xc3, 0x9b, 0xe9,
+        0xfc, 0xda, 0x6c, 0x19, 0x07, 0x8c, 0x6a, 0x9d, 0x1b};
+    static const struct {
+      const uint8_t* key;
+      uint32_t key_len;
+      const uint8_t* ciphertext;
+    } kTestCases[] = {
+        {kKey128, sizeof(kKey128), kCiphertext128},
+        {kKey192, sizeof(kKey192), kCiphertext192},
+        {kKey256, sizeof(kKey256), kCiphertext256},
+    };
+
+    for (const auto& test_case : kTestCases) {
+      SCOPED_TRACE(test_case.key_len);
+      CRYPT_aes_context context;
+      uint8_t actual[64];
+      CRYPT_AESSetKey(&context, test_case.key, test_case.key_len);
+      CRYPT_AESSetIV(&context, kIV);
+      CRYPT_AESEncrypt(&context, actual, kPlaintext, sizeof(actual));
+      for (size_t i = 0; i < sizeof(actual); ++i)
+        EXPECT_EQ(test_case.ciphertext[i], actual[i]) << " at byte " << i;
+
+      CRYPT_AESSetIV(&context, kIV);
+      CRYPT_AESDecrypt(&context, actual, test_case.ciphertext, sizeof(actual));
+      for (size_t i = 0; i < sizeof(actual); ++i)
+        EXPECT_EQ(kPlaintext[i], actual[i]) << " at byte " << i;
+
+      // The IV must chain across calls, one block at a time.
+      CRYPT_AESSetIV(&context, kIV);
+      for (size_t i = 0; i < sizeof(actual); i += 16)
+        CRYPT_AESDecrypt(&context, actual + i, test_case.ciphertext + i, 16);
+      for (size_t i = 0; i < sizeof(actual); ++i)
+        EXPECT_EQ(kPlaintext[i], actual[i]) << " at byte " << i;
+    }
+  });
+}
+
+TEST(FXCRYPT, AESCBCRoundTripLongData) {
+  CheckAllCodePaths([] {
+    static const uint8_t kKey[32] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd,
+                                     0xef, 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54,
+                                     0x32, 0x10, 0x00, 0x11, 0x22, 0x33, 0x44,
+                                     0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb,
+                                     0xcc, 0xdd, 0xee, 0xff};
+    static const uint8_t kIV[16] = {};
+
+    // An odd number of blocks, so both the bulk and the tail paths are used.
+    std::vector<uint8_t> plaintext(16 * 1027);
+    for (size_t i = 0; i < plaintext.size(); ++i)
+      plaintext[i] = static_cast<uint8_t>(i * 31 + (i >> 8));
+
+    CRYPT_aes_context context;
+    CRYPT_AESSetKey(&context, kKey, sizeof(kKey));
+    CRYPT_AESSetIV(&context, kIV);
+    std::vector<uint8_t> ciphertext(plaintext.size());
+    CRYPT_AESEncrypt(&context, ciphertext.data(), plaintext.data(),
+                     ciphertext.size());
+    EXPECT_NE(plaintext, ciphertext);
+
+    // Decrypt in place, split into two calls at a non-multiple of four blocks.
+    std::vector<uint8_t> decrypted = ciphertext;
+    CRYPT_AESSetIV(&context, kIV);
+    CRYPT_AESDecrypt(&context, decrypted.data(), decrypted.data(), 16 * 5);
+    CRYPT_AESDecrypt(&context, decrypted.data() + 16 * 5,
+                     decrypted.data() + 16 * 5, decrypted.size() - 16 * 5);
+    EXPECT_EQ(plaintext, decrypted);
+  });
 }
 
 TEST(FXCRYPT, CRYPT_ArcFourSetup) {
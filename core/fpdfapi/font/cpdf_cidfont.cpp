@@ -442,10 +442,13 @@ bool CPDF_CIDFont::Load() {
     m_pCID2UnicodeMap = manager->GetCID2UnicodeMap(m_Charset);
   }
   if (m_Font.GetFaceRec()) {
+    FXFT_FaceRec* face = m_Font.GetFaceRec();
     if (m_bType1)
-      FXFT_Select_Charmap(m_Font.GetFaceRec(), FT_ENCODING_UNICODE);
+      FXFT_Select_Charmap(face, FT_ENCODING_UNICODE);
     else
-      FT_UseCIDCharmap(m_Font.GetFaceRec(), m_pCMap->GetCoding());
+      FT_UseCIDCharmap(face, m_pCMap->GetCoding());
+    if (FXFT_Get_Face_Charmap(face))
+      m_CharmapIndex = FT_Get_Charmap_Index(FXFT_Get_Face_Charmap(face));
   }
   m_DefaultWidth = pCIDFontDict->GetIntegerFor("DW", 1000);
   const CPDF_Array* pWidthArray = pCIDFontDict->GetArrayFor("W");
@@ -758,9 +761,16 @@ int CPDF_CIDFont::GlyphFromCharCode(uint32_t charcode, bool* pVertGlyph) {
     return unicode;
   }
 
-  if (!m_Font.GetFaceRec())
+  FXFT_FaceRec* face = m_Font.GetFaceRec();
+  if (!face)
     return -1;
 
+  if (m_CharmapIndex >= 0 &&
+      FXFT_Get_Face_Charmap(face) !=
+          FXFT_Get_Face_Charmaps(face)[m_CharmapIndex]) {
+    FT_Set_Charmap(face, FXFT_Get_Face_Charmaps(face)[m_CharmapIndex]);
+  }
+
   uint16_t cid = CIDFromCharCode(charcode);
   if (!m_pStreamAcc) {
     if (m_bType1)
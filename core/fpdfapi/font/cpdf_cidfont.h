@@ -79,6 +79,9 @@ class CPDF_CIDFont final : public CPDF_Font {
   bool m_bAnsiWidthsFixed = false;
   bool m_bAdobeCourierStd = false;
   CIDSet m_Charset = CIDSET_UNKNOWN;
+  // Charmap selected when loading, or -1. Embedded faces can be shared with
+  // fonts from other documents, which may select a different charmap.
+  int m_CharmapIndex = -1;
   int16_t m_DefaultWidth = 1000;
   int16_t m_DefaultVY = 880;
   int16_t m_DefaultW1 = -1000;
@@ -222,6 +222,8 @@ bool CPDF_SimpleFont::LoadCommon() {
   if (!FontStyleIsSymbolic(m_Flags))
     m_BaseEncoding = PDFFONT_ENCODING_STANDARD;
   LoadPDFEncoding(!!m_pFontFile, m_Font.IsTTFont());
+  // The face may be shared with fonts from other documents, so the charmap
+  // this selects is only relied upon until |m_GlyphIndex| is filled in.
   LoadGlyphMap();
   m_CharNames.clear();
   if (!m_Font.GetFaceRec())
@@ -0,0 +1,170 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/font/cpdf_simplefont.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/page/cpdf_pagemodule.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_reference.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
+#include "core/fxge/cfx_font.h"
+#include "core/fxge/fx_font.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/file_util.h"
+#include "testing/utils/path_service.h"
+
+namespace {
+
+constexpr uint32_t kCharCode = 1;
+constexpr int kUnicodeGlyph = 5;
+constexpr int kSjisGlyph = 6;
+
+void AppendUint16(std::vector<uint8_t>* data, uint16_t value) {
+  data->push_back(value >> 8);
+  data->push_back(value & 0xff);
+}
+
+void AppendUint32(std::vector<uint8_t>* data, uint32_t value) {
+  AppendUint16(data, value >> 16);
+  AppendUint16(data, value & 0xffff);
+}
+
+void AppendCmapSubtable(std::vector<uint8_t>* data, uint16_t glyph) {
+  // Format 6 maps the one char code to |glyph|.
+  AppendUint16(data, 6);
+  AppendUint16(data, 12);
+  AppendUint16(data, 0);
+  AppendUint16(data, kCharCode);
+  AppendUint16(data, 1);
+  AppendUint16(data, glyph);
+}
+
+// Returns Ahem with its cmap replaced by a Unicode charmap, which FreeType
+// selects when opening the font, and a Shift-JIS charmap, which maps
+// |kCharCode| to another glyph.
+std::vector<uint8_t> MakeTestFont() {
+  std::string path;
+  if (!PathService::GetTestFilePath("fonts/Ahem.ttf", &path))
+    return {};
+
+  size_t size;
+  std::unique_ptr<char, pdfium::FreeDeleter> contents =
+      GetFileContents(path.c_str(), &size);
+  if (!contents || size < 12)
+    return {};
+
+  const uint8_t* start = reinterpret_cast<const uint8_t*>(contents.get());
+  std::vector<uint8_t> data(start, start + size);
+  data.resize((data.size() + 3) & ~3);
+  const size_t cmap_offset = data.size();
+  AppendUint16(&data, 0);
+  AppendUint16(&data, 2);
+  AppendUint16(&data, 0);
+  AppendUint16(&data, 3);
+  AppendUint32(&data, 20);
+  AppendUint16(&data, 3);
+  AppendUint16(&data, 2);
+  AppendUint32(&data, 32);
+  AppendCmapSubtable(&data, kUnicodeGlyph);
+  AppendCmapSubtable(&data, kSjisGlyph);
+
+  // Point the table directory at the new cmap.
+  const size_t num_tables = data[4] << 8 | data[5];
+  for (size_t i = 0; i < num_tables; ++i) {
+    const size_t record = 12 + 16 * i;
+    if (record + 16 > cmap_offset)
+      return {};
+    if (memcmp(&data[record], "cmap", 4) != 0)
+      continue;
+
+    std::vector<uint8_t> location;
+    AppendUint32(&location, cmap_offset);
+    AppendUint32(&location, data.size() - cmap_offset);
+    std::copy(location.begin(), location.end(), data.begin() + record + 8);
+    return data;
+  }
+  return {};
+}
+
+}  // namespace
+
+class CPDF_SimpleFontTest : public testing::Test {
+ protected:
+  void SetUp() override { CPDF_PageModule::Create(); }
+  void TearDown() override { CPDF_PageModule::Destroy(); }
+
+  // Returns a document holding |font_data| as a font program.
+  std::unique_ptr<CPDF_Document> MakeDocument(
+      const std::vector<uint8_t>& font_data) {
+    auto doc = std::make_unique<CPDF_Document>(
+        std::make_unique<CPDF_DocRenderData>(),
+        std::make_unique<CPDF_DocPageData>());
+    auto* font_file = doc->NewIndirect<CPDF_Stream>();
+    font_file->SetData(font_data);
+    m_FontFileObjNum = font_file->GetObjNum();
+    return doc;
+  }
+
+  RetainPtr<CPDF_Font> LoadFont(CPDF_Document* doc,
+                                const char* subtype,
+                                int flags,
+                                const char* encoding) {
+    auto* font_desc = doc->NewIndirect<CPDF_Dictionary>();
+    font_desc->SetNewFor<CPDF_Name>("Type", "FontDescriptor");
+    font_desc->SetNewFor<CPDF_Name>("FontName", "Ahem");
+    font_desc->SetNewFor<CPDF_Number>("Flags", flags);
+    font_desc->SetNewFor<CPDF_Reference>("FontFile2", doc, m_FontFileObjNum);
+
+    auto* font_dict = doc->NewIndirect<CPDF_Dictionary>();
+    font_dict->SetNewFor<CPDF_Name>("Type", "Font");
+    font_dict->SetNewFor<CPDF_Name>("Subtype", subtype);
+    font_dict->SetNewFor<CPDF_Name>("BaseFont", "Ahem");
+    if (encoding)
+      font_dict->SetNewFor<CPDF_Name>("Encoding", encoding);
+    font_dict->SetNewFor<CPDF_Reference>("FontDescriptor", doc,
+                                         font_desc->GetObjNum());
+    return CPDF_Font::Create(doc, font_dict, nullptr);
+  }
+
+ private:
+  uint32_t m_FontFileObjNum = 0;
+};
+
+TEST_F(CPDF_SimpleFontTest, SharedFaceWithOtherCharmap) {
+  std::vector<uint8_t> font_data = MakeTestFont();
+  ASSERT_FALSE(font_data.empty());
+
+  // A symbolic Type 1 font selects the Shift-JIS charmap of the face.
+  std::unique_ptr<CPDF_Document> doc1 = MakeDocument(font_data);
+  RetainPtr<CPDF_Font> font1 =
+      LoadFont(doc1.get(), "Type1", FXFONT_SYMBOLIC, nullptr);
+  ASSERT_TRUE(font1);
+  ASSERT_TRUE(font1->IsEmbedded());
+  EXPECT_EQ(kSjisGlyph, font1->GlyphFromCharCode(kCharCode, nullptr));
+
+  // A non-symbolic TrueType font in another document gets the same face. It
+  // has no standard charmap to pick, so it uses the one FreeType selected.
+  std::unique_ptr<CPDF_Document> doc2 = MakeDocument(font_data);
+  RetainPtr<CPDF_Font> font2 = LoadFont(
+      doc2.get(), "TrueType", FXFONT_NONSYMBOLIC, "WinAnsiEncoding");
+  ASSERT_TRUE(font2);
+  ASSERT_TRUE(font2->IsEmbedded());
+  EXPECT_EQ(font1->GetFont()->GetFace(), font2->GetFont()->GetFace());
+  EXPECT_EQ(kUnicodeGlyph, font2->GlyphFromCharCode(kCharCode, nullptr));
+
+  // Neither font depends on the charmap the other left selected.
+  EXPECT_EQ(kSjisGlyph, font1->GlyphFromCharCode(kCharCode, nullptr));
+}
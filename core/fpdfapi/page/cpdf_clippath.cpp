@@ -8,8 +8,33 @@
 
 #include <utility>
 
+#include "core/fpdfapi/font/cpdf_font.h"
 #include "core/fpdfapi/page/cpdf_textobject.h"
 
+namespace {
+
+// Compares what rendering a text clip looks at. Type 3 glyphs are drawn with
+// the object's full graphics state, so those only match themselves.
+bool IsEquivalentText(const CPDF_TextObject* pText,
+                      const CPDF_TextObject* pThatText) {
+  if (pText == pThatText)
+    return true;
+  if (!pText || !pThatText)
+    return false;
+
+  RetainPtr<CPDF_Font> pFont = pText->GetFont();
+  if (pFont != pThatText->GetFont() || (pFont && pFont->IsType3Font()))
+    return false;
+
+  return pText->GetFontSize() == pThatText->GetFontSize() &&
+         pText->GetTextRenderMode() == pThatText->GetTextRenderMode() &&
+         pText->GetTextMatrix() == pThatText->GetTextMatrix() &&
+         pText->GetCharCodes() == pThatText->GetCharCodes() &&
+         pText->GetCharPositions() == pThatText->GetCharPositions();
+}
+
+}  // namespace
+
 CPDF_ClipPath::CPDF_ClipPath() = default;
 
 CPDF_ClipPath::CPDF_ClipPath(const CPDF_ClipPath& that) = default;
@@ -38,6 +63,40 @@ CPDF_TextObject* CPDF_ClipPath::GetText(size_t i) const {
   return m_Ref.GetObject()->m_TextList[i].get();
 }
 
+bool CPDF_ClipPath::IsEquivalentTo(const CPDF_ClipPath& that) const {
+  if (*this == that)
+    return true;
+  if (!HasRef() || !that.HasRef())
+    return false;
+
+  const PathData* pData = m_Ref.GetObject();
+  const PathData* pThatData = that.m_Ref.GetObject();
+  if (pData->m_PathAndTypeList.size() != pThatData->m_PathAndTypeList.size() ||
+      pData->m_TextList.size() != pThatData->m_TextList.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < pData->m_PathAndTypeList.size(); ++i) {
+    const auto& path_and_type = pData->m_PathAndTypeList[i];
+    const auto& that_path_and_type = pThatData->m_PathAndTypeList[i];
+    if (path_and_type.second != that_path_and_type.second)
+      return false;
+
+    const CFX_Path* pPath = path_and_type.first.GetObject();
+    const CFX_Path* pThatPath = that_path_and_type.first.GetObject();
+    if (pPath == pThatPath)
+      continue;
+    if (!pPath || !pThatPath || pPath->GetPoints() != pThatPath->GetPoints())
+      return false;
+  }
+  for (size_t i = 0; i < pData->m_TextList.size(); ++i) {
+    if (!IsEquivalentText(pData->m_TextList[i].get(),
+                          pThatData->m_TextList[i].get())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 CFX_FloatRect CPDF_ClipPath::GetClipBox() const {
   CFX_FloatRect rect;
   bool bStarted = false;
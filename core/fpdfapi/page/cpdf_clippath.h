@@ -35,6 +35,11 @@ class CPDF_ClipPath {
   }
   bool operator!=(const CPDF_ClipPath& that) const { return !(*this == that); }
 
+  // Returns true if both clip paths have the same paths and clip types, and
+  // text objects with the same font, size, matrix and characters, even when
+  // they do not share storage.
+  bool IsEquivalentTo(const CPDF_ClipPath& that) const;
+
   size_t GetPathCount() const;
   CPDF_Path GetPath(size_t i) const;
   CFX_FillRenderOptions::FillType GetClipType(size_t i) const;
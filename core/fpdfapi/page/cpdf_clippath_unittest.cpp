@@ -0,0 +1,124 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_clippath.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/fpdfapi/font/cpdf_font.h"
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/page/cpdf_pagemodule.h"
+#include "core/fpdfapi/page/cpdf_path.h"
+#include "core/fpdfapi/page/cpdf_textobject.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
+#include "core/fxge/cfx_fillrenderoptions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+using FillType = CFX_FillRenderOptions::FillType;
+
+CPDF_Path MakeRectPath(float left, float bottom, float right, float top) {
+  CPDF_Path path;
+  path.AppendRect(left, bottom, right, top);
+  return path;
+}
+
+}  // namespace
+
+class CPDF_ClipPathTest : public testing::Test {
+ public:
+  void SetUp() override {
+    CPDF_PageModule::Create();
+    m_pDoc = std::make_unique<CPDF_Document>(
+        std::make_unique<CPDF_DocRenderData>(),
+        std::make_unique<CPDF_DocPageData>());
+    m_pDoc->CreateNewDoc();
+  }
+
+  void TearDown() override {
+    m_pDoc.reset();
+    CPDF_PageModule::Destroy();
+  }
+
+  std::unique_ptr<CPDF_TextObject> MakeText(const char* font_name,
+                                            const ByteString& text) {
+    auto pText = std::make_unique<CPDF_TextObject>();
+    pText->m_TextState.SetFont(
+        CPDF_Font::GetStockFont(m_pDoc.get(), font_name));
+    pText->m_TextState.SetFontSize(12.0f);
+    pText->SetText(text);
+    pText->SetPosition(CFX_PointF(10, 20));
+    return pText;
+  }
+
+  CPDF_ClipPath MakeTextClip(std::unique_ptr<CPDF_TextObject> pText) {
+    CPDF_ClipPath clip_path;
+    clip_path.Emplace();
+    std::vector<std::unique_ptr<CPDF_TextObject>> texts;
+    texts.push_back(std::move(pText));
+    clip_path.AppendTexts(&texts);
+    return clip_path;
+  }
+
+ private:
+  std::unique_ptr<CPDF_Document> m_pDoc;
+};
+
+TEST_F(CPDF_ClipPathTest, PathsEquivalent) {
+  CPDF_ClipPath clip_path;
+  EXPECT_TRUE(clip_path.IsEquivalentTo(clip_path));
+  CPDF_ClipPath other;
+  EXPECT_TRUE(clip_path.IsEquivalentTo(other));
+
+  clip_path.Emplace();
+  clip_path.AppendPath(MakeRectPath(0, 0, 10, 10), FillType::kWinding);
+  EXPECT_FALSE(clip_path.IsEquivalentTo(other));
+  EXPECT_FALSE(other.IsEquivalentTo(clip_path));
+
+  // Equal paths in separate storage.
+  other.Emplace();
+  other.AppendPath(MakeRectPath(0, 0, 10, 10), FillType::kWinding);
+  EXPECT_TRUE(clip_path.IsEquivalentTo(other));
+  EXPECT_TRUE(other.IsEquivalentTo(clip_path));
+
+  CPDF_ClipPath other_type;
+  other_type.Emplace();
+  other_type.AppendPath(MakeRectPath(0, 0, 10, 10), FillType::kEvenOdd);
+  EXPECT_FALSE(clip_path.IsEquivalentTo(other_type));
+
+  CPDF_ClipPath other_points;
+  other_points.Emplace();
+  other_points.AppendPath(MakeRectPath(0, 0, 10, 11), FillType::kWinding);
+  EXPECT_FALSE(clip_path.IsEquivalentTo(other_points));
+
+  CPDF_ClipPath more_paths = other;
+  more_paths.AppendPath(MakeRectPath(5, 5, 20, 20), FillType::kWinding);
+  EXPECT_FALSE(clip_path.IsEquivalentTo(more_paths));
+}
+
+TEST_F(CPDF_ClipPathTest, TextsEquivalent) {
+  CPDF_ClipPath clip_path = MakeTextClip(MakeText("Helvetica", "Clip"));
+  EXPECT_TRUE(clip_path.IsEquivalentTo(
+      MakeTextClip(MakeText("Helvetica", "Clip"))));
+  EXPECT_FALSE(clip_path.IsEquivalentTo(
+      MakeTextClip(MakeText("Helvetica", "Clop"))));
+  EXPECT_FALSE(clip_path.IsEquivalentTo(
+      MakeTextClip(MakeText("Times-Roman", "Clip"))));
+
+  auto pMoved = MakeText("Helvetica", "Clip");
+  pMoved->SetPosition(CFX_PointF(10, 21));
+  EXPECT_FALSE(clip_path.IsEquivalentTo(MakeTextClip(std::move(pMoved))));
+
+  auto pResized = MakeText("Helvetica", "Clip");
+  pResized->m_TextState.SetFontSize(13.0f);
+  EXPECT_FALSE(clip_path.IsEquivalentTo(MakeTextClip(std::move(pResized))));
+
+  auto pRendered = MakeText("Helvetica", "Clip");
+  pRendered->SetTextRenderMode(TextRenderingMode::MODE_INVISIBLE);
+  EXPECT_FALSE(clip_path.IsEquivalentTo(MakeTextClip(std::move(pRendered))));
+}
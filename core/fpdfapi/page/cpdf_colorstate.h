@@ -52,6 +52,12 @@ class CPDF_ColorState {
                         const std::vector<float>& values);
 
   bool HasRef() const { return !!m_Ref; }
+  bool operator==(const CPDF_ColorState& that) const {
+    return m_Ref == that.m_Ref;
+  }
+  bool operator!=(const CPDF_ColorState& that) const {
+    return !(*this == that);
+  }
 
  private:
   class ColorData final : public Retainable {
@@ -17,15 +17,15 @@
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
-#include "core/fxcrt/fx_safe_types.h"
+#include "core/fpdfapi/parser/cpdf_stream_reader.h"
 #include "core/fxcrt/pauseindicator_iface.h"
-#include "core/fxcrt/span_util.h"
 #include "core/fxge/cfx_fillrenderoptions.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
+#include "third_party/base/numerics/ranges.h"
 
 CPDF_ContentParser::CPDF_ContentParser(CPDF_Page* pPage)
-    : m_CurrentStage(Stage::kGetContent), m_pObjectHolder(pPage) {
+    : m_CurrentStage(Stage::kParse), m_pObjectHolder(pPage) {
   DCHECK(pPage);
   if (!pPage->GetDocument()) {
     m_CurrentStage = Stage::kComplete;
@@ -39,9 +39,8 @@ CPDF_ContentParser::CPDF_ContentParser(CPDF_Page* pPage)
     return;
   }
 
-  CPDF_Stream* pStream = pContent->AsStream();
-  if (pStream) {
-    HandlePageContentStream(pStream);
+  if (pContent->AsStream()) {
+    m_nStreams = 1;
     return;
   }
 
@@ -98,10 +97,9 @@ CPDF_ContentParser::CPDF_ContentParser(CPDF_Form* pForm,
     pState->SetFillAlpha(1.0f);
     pState->SetSoftMask(nullptr);
   }
-  m_pSingleStream = pdfium::MakeRetain<CPDF_StreamAcc>(pForm->GetStream());
-  m_pSingleStream->LoadAllDataFiltered();
-  m_pData.Reset(m_pSingleStream->GetData());
-  m_Size = m_pSingleStream->GetSize();
+  m_pFormStream = pdfium::MakeRetain<CPDF_StreamAcc>(pForm->GetStream());
+  m_pFormStream->LoadAllDataFiltered();
+  m_nStreams = 1;
 }
 
 CPDF_ContentParser::~CPDF_ContentParser() = default;
@@ -110,15 +108,6 @@ CPDF_ContentParser::~CPDF_ContentParser() = default;
 // Continue() should be called again. Returning |false| means that we've
 // completed the parse and Continue() is complete.
 bool CPDF_ContentParser::Continue(PauseIndicatorIface* pPause) {
-  while (m_CurrentStage == Stage::kGetContent) {
-    m_CurrentStage = GetContent();
-    if (pPause && pPause->NeedToPauseNow())
-      return true;
-  }
-
-  if (m_CurrentStage == Stage::kPrepareContent)
-    m_CurrentStage = PrepareContent();
-
   while (m_CurrentStage == Stage::kParse) {
     m_CurrentStage = Parse();
     if (pPause && pPause->NeedToPauseNow())
@@ -132,58 +121,6 @@ bool CPDF_ContentParser::Continue(PauseIndicatorIface* pPause) {
   return false;
 }
 
-CPDF_ContentParser::Stage CPDF_ContentParser::GetContent() {
-  DCHECK_EQ(m_CurrentStage, Stage::kGetContent);
-  DCHECK(m_pObjectHolder->IsPage());
-  CPDF_Array* pContent =
-      m_pObjectHolder->GetDict()->GetArrayFor(pdfium::page_object::kContents);
-  CPDF_Stream* pStreamObj = ToStream(
-      pContent ? pContent->GetDirectObjectAt(m_CurrentOffset) : nullptr);
-  m_StreamArray[m_CurrentOffset] =
-      pdfium::MakeRetain<CPDF_StreamAcc>(pStreamObj);
-  m_StreamArray[m_CurrentOffset]->LoadAllDataFiltered();
-  m_CurrentOffset++;
-
-  return m_CurrentOffset == m_nStreams ? Stage::kPrepareContent
-                                       : Stage::kGetContent;
-}
-
-CPDF_ContentParser::Stage CPDF_ContentParser::PrepareContent() {
-  m_CurrentOffset = 0;
-
-  if (m_StreamArray.empty()) {
-    m_pData.Reset(m_pSingleStream->GetData());
-    m_Size = m_pSingleStream->GetSize();
-    return Stage::kParse;
-  }
-
-  FX_SAFE_UINT32 safeSize = 0;
-  for (const auto& stream : m_StreamArray) {
-    m_StreamSegmentOffsets.push_back(safeSize.ValueOrDie());
-
-    safeSize += stream->GetSize();
-    safeSize += 1;
-    if (!safeSize.IsValid())
-      return Stage::kComplete;
-  }
-
-  m_Size = safeSize.ValueOrDie();
-  m_pData.Reset(
-      std::unique_ptr<uint8_t, FxFreeDeleter>(FX_TryAlloc(uint8_t, m_Size)));
-  if (!m_pData)
-    return Stage::kComplete;
-
-  uint32_t pos = 0;
-  auto data_span = pdfium::make_span(m_pData.Get(), m_Size);
-  for (const auto& stream : m_StreamArray) {
-    fxcrt::spancpy(data_span.subspan(pos), stream->GetSpan());
-    pos += stream->GetSize();
-    data_span[pos++] = ' ';
-  }
-  m_StreamArray.clear();
-  return Stage::kParse;
-}
-
 CPDF_ContentParser::Stage CPDF_ContentParser::Parse() {
   if (!m_pParser) {
     m_ParsedSet.clear();
@@ -194,25 +131,103 @@ CPDF_ContentParser::Stage CPDF_ContentParser::Parse() {
         &m_ParsedSet);
     m_pParser->GetCurStates()->m_ColorState.SetDefault();
   }
-  if (m_CurrentOffset >= m_Size)
-    return Stage::kCheckClip;
-
-  if (m_StreamSegmentOffsets.empty())
-    m_StreamSegmentOffsets.push_back(0);
 
   static constexpr uint32_t kParseStepLimit = 100;
-  m_CurrentOffset += m_pParser->Parse({m_pData.Get(), m_Size}, m_CurrentOffset,
-                                      kParseStepLimit, m_StreamSegmentOffsets);
+  if (m_pFormStream) {
+    if (m_CurrentOffset >= m_pFormStream->GetSize())
+      return Stage::kCheckClip;
+
+    m_CurrentOffset += m_pParser->Parse(
+        m_pFormStream->GetSpan(), m_CurrentOffset, kParseStepLimit,
+        m_CurrentStreamIndex, CPDF_StreamContentParser::DataEnd::kFinal);
+    CheckNewObjectClips();
+    return Stage::kParse;
+  }
+
+  if (m_CurrentOffset >= m_Window.size() || m_pParser->NeedsMoreData()) {
+    if (!ReadPageContent())
+      return Stage::kCheckClip;
+    if (m_CurrentOffset >= m_Window.size())
+      return Stage::kParse;
+  }
+
+  CPDF_StreamContentParser::DataEnd data_end =
+      CPDF_StreamContentParser::DataEnd::kWindowEnd;
+  if (m_bStreamEnd) {
+    data_end = m_CurrentStreamIndex + 1 < m_nStreams
+                   ? CPDF_StreamContentParser::DataEnd::kStreamEnd
+                   : CPDF_StreamContentParser::DataEnd::kFinal;
+  }
+  m_CurrentOffset += m_pParser->Parse(m_Window, m_CurrentOffset,
+                                      kParseStepLimit, m_CurrentStreamIndex,
+                                      data_end);
+  CheckNewObjectClips();
   return Stage::kParse;
 }
 
+bool CPDF_ContentParser::ReadPageContent() {
+  m_Window.erase(m_Window.begin(), m_Window.begin() + m_CurrentOffset);
+  m_CurrentOffset = 0;
+  if (m_bStreamEnd) {
+    if (m_CurrentStreamIndex + 1 >= m_nStreams)
+      return false;
+
+    // Whatever is left of the previous stream is parsed as if the streams
+    // were joined with a space in between.
+    ++m_CurrentStreamIndex;
+    m_bStreamEnd = false;
+    if (!m_Window.empty())
+      m_Window.push_back(' ');
+  }
+  if (!m_pStreamReader) {
+    m_pStreamReader = std::make_unique<CPDF_StreamReader>(
+        GetPageContentStream(m_CurrentStreamIndex));
+  }
+
+  // When the parser could not finish what is left, the window doubles, but
+  // grows by no more than |kMaxWindowGrowth| at a time.
+  const size_t read_size = pdfium::clamp<size_t>(m_Window.size(), kWindowSize,
+                                                 kMaxWindowGrowth);
+  const size_t old_size = m_Window.size();
+  m_Window.resize(old_size + read_size);
+  const size_t read = m_pStreamReader->Read(
+      pdfium::make_span(m_Window).subspan(old_size, read_size));
+  m_Window.resize(old_size + read);
+  if (read < read_size) {
+    m_bStreamEnd = true;
+    m_pStreamReader.reset();
+  }
+  return true;
+}
+
 CPDF_ContentParser::Stage CPDF_ContentParser::CheckClip() {
   if (m_pType3Char) {
     m_pType3Char->InitializeFromStreamData(m_pParser->IsColored(),
                                            m_pParser->GetType3Data());
   }
 
-  for (auto& pObj : *m_pObjectHolder) {
+  CheckNewObjectClips();
+  return Stage::kComplete;
+}
+
+RetainPtr<const CPDF_Stream> CPDF_ContentParser::GetPageContentStream(
+    uint32_t index) const {
+  DCHECK(m_pObjectHolder->IsPage());
+  CPDF_Object* pContent = m_pObjectHolder->GetDict()->GetDirectObjectFor(
+      pdfium::page_object::kContents);
+  CPDF_Stream* pStreamObj = pContent ? pContent->AsStream() : nullptr;
+  if (!pStreamObj) {
+    CPDF_Array* pArray = pContent ? pContent->AsArray() : nullptr;
+    pStreamObj = ToStream(pArray ? pArray->GetDirectObjectAt(index) : nullptr);
+  }
+  return pdfium::WrapRetain(pStreamObj);
+}
+
+void CPDF_ContentParser::CheckNewObjectClips() {
+  const size_t count = m_pObjectHolder->GetPageObjectCount();
+  for (; m_nCheckedObjects < count; ++m_nCheckedObjects) {
+    CPDF_PageObject* pObj =
+        m_pObjectHolder->GetPageObjectByIndex(m_nCheckedObjects);
     if (!pObj->m_ClipPath.HasRef())
       continue;
     if (pObj->m_ClipPath.GetPathCount() != 1)
@@ -230,22 +245,11 @@ CPDF_ContentParser::Stage CPDF_ContentParser::CheckClip() {
     if (old_rect.Contains(pObj->GetRect()))
       pObj->m_ClipPath.SetNull();
   }
-  return Stage::kComplete;
-}
-
-void CPDF_ContentParser::HandlePageContentStream(CPDF_Stream* pStream) {
-  m_pSingleStream = pdfium::MakeRetain<CPDF_StreamAcc>(pStream);
-  m_pSingleStream->LoadAllDataFiltered();
-  m_CurrentStage = Stage::kPrepareContent;
 }
 
 bool CPDF_ContentParser::HandlePageContentArray(CPDF_Array* pArray) {
   m_nStreams = pArray->size();
-  if (m_nStreams == 0)
-    return false;
-
-  m_StreamArray.resize(m_nStreams);
-  return true;
+  return m_nStreams != 0;
 }
 
 void CPDF_ContentParser::HandlePageContentFailure() {
@@ -7,15 +7,17 @@
 #ifndef CORE_FPDFAPI_PAGE_CPDF_CONTENTPARSER_H_
 #define CORE_FPDFAPI_PAGE_CPDF_CONTENTPARSER_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <set>
 #include <vector>
 
 #include "core/fpdfapi/page/cpdf_streamcontentparser.h"
 #include "core/fxcrt/fx_memory_wrappers.h"
-#include "core/fxcrt/maybe_owned.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
+#include "third_party/base/span.h"
 
 class CPDF_AllStates;
 class CPDF_Array;
@@ -24,6 +26,7 @@ class CPDF_Page;
 class CPDF_PageObjectHolder;
 class CPDF_Stream;
 class CPDF_StreamAcc;
+class CPDF_StreamReader;
 class CPDF_Type3Char;
 class PauseIndicatorIface;
 
@@ -45,32 +48,49 @@ class CPDF_ContentParser {
 
  private:
   enum class Stage : uint8_t {
-    kGetContent = 1,
-    kPrepareContent,
-    kParse,
+    kParse = 1,
     kCheckClip,
     kComplete,
   };
 
-  Stage GetContent();
-  Stage PrepareContent();
   Stage Parse();
   Stage CheckClip();
 
-  void HandlePageContentStream(CPDF_Stream* pStream);
+  // Returns content stream |index| of a page.
+  RetainPtr<const CPDF_Stream> GetPageContentStream(uint32_t index) const;
+
+  // Drops the parsed part of |m_Window| and appends the next decoded page
+  // content, moving on to the next stream at the end of one. Returns false
+  // once there is no more.
+  bool ReadPageContent();
+
+  // Drops the clip path of the objects appended since the last call if the
+  // clip cannot affect them, so that each object is final once parsed.
+  void CheckNewObjectClips();
+
   bool HandlePageContentArray(CPDF_Array* pArray);
   void HandlePageContentFailure();
 
   Stage m_CurrentStage;
   UnownedPtr<CPDF_PageObjectHolder> const m_pObjectHolder;
   UnownedPtr<CPDF_Type3Char> m_pType3Char;  // Only used when parsing forms.
-  RetainPtr<CPDF_StreamAcc> m_pSingleStream;
-  std::vector<RetainPtr<CPDF_StreamAcc>> m_StreamArray;
-  std::vector<uint32_t> m_StreamSegmentOffsets;
-  MaybeOwned<uint8_t, FxFreeDeleter> m_pData;
+  // Bytes of decoded page content read at a time.
+  static constexpr size_t kWindowSize = 64 * 1024;
+  // Most bytes read at a time when the window has to grow.
+  static constexpr size_t kMaxWindowGrowth = 1024 * 1024;
+
+  // Forms are parsed from a whole buffer.
+  RetainPtr<CPDF_StreamAcc> m_pFormStream;
+  // Page content streams are decoded and parsed a window at a time, one
+  // stream after the other, through |m_pStreamReader|.
+  std::unique_ptr<CPDF_StreamReader> m_pStreamReader;
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> m_Window;
+  // Whether |m_Window| reaches the end of the current stream.
+  bool m_bStreamEnd = false;
   uint32_t m_nStreams = 0;
-  uint32_t m_Size = 0;
+  uint32_t m_CurrentStreamIndex = 0;
   uint32_t m_CurrentOffset = 0;
+  size_t m_nCheckedObjects = 0;
   std::set<const uint8_t*> m_ParsedSet;  // Only used when parsing pages.
 
   // Must not outlive |m_pParsedSet|.
@@ -0,0 +1,109 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_contentparser.h"
+
+#include <memory>
+
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/page/cpdf_image.h"
+#include "core/fpdfapi/page/cpdf_imageobject.h"
+#include "core/fpdfapi/page/cpdf_page.h"
+#include "core/fpdfapi/page/cpdf_pagemodule.h"
+#include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_reference.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
+#include "core/fxcrt/fx_string.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Offset at which the parser reads the second window of a content stream.
+constexpr size_t kWindowEnd = 64 * 1024;
+
+}  // namespace
+
+class CPDF_ContentParserTest : public testing::Test {
+ public:
+  void SetUp() override {
+    CPDF_PageModule::Create();
+    m_pDoc = std::make_unique<CPDF_Document>(
+        std::make_unique<CPDF_DocRenderData>(),
+        std::make_unique<CPDF_DocPageData>());
+    m_pDoc->CreateNewDoc();
+  }
+
+  void TearDown() override {
+    m_pDoc.reset();
+    CPDF_PageModule::Destroy();
+  }
+
+  // Parses a page with |content|, padded at the front so that |content|
+  // starts |offset| bytes before the end of the first window.
+  RetainPtr<CPDF_Page> ParsePage(const ByteString& content, size_t offset) {
+    ByteString data;
+    while (data.GetLength() + offset + 4 <= kWindowEnd)
+      data += "q Q ";
+    while (data.GetLength() + offset < kWindowEnd)
+      data += " ";
+    data += content;
+
+    auto* pStream = m_pDoc->NewIndirect<CPDF_Stream>();
+    pStream->SetData(data.raw_span());
+    CPDF_Dictionary* pPageDict = m_pDoc->CreateNewPage(0);
+    pPageDict->SetNewFor<CPDF_Reference>("Contents", m_pDoc.get(),
+                                         pStream->GetObjNum());
+    auto pPage = pdfium::MakeRetain<CPDF_Page>(m_pDoc.get(), pPageDict);
+    pPage->ParseContent();
+    return pPage;
+  }
+
+ private:
+  std::unique_ptr<CPDF_Document> m_pDoc;
+};
+
+TEST_F(CPDF_ContentParserTest, InlineImageAcrossWindowEnd) {
+  ByteString pixels;
+  for (int i = 0; i < 256; ++i)
+    pixels += static_cast<char>('a' + i % 26);
+  ByteString content = "BI /W 16 /H 16 /BPC 8 /CS /G ID " + pixels +
+                       " EI 0 0 1 1 re f";
+
+  // The window ends before, inside and right after the image data.
+  for (size_t offset : {8, 64, 300}) {
+    RetainPtr<CPDF_Page> pPage = ParsePage(content, offset);
+    ASSERT_EQ(2u, pPage->GetPageObjectCount());
+    CPDF_ImageObject* pImageObj =
+        pPage->GetPageObjectByIndex(0)->AsImage();
+    ASSERT_TRUE(pImageObj);
+    RetainPtr<CPDF_Image> pImage = pImageObj->GetImage();
+    EXPECT_EQ(16, pImage->GetPixelWidth());
+    EXPECT_EQ(16, pImage->GetPixelHeight());
+    const CPDF_Stream* pStream = pImage->GetStream();
+    ASSERT_EQ(pixels.GetLength(), pStream->GetRawSize());
+    EXPECT_EQ(pixels, ByteString(pStream->GetInMemoryRawData(),
+                                 pStream->GetRawSize()));
+    EXPECT_TRUE(pPage->GetPageObjectByIndex(1)->IsPath());
+  }
+}
+
+TEST_F(CPDF_ContentParserTest, FilteredInlineImageAcrossWindowEnd) {
+  ByteString content =
+      "BI /W 4 /H 2 /BPC 8 /CS /G /F /AHx ID 0011223344556677> EI 0 0 1 1 re f";
+
+  for (size_t offset : {8, 45, 60}) {
+    RetainPtr<CPDF_Page> pPage = ParsePage(content, offset);
+    ASSERT_EQ(2u, pPage->GetPageObjectCount());
+    CPDF_ImageObject* pImageObj =
+        pPage->GetPageObjectByIndex(0)->AsImage();
+    ASSERT_TRUE(pImageObj);
+    const CPDF_Stream* pStream = pImageObj->GetImage()->GetStream();
+    EXPECT_EQ("0011223344556677>", ByteString(pStream->GetInMemoryRawData(),
+                                              pStream->GetRawSize()));
+    EXPECT_TRUE(pPage->GetPageObjectByIndex(1)->IsPath());
+  }
+}
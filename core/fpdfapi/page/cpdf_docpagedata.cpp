@@ -9,17 +9,20 @@
 #include <algorithm>
 #include <memory>
 #include <set>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "build/build_config.h"
 #include "core/fpdfapi/font/cpdf_type1font.h"
 #include "core/fpdfapi/page/cpdf_form.h"
+#include "core/fpdfapi/page/cpdf_graphicstates.h"
 #include "core/fpdfapi/page/cpdf_iccprofile.h"
 #include "core/fpdfapi/page/cpdf_image.h"
 #include "core/fpdfapi/page/cpdf_pagemodule.h"
 #include "core/fpdfapi/page/cpdf_pattern.h"
 #include "core/fpdfapi/page/cpdf_shadingpattern.h"
+#include "core/fpdfapi/page/cpdf_sharedform.h"
 #include "core/fpdfapi/page/cpdf_tilingpattern.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
@@ -157,8 +160,22 @@ RetainPtr<CPDF_Dictionary> CalculateFontDesc(CPDF_Document* pDoc,
   return pFontDesc;
 }
 
+void RemoveDeadForms(std::vector<ObservedPtr<CPDF_SharedForm>>* forms) {
+  forms->erase(std::remove_if(forms->begin(), forms->end(),
+                              [](const ObservedPtr<CPDF_SharedForm>& pForm) {
+                                return !pForm;
+                              }),
+               forms->end());
+}
+
 }  // namespace
 
+bool CPDF_DocPageData::FormKey::operator<(const FormKey& other) const {
+  return std::tie(pStream, pPageResources, pResources, bTextOnly) <
+         std::tie(other.pStream, other.pPageResources, other.pResources,
+                  other.bTextOnly);
+}
+
 // static
 CPDF_DocPageData* CPDF_DocPageData::FromDocument(const CPDF_Document* pDoc) {
   return static_cast<CPDF_DocPageData*>(pDoc->GetPageData());
@@ -414,6 +431,46 @@ RetainPtr<CPDF_IccProfile> CPDF_DocPageData::GetIccProfile(
   return pProfile;
 }
 
+RetainPtr<CPDF_SharedForm> CPDF_DocPageData::GetSharedForm(
+    const FormKey& key,
+    const CPDF_GraphicStates& states) {
+  auto it = m_SharedFormMap.find(key);
+  if (it == m_SharedFormMap.end())
+    return nullptr;
+
+  std::vector<ObservedPtr<CPDF_SharedForm>>& forms = it->second;
+  RemoveDeadForms(&forms);
+  for (const auto& pForm : forms) {
+    if (pForm->WasParsedWith(states))
+      return pdfium::WrapRetain(pForm.Get());
+  }
+  return nullptr;
+}
+
+void CPDF_DocPageData::AddSharedForm(const FormKey& key,
+                                     const RetainPtr<CPDF_SharedForm>& pForm) {
+  auto it = m_SharedFormMap.find(key);
+  if (it != m_SharedFormMap.end()) {
+    it->second.emplace_back(pForm.Get());
+    return;
+  }
+
+  // Keys of forms that are no longer used are only dropped here, so sweep
+  // every time the map has doubled in size.
+  if (m_SharedFormMap.size() >= m_SharedFormSweepSize) {
+    for (auto sweep = m_SharedFormMap.begin();
+         sweep != m_SharedFormMap.end();) {
+      RemoveDeadForms(&sweep->second);
+      if (sweep->second.empty())
+        sweep = m_SharedFormMap.erase(sweep);
+      else
+        ++sweep;
+    }
+    m_SharedFormSweepSize = std::max<size_t>(64, m_SharedFormMap.size() * 2);
+  }
+  m_SharedFormMap[key].emplace_back(pForm.Get());
+}
+
 RetainPtr<CPDF_StreamAcc> CPDF_DocPageData::GetFontFileStreamAcc(
     const CPDF_Stream* pFontStream) {
   DCHECK(pFontStream);
@@ -436,17 +493,25 @@ RetainPtr<CPDF_StreamAcc> CPDF_DocPageData::GetFontFileStreamAcc(
   auto pFontAcc = pdfium::MakeRetain<CPDF_StreamAcc>(pFontStream);
   pFontAcc->LoadAllDataFilteredWithEstimatedSize(org_size);
   m_FontFileMap[pFontStream] = pFontAcc;
+  m_FontFileDigestMap[pFontStream] = pFontAcc->ComputeDigest();
   return pFontAcc;
 }
 
+ByteString CPDF_DocPageData::GetFontFileDigest(const CPDF_Stream* pFontStream) {
+  auto it = m_FontFileDigestMap.find(pFontStream);
+  return it != m_FontFileDigestMap.end() ? it->second : ByteString();
+}
+
 void CPDF_DocPageData::MaybePurgeFontFileStreamAcc(
     const CPDF_Stream* pFontStream) {
   if (!pFontStream)
     return;
 
   auto it = m_FontFileMap.find(pFontStream);
-  if (it != m_FontFileMap.end() && it->second->HasOneRef())
+  if (it != m_FontFileMap.end() && it->second->HasOneRef()) {
     m_FontFileMap.erase(it);
+    m_FontFileDigestMap.erase(pFontStream);
+  }
 }
 
 std::unique_ptr<CPDF_Font::FormIface> CPDF_DocPageData::CreateForm(
@@ -10,6 +10,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "core/fpdfapi/font/cpdf_font.h"
 #include "core/fpdfapi/page/cpdf_colorspace.h"
@@ -22,16 +23,29 @@
 class CFX_Font;
 class CPDF_Dictionary;
 class CPDF_FontEncoding;
+class CPDF_GraphicStates;
 class CPDF_IccProfile;
 class CPDF_Image;
 class CPDF_Object;
 class CPDF_Pattern;
+class CPDF_SharedForm;
 class CPDF_Stream;
 class CPDF_StreamAcc;
 
 class CPDF_DocPageData : public CPDF_Document::PageDataIface,
                          public CPDF_Font::FormFactoryIface {
  public:
+  // Everything other than the inherited states that affects how a form
+  // XObject drawn by a content stream is parsed.
+  struct FormKey {
+    bool operator<(const FormKey& other) const;
+
+    const CPDF_Stream* pStream;
+    const CPDF_Dictionary* pPageResources;
+    const CPDF_Dictionary* pResources;
+    bool bTextOnly;
+  };
+
   static CPDF_DocPageData* FromDocument(const CPDF_Document* pDoc);
 
   CPDF_DocPageData();
@@ -41,6 +55,7 @@ class CPDF_DocPageData : public CPDF_Document::PageDataIface,
   void ClearStockFont() override;
   RetainPtr<CPDF_StreamAcc> GetFontFileStreamAcc(
       const CPDF_Stream* pFontStream) override;
+  ByteString GetFontFileDigest(const CPDF_Stream* pFontStream) override;
   void MaybePurgeFontFileStreamAcc(const CPDF_Stream* pFontStream) override;
 
   // CPDF_Font::FormFactoryIFace:
@@ -83,6 +98,13 @@ class CPDF_DocPageData : public CPDF_Document::PageDataIface,
 
   RetainPtr<CPDF_IccProfile> GetIccProfile(const CPDF_Stream* pProfileStream);
 
+  // Returns a form parsed for |key| with the same inherited |states|, if one
+  // is still in use.
+  RetainPtr<CPDF_SharedForm> GetSharedForm(const FormKey& key,
+                                           const CPDF_GraphicStates& states);
+  void AddSharedForm(const FormKey& key,
+                     const RetainPtr<CPDF_SharedForm>& pForm);
+
  private:
   // Loads a colorspace in a context that might be while loading another
   // colorspace, or even in a recursive call from this method itself. |pVisited|
@@ -108,10 +130,13 @@ class CPDF_DocPageData : public CPDF_Document::PageDataIface,
   std::map<ByteString, RetainPtr<const CPDF_Stream>> m_HashProfileMap;
   std::map<const CPDF_Object*, ObservedPtr<CPDF_ColorSpace>> m_ColorSpaceMap;
   std::map<const CPDF_Stream*, RetainPtr<CPDF_StreamAcc>> m_FontFileMap;
+  std::map<const CPDF_Stream*, ByteString> m_FontFileDigestMap;
   std::map<const CPDF_Stream*, ObservedPtr<CPDF_IccProfile>> m_IccProfileMap;
   std::map<const CPDF_Object*, ObservedPtr<CPDF_Pattern>> m_PatternMap;
   std::map<uint32_t, RetainPtr<CPDF_Image>> m_ImageMap;
   std::map<const CPDF_Dictionary*, ObservedPtr<CPDF_Font>> m_FontMap;
+  size_t m_SharedFormSweepSize = 64;
+  std::map<FormKey, std::vector<ObservedPtr<CPDF_SharedForm>>> m_SharedFormMap;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_DOCPAGEDATA_H_
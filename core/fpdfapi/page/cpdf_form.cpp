@@ -106,6 +106,13 @@ const CPDF_Stream* CPDF_Form::GetStream() const {
   return m_pFormStream.Get();
 }
 
+std::unique_ptr<CPDF_Form> CPDF_Form::CloneUnparsed() const {
+  auto pForm = std::make_unique<CPDF_Form>(GetDocument(), GetPageResources(),
+                                           m_pFormStream.Get(), GetResources());
+  pForm->SetTextOnly(IsTextOnly());
+  return pForm;
+}
+
 Optional<std::pair<RetainPtr<CFX_DIBitmap>, CFX_Matrix>>
 CPDF_Form::GetBitmapAndMatrixFromSoleImageOfForm() const {
   if (GetPageObjectCount() != 1)
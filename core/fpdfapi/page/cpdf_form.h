@@ -7,6 +7,7 @@
 #ifndef CORE_FPDFAPI_PAGE_CPDF_FORM_H_
 #define CORE_FPDFAPI_PAGE_CPDF_FORM_H_
 
+#include <memory>
 #include <set>
 #include <utility>
 
@@ -52,6 +53,9 @@ class CPDF_Form final : public CPDF_PageObjectHolder,
 
   const CPDF_Stream* GetStream() const;
 
+  // Returns a new, unparsed form for the same stream and resources.
+  std::unique_ptr<CPDF_Form> CloneUnparsed() const;
+
  private:
   void ParseContentInternal(const CPDF_AllStates* pGraphicStates,
                             const CFX_Matrix* pParentMatrix,
@@ -13,8 +13,15 @@
 CPDF_FormObject::CPDF_FormObject(int32_t content_stream,
                                  std::unique_ptr<CPDF_Form> pForm,
                                  const CFX_Matrix& matrix)
+    : CPDF_FormObject(content_stream,
+                      pdfium::MakeRetain<CPDF_SharedForm>(std::move(pForm)),
+                      matrix) {}
+
+CPDF_FormObject::CPDF_FormObject(int32_t content_stream,
+                                 RetainPtr<CPDF_SharedForm> pSharedForm,
+                                 const CFX_Matrix& matrix)
     : CPDF_PageObject(content_stream),
-      m_pForm(std::move(pForm)),
+      m_pSharedForm(std::move(pSharedForm)),
       m_FormMatrix(matrix) {}
 
 CPDF_FormObject::~CPDF_FormObject() = default;
@@ -42,7 +49,17 @@ CPDF_PageObject::Type CPDF_FormObject::GetType() const {
 }
 
 void CPDF_FormObject::CalcBoundingBox() {
-  SetRect(m_FormMatrix.TransformRect(m_pForm->CalcBoundingBox()));
+  SetRect(m_FormMatrix.TransformRect(form()->CalcBoundingBox()));
+}
+
+CPDF_Form* CPDF_FormObject::GetMutableForm() {
+  if (m_pSharedForm->IsShared()) {
+    if (m_pSharedForm->HasOneRef())
+      m_pSharedForm->StopSharing();
+    else
+      m_pSharedForm = m_pSharedForm->CloneUnshared();
+  }
+  return m_pSharedForm->form();
 }
 
 void CPDF_FormObject::SetFormMatrix(const CFX_Matrix& matrix) {
@@ -10,7 +10,9 @@
 #include <memory>
 
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_sharedform.h"
 #include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
 
 class CPDF_Form;
 
@@ -19,6 +21,9 @@ class CPDF_FormObject final : public CPDF_PageObject {
   CPDF_FormObject(int32_t content_stream,
                   std::unique_ptr<CPDF_Form> pForm,
                   const CFX_Matrix& matrix);
+  CPDF_FormObject(int32_t content_stream,
+                  RetainPtr<CPDF_SharedForm> pSharedForm,
+                  const CFX_Matrix& matrix);
   ~CPDF_FormObject() override;
 
   // CPDF_PageObject:
@@ -29,12 +34,16 @@ class CPDF_FormObject final : public CPDF_PageObject {
   const CPDF_FormObject* AsForm() const override;
 
   void CalcBoundingBox();
-  const CPDF_Form* form() const { return m_pForm.get(); }
+  const CPDF_Form* form() const { return m_pSharedForm->form(); }
+  // Returns the form with page objects that can be modified without
+  // affecting other form objects. Gives this object its own copy first if
+  // the parsed content is shared.
+  CPDF_Form* GetMutableForm();
   const CFX_Matrix& form_matrix() const { return m_FormMatrix; }
   void SetFormMatrix(const CFX_Matrix& matrix);
 
  private:
-  std::unique_ptr<CPDF_Form> const m_pForm;
+  RetainPtr<CPDF_SharedForm> m_pSharedForm;
   CFX_Matrix m_FormMatrix;
 };
 
@@ -25,6 +25,12 @@ class CPDF_GeneralState {
 
   void Emplace() { m_Ref.Emplace(); }
   bool HasRef() const { return !!m_Ref; }
+  bool operator==(const CPDF_GeneralState& that) const {
+    return m_Ref == that.m_Ref;
+  }
+  bool operator!=(const CPDF_GeneralState& that) const {
+    return !(*this == that);
+  }
 
   void SetRenderIntent(const ByteString& ri);
 
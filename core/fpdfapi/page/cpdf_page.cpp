@@ -39,6 +39,38 @@ CPDF_Page::CPDF_Page(CPDF_Document* pDocument, CPDF_Dictionary* pPageDict)
 
 CPDF_Page::~CPDF_Page() = default;
 
+// static
+CFX_FloatRect CPDF_Page::GetBoxFromAttr(const CPDF_Object* pBox) {
+  CFX_FloatRect box;
+  const CPDF_Array* pArray = ToArray(pBox);
+  if (pArray) {
+    box = pArray->GetRect();
+    box.Normalize();
+  }
+  return box;
+}
+
+// static
+int CPDF_Page::GetRotationFromAttr(const CPDF_Object* pRotate) {
+  int rotate = pRotate ? (pRotate->GetInteger() / 90) % 4 : 0;
+  return (rotate < 0) ? (rotate + 4) : rotate;
+}
+
+// static
+CFX_FloatRect CPDF_Page::CalculateBBox(const CFX_FloatRect& mediabox,
+                                       const CFX_FloatRect& cropbox) {
+  CFX_FloatRect media = mediabox;
+  if (media.IsEmpty())
+    media = CFX_FloatRect(0, 0, 612, 792);
+
+  if (cropbox.IsEmpty())
+    return media;
+
+  CFX_FloatRect bbox = cropbox;
+  bbox.Intersect(media);
+  return bbox;
+}
+
 CPDF_Page* CPDF_Page::AsPDFPage() {
   return this;
 }
@@ -63,13 +95,16 @@ bool CPDF_Page::IsPage() const {
   return true;
 }
 
+void CPDF_Page::StartParseContent() {
+  if (GetParseState() == ParseState::kNotParsed)
+    StartParse(std::make_unique<CPDF_ContentParser>(this));
+}
+
 void CPDF_Page::ParseContent() {
   if (GetParseState() == ParseState::kParsed)
     return;
 
-  if (GetParseState() == ParseState::kNotParsed)
-    StartParse(std::make_unique<CPDF_ContentParser>(this));
-
+  StartParseContent();
   DCHECK_EQ(GetParseState(), ParseState::kParsing);
   ContinueParse(nullptr);
 }
@@ -90,13 +125,7 @@ CPDF_Object* CPDF_Page::GetPageAttr(const ByteString& name) const {
 }
 
 CFX_FloatRect CPDF_Page::GetBox(const ByteString& name) const {
-  CFX_FloatRect box;
-  CPDF_Array* pBox = ToArray(GetPageAttr(name));
-  if (pBox) {
-    box = pBox->GetRect();
-    box.Normalize();
-  }
-  return box;
+  return GetBoxFromAttr(GetPageAttr(name));
 }
 
 Optional<CFX_PointF> CPDF_Page::DeviceToPage(
@@ -173,21 +202,12 @@ CFX_Matrix CPDF_Page::GetDisplayMatrix(const FX_RECT& rect, int iRotate) const {
 }
 
 int CPDF_Page::GetPageRotation() const {
-  CPDF_Object* pRotate = GetPageAttr(pdfium::page_object::kRotate);
-  int rotate = pRotate ? (pRotate->GetInteger() / 90) % 4 : 0;
-  return (rotate < 0) ? (rotate + 4) : rotate;
+  return GetRotationFromAttr(GetPageAttr(pdfium::page_object::kRotate));
 }
 
 void CPDF_Page::UpdateDimensions() {
-  CFX_FloatRect mediabox = GetBox(pdfium::page_object::kMediaBox);
-  if (mediabox.IsEmpty())
-    mediabox = CFX_FloatRect(0, 0, 612, 792);
-
-  m_BBox = GetBox(pdfium::page_object::kCropBox);
-  if (m_BBox.IsEmpty())
-    m_BBox = mediabox;
-  else
-    m_BBox.Intersect(mediabox);
+  m_BBox = CalculateBBox(GetBox(pdfium::page_object::kMediaBox),
+                         GetBox(pdfium::page_object::kCropBox));
 
   m_PageSize.width = m_BBox.Width();
   m_PageSize.height = m_BBox.Height();
@@ -53,6 +53,15 @@ class CPDF_Page final : public IPDF_Page, public CPDF_PageObjectHolder {
 
   CONSTRUCT_VIA_MAKE_RETAIN;
 
+  // Geometry from the values of page attributes, for callers that only have
+  // a page dictionary. Missing or invalid values are treated as absent.
+  static CFX_FloatRect GetBoxFromAttr(const CPDF_Object* pBox);
+  static int GetRotationFromAttr(const CPDF_Object* pRotate);
+  // Returns the crop box clipped to the media box, with the defaults used
+  // for empty boxes applied.
+  static CFX_FloatRect CalculateBBox(const CFX_FloatRect& mediabox,
+                                     const CFX_FloatRect& cropbox);
+
   // IPDF_Page:
   CPDF_Page* AsPDFPage() override;
   CPDFXFA_Page* AsXFAPage() override;
@@ -72,6 +81,9 @@ class CPDF_Page final : public IPDF_Page, public CPDF_PageObjectHolder {
   // CPDF_PageObjectHolder:
   bool IsPage() const override;
 
+  // Sets up parsing without doing any of it, leaving the work to
+  // ContinueParse(), e.g. as done by the progressive renderer.
+  void StartParseContent();
   void ParseContent();
   const CFX_SizeF& GetPageSize() const { return m_PageSize; }
   int GetPageRotation() const;
@@ -6,6 +6,8 @@
 
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 
+#include "core/fpdfapi/page/cpdf_pageobjectholder.h"
+
 CPDF_PageObject::CPDF_PageObject(int32_t content_stream)
     : m_ContentStream(content_stream) {}
 
@@ -91,6 +93,26 @@ void CPDF_PageObject::TransformGeneralState(const CFX_Matrix& matrix) {
   SetDirty(true);
 }
 
+void CPDF_PageObject::SetDirty(bool value) {
+  m_bDirty = value;
+  if (value && m_pHolder)
+    m_pHolder->AddDamagedRect(m_Rect);
+}
+
+void CPDF_PageObject::SetRect(const CFX_FloatRect& rect) {
+  // Bounding boxes get recomputed after most edits, usually to the same
+  // value, which does not need to drop the holder's object index.
+  if (rect == m_Rect)
+    return;
+
+  if (m_pHolder) {
+    m_pHolder->InvalidateObjectIndex();
+    m_pHolder->AddDamagedRect(m_Rect);
+    m_pHolder->AddDamagedRect(rect);
+  }
+  m_Rect = rect;
+}
+
 FX_RECT CPDF_PageObject::GetBBox() const {
   return GetRect().GetOuterRect();
 }
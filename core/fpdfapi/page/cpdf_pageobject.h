@@ -11,9 +11,11 @@
 #include "core/fpdfapi/page/cpdf_graphicstates.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/fx_system.h"
+#include "core/fxcrt/unowned_ptr.h"
 
 class CPDF_FormObject;
 class CPDF_ImageObject;
+class CPDF_PageObjectHolder;
 class CPDF_PathObject;
 class CPDF_ShadingObject;
 class CPDF_TextObject;
@@ -53,12 +55,12 @@ class CPDF_PageObject : public CPDF_GraphicStates {
   virtual CPDF_FormObject* AsForm();
   virtual const CPDF_FormObject* AsForm() const;
 
-  void SetDirty(bool value) { m_bDirty = value; }
+  void SetDirty(bool value);
   bool IsDirty() const { return m_bDirty; }
   void TransformClipPath(const CFX_Matrix& matrix);
   void TransformGeneralState(const CFX_Matrix& matrix);
 
-  void SetRect(const CFX_FloatRect& rect) { m_Rect = rect; }
+  void SetRect(const CFX_FloatRect& rect);
   const CFX_FloatRect& GetRect() const { return m_Rect; }
   FX_RECT GetBBox() const;
   FX_RECT GetTransformedBBox(const CFX_Matrix& matrix) const;
@@ -81,6 +83,10 @@ class CPDF_PageObject : public CPDF_GraphicStates {
     m_ContentStream = new_content_stream;
   }
 
+  // Set by the holder that owns this object, if any, so that it can be told
+  // when the object changes.
+  void SetHolder(CPDF_PageObjectHolder* pHolder) { m_pHolder = pHolder; }
+
 
  protected:
   void CopyData(const CPDF_PageObject* pSrcObject);
@@ -89,6 +95,7 @@ class CPDF_PageObject : public CPDF_GraphicStates {
 
  private:
   CPDF_ContentMarks m_ContentMarks;
+  UnownedPtr<CPDF_PageObjectHolder> m_pHolder;
   bool m_bDirty = false;
   int32_t m_ContentStream;
 };
@@ -7,12 +7,14 @@
 #include "core/fpdfapi/page/cpdf_pageobjectholder.h"
 
 #include <algorithm>
+#include <cmath>
 #include <utility>
 
 #include "constants/transparency.h"
 #include "core/fpdfapi/page/cpdf_allstates.h"
 #include "core/fpdfapi/page/cpdf_contentparser.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxcrt/fx_extension.h"
@@ -134,7 +136,10 @@ CPDF_PageObject* CPDF_PageObjectHolder::GetPageObjectByIndex(
 
 void CPDF_PageObjectHolder::AppendPageObject(
     std::unique_ptr<CPDF_PageObject> pPageObj) {
+  pPageObj->SetHolder(this);
+  AddDamagedRect(pPageObj->GetRect());
   m_PageObjectList.push_back(std::move(pPageObj));
+  InvalidateObjectIndex();
 }
 
 bool CPDF_PageObjectHolder::RemovePageObject(CPDF_PageObject* pPageObj) {
@@ -147,6 +152,9 @@ bool CPDF_PageObjectHolder::RemovePageObject(CPDF_PageObject* pPageObj) {
 
   it->release();
   m_PageObjectList.erase(it);
+  pPageObj->SetHolder(nullptr);
+  AddDamagedRect(pPageObj->GetRect());
+  InvalidateObjectIndex();
 
   int32_t content_stream = pPageObj->GetContentStream();
   if (content_stream >= 0)
@@ -159,6 +167,74 @@ bool CPDF_PageObjectHolder::ErasePageObjectAtIndex(size_t index) {
   if (index >= m_PageObjectList.size())
     return false;
 
-  m_PageObjectList.erase(m_PageObjectList.begin() + index);
+  auto it = m_PageObjectList.begin() + index;
+  if (*it)
+    AddDamagedRect((*it)->GetRect());
+  m_PageObjectList.erase(it);
+  InvalidateObjectIndex();
   return true;
 }
+
+const CPDF_PageObjectIndex* CPDF_PageObjectHolder::GetObjectIndex() const {
+  if (m_ParseState == ParseState::kParsing ||
+      m_PageObjectList.size() < CPDF_PageObjectIndex::kMinObjectCount) {
+    return nullptr;
+  }
+  if (!m_pObjectIndex)
+    m_pObjectIndex = std::make_unique<CPDF_PageObjectIndex>(this);
+  return m_pObjectIndex.get();
+}
+
+void CPDF_PageObjectHolder::InvalidateObjectIndex() {
+  m_pObjectIndex.reset();
+}
+
+void CPDF_PageObjectHolder::AddDamagedRect(const CFX_FloatRect& rect) {
+  if (m_ParseState != ParseState::kParsed || !std::isfinite(rect.left) ||
+      !std::isfinite(rect.right) || !std::isfinite(rect.bottom) ||
+      !std::isfinite(rect.top)) {
+    return;
+  }
+
+  // Objects created through the public API only get a rect once they are
+  // added to a page; until then it is all zeros.
+  if (rect == CFX_FloatRect())
+    return;
+
+  CFX_FloatRect damaged = rect;
+  damaged.Normalize();
+
+  // Absorb every rect the new one touches. The union can reach rects that
+  // the new rect did not, so repeat until nothing changes.
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (auto it = m_DamagedRects.begin(); it != m_DamagedRects.end(); ++it) {
+      if (it->left <= damaged.right && it->right >= damaged.left &&
+          it->bottom <= damaged.top && it->top >= damaged.bottom) {
+        damaged.Union(*it);
+        m_DamagedRects.erase(it);
+        merged = true;
+        break;
+      }
+    }
+  }
+  if (m_DamagedRects.size() < kMaxDamagedRects) {
+    m_DamagedRects.push_back(damaged);
+    return;
+  }
+
+  // Otherwise grow the rect that needs the least extra area to cover it.
+  auto best = m_DamagedRects.end();
+  float best_growth = 0;
+  for (auto it = m_DamagedRects.begin(); it != m_DamagedRects.end(); ++it) {
+    CFX_FloatRect grown = *it;
+    grown.Union(damaged);
+    float growth = grown.Width() * grown.Height() - it->Width() * it->Height();
+    if (best == m_DamagedRects.end() || growth < best_growth) {
+      best = it;
+      best_growth = growth;
+    }
+  }
+  best->Union(damaged);
+}
@@ -26,6 +26,7 @@
 class CPDF_ContentParser;
 class CPDF_Document;
 class CPDF_PageObject;
+class CPDF_PageObjectIndex;
 class PauseIndicatorIface;
 
 // These structs are used to keep track of resources that have already been
@@ -49,6 +50,8 @@ class CPDF_PageObjectHolder {
  public:
   enum class ParseState : uint8_t { kNotParsed, kParsing, kParsed };
 
+  static constexpr size_t kMaxDamagedRects = 16;
+
   using iterator = std::deque<std::unique_ptr<CPDF_PageObject>>::iterator;
   using const_iterator =
       std::deque<std::unique_ptr<CPDF_PageObject>>::const_iterator;
@@ -65,6 +68,18 @@ class CPDF_PageObjectHolder {
   void ContinueParse(PauseIndicatorIface* pPause);
   ParseState GetParseState() const { return m_ParseState; }
 
+  // When set before parsing, only the objects needed to extract text are
+  // created. Paths, clip paths, images and shadings are skipped, so the
+  // result is not suitable for rendering.
+  void SetTextOnly(bool text_only) { m_bTextOnly = text_only; }
+  bool IsTextOnly() const { return m_bTextOnly; }
+
+  // Cleared when the parsed objects depend on more than the states the
+  // parser started with, e.g. when a nested form was skipped to break a
+  // cycle. Such content must not be shared with other callers.
+  void SetNotShareable() { m_bShareable = false; }
+  bool IsShareable() const { return m_bShareable; }
+
   CPDF_Document* GetDocument() const { return m_pDocument.Get(); }
   CPDF_Dictionary* GetDict() const { return m_pDict.Get(); }
   CPDF_Dictionary* GetResources() const { return m_pResources.Get(); }
@@ -76,6 +91,23 @@ class CPDF_PageObjectHolder {
   bool RemovePageObject(CPDF_PageObject* pPageObj);
   bool ErasePageObjectAtIndex(size_t index);
 
+  // Returns the spatial index of the objects, building it on first use.
+  // Returns nullptr while parsing, or when there are too few objects for an
+  // index to pay off.
+  const CPDF_PageObjectIndex* GetObjectIndex() const;
+
+  // Called when the objects, or their rects, change.
+  void InvalidateObjectIndex();
+
+  // Records that |rect|, in the coordinates of the objects, has to be
+  // repainted. Ignored until parsing is complete. Overlapping rects are
+  // merged, and at most |kMaxDamagedRects| are kept.
+  void AddDamagedRect(const CFX_FloatRect& rect);
+  const std::vector<CFX_FloatRect>& GetDamagedRects() const {
+    return m_DamagedRects;
+  }
+  void ClearDamagedRects() { m_DamagedRects.clear(); }
+
   iterator begin() { return m_PageObjectList.begin(); }
   const_iterator begin() const { return m_PageObjectList.begin(); }
 
@@ -117,16 +149,22 @@ class CPDF_PageObjectHolder {
 
  private:
   bool m_bBackgroundAlphaNeeded = false;
+  bool m_bTextOnly = false;
+  bool m_bShareable = true;
   ParseState m_ParseState = ParseState::kNotParsed;
   RetainPtr<CPDF_Dictionary> const m_pDict;
   UnownedPtr<CPDF_Document> m_pDocument;
   std::vector<CFX_FloatRect> m_MaskBoundingBoxes;
   std::unique_ptr<CPDF_ContentParser> m_pParser;
   std::deque<std::unique_ptr<CPDF_PageObject>> m_PageObjectList;
+  mutable std::unique_ptr<CPDF_PageObjectIndex> m_pObjectIndex;
   CFX_Matrix m_LastCTM;
 
   // The indexes of Content streams that are dirty and need to be regenerated.
   std::set<int32_t> m_DirtyStreams;
+
+  // Areas changed by edits since the last ClearDamagedRects() call.
+  std::vector<CFX_FloatRect> m_DamagedRects;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTHOLDER_H_
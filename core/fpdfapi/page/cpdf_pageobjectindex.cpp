@@ -0,0 +1,164 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pageobjectholder.h"
+
+namespace {
+
+// Aim for a handful of objects per cell.
+constexpr size_t kObjectsPerCell = 4;
+constexpr int kMaxGridSize = 256;
+
+// Objects covering more cells than this are returned for every query rather
+// than being added to each cell.
+constexpr int kMaxCellsPerObject = 64;
+
+bool IsUsableRect(const CFX_FloatRect& rect) {
+  return std::isfinite(rect.left) && std::isfinite(rect.right) &&
+         std::isfinite(rect.bottom) && std::isfinite(rect.top) &&
+         rect.left <= rect.right && rect.bottom <= rect.top;
+}
+
+int GetGridSize(double cells) {
+  return static_cast<int>(
+      std::lround(std::min(std::max(cells, 1.0), double{kMaxGridSize})));
+}
+
+// Monotonic in |value|, so that any rect intersecting a query rect shares at
+// least one cell with it.
+int GetCell(float value, float origin, float cell_size, int count) {
+  float pos = (value - origin) / cell_size;
+  if (!(pos > 0))
+    return 0;
+  if (pos >= count)
+    return count - 1;
+  return static_cast<int>(pos);
+}
+
+// Inclusive column and row ranges. Empty when |first_col| > |last_col|.
+struct CellRange {
+  int first_col = 0;
+  int last_col = -1;
+  int first_row = 0;
+  int last_row = -1;
+};
+
+}  // namespace
+
+CPDF_PageObjectIndex::CPDF_PageObjectIndex(
+    const CPDF_PageObjectHolder* pHolder)
+    : m_ObjectCount(pHolder->GetPageObjectCount()) {
+  bool has_bounds = false;
+  for (const auto& pObj : *pHolder) {
+    if (!pObj || !IsUsableRect(pObj->GetRect()))
+      continue;
+    if (has_bounds) {
+      m_Bounds.Union(pObj->GetRect());
+    } else {
+      m_Bounds = pObj->GetRect();
+      has_bounds = true;
+    }
+  }
+
+  double target_cells = std::max<size_t>(m_ObjectCount / kObjectsPerCell, 1);
+  float width = m_Bounds.Width();
+  float height = m_Bounds.Height();
+  if (width > 0 && height > 0) {
+    m_Columns = GetGridSize(std::sqrt(target_cells * width / height));
+    m_Rows = GetGridSize(target_cells / m_Columns);
+  } else if (width > 0) {
+    m_Columns = GetGridSize(target_cells);
+  } else if (height > 0) {
+    m_Rows = GetGridSize(target_cells);
+  }
+  m_CellWidth = width > 0 ? width / m_Columns : 1;
+  m_CellHeight = height > 0 ? height / m_Rows : 1;
+
+  // Objects that are skipped or kept in |m_LargeObjects| get an empty range.
+  std::vector<CellRange> ranges(m_ObjectCount);
+  m_CellStarts.assign(m_Columns * m_Rows + 1, 0);
+  uint32_t index = 0;
+  for (const auto& pObj : *pHolder) {
+    if (!pObj) {
+      ++index;
+      continue;
+    }
+    const CFX_FloatRect& rect = pObj->GetRect();
+    if (!IsUsableRect(rect)) {
+      m_LargeObjects.push_back(index++);
+      continue;
+    }
+    CellRange range;
+    range.first_col = GetColumn(rect.left);
+    range.last_col = GetColumn(rect.right);
+    range.first_row = GetRow(rect.bottom);
+    range.last_row = GetRow(rect.top);
+    if ((range.last_col - range.first_col + 1) *
+            (range.last_row - range.first_row + 1) >
+        kMaxCellsPerObject) {
+      m_LargeObjects.push_back(index++);
+      continue;
+    }
+    ranges[index] = range;
+    for (int row = range.first_row; row <= range.last_row; ++row) {
+      for (int col = range.first_col; col <= range.last_col; ++col)
+        ++m_CellStarts[row * m_Columns + col + 1];
+    }
+    ++index;
+  }
+
+  for (size_t i = 1; i < m_CellStarts.size(); ++i)
+    m_CellStarts[i] += m_CellStarts[i - 1];
+  m_CellObjects.resize(m_CellStarts.back());
+  std::vector<uint32_t> cell_ends(m_CellStarts.begin(), m_CellStarts.end() - 1);
+  for (index = 0; index < m_ObjectCount; ++index) {
+    const CellRange& range = ranges[index];
+    for (int row = range.first_row; row <= range.last_row; ++row) {
+      for (int col = range.first_col; col <= range.last_col; ++col)
+        m_CellObjects[cell_ends[row * m_Columns + col]++] = index;
+    }
+  }
+}
+
+CPDF_PageObjectIndex::~CPDF_PageObjectIndex() = default;
+
+bool CPDF_PageObjectIndex::FindObjects(const CFX_FloatRect& rect,
+                                       std::vector<uint32_t>* indices) const {
+  indices->clear();
+  if (!IsUsableRect(rect))
+    return false;
+
+  const int left = GetColumn(rect.left);
+  const int right = GetColumn(rect.right);
+  const int bottom = GetRow(rect.bottom);
+  const int top = GetRow(rect.top);
+  const int cell_count = (right - left + 1) * (top - bottom + 1);
+  if (cell_count * 4 > m_Columns * m_Rows)
+    return false;
+
+  for (int row = bottom; row <= top; ++row) {
+    const size_t cell = row * m_Columns;
+    indices->insert(indices->end(),
+                    m_CellObjects.begin() + m_CellStarts[cell + left],
+                    m_CellObjects.begin() + m_CellStarts[cell + right + 1]);
+  }
+  indices->insert(indices->end(), m_LargeObjects.begin(), m_LargeObjects.end());
+  std::sort(indices->begin(), indices->end());
+  indices->erase(std::unique(indices->begin(), indices->end()), indices->end());
+  return true;
+}
+
+int CPDF_PageObjectIndex::GetColumn(float x) const {
+  return GetCell(x, m_Bounds.left, m_CellWidth, m_Columns);
+}
+
+int CPDF_PageObjectIndex::GetRow(float y) const {
+  return GetCell(y, m_Bounds.bottom, m_CellHeight, m_Rows);
+}
@@ -0,0 +1,58 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
+#define CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+
+class CPDF_PageObjectHolder;
+
+// Buckets the objects of a CPDF_PageObjectHolder into a uniform grid over
+// their rects, so that rendering only part of a large page, e.g. a zoomed-in
+// view or one band of a banded render, does not have to visit every object.
+// Built once the objects are known and reused for any matrix and clip.
+class CPDF_PageObjectIndex {
+ public:
+  // Holders with fewer objects are cheaper to scan than to index.
+  static constexpr size_t kMinObjectCount = 512;
+
+  explicit CPDF_PageObjectIndex(const CPDF_PageObjectHolder* pHolder);
+  ~CPDF_PageObjectIndex();
+
+  // Fills |indices| with the indices of the objects that may intersect |rect|,
+  // in paint order. Objects whose rects do not intersect |rect| can still be
+  // included. Returns false, leaving |indices| empty, when |rect| covers so
+  // much of the grid that scanning all objects is faster.
+  bool FindObjects(const CFX_FloatRect& rect,
+                   std::vector<uint32_t>* indices) const;
+
+  size_t GetObjectCount() const { return m_ObjectCount; }
+
+ private:
+  // Grid column and row for a page space coordinate, clamped to the grid.
+  int GetColumn(float x) const;
+  int GetRow(float y) const;
+
+  size_t m_ObjectCount = 0;
+  CFX_FloatRect m_Bounds;
+  float m_CellWidth = 0;
+  float m_CellHeight = 0;
+  int m_Columns = 1;
+  int m_Rows = 1;
+  // Objects of cell |i| are |m_CellObjects[m_CellStarts[i]]| up to
+  // |m_CellObjects[m_CellStarts[i + 1]]|, in increasing index order.
+  std::vector<uint32_t> m_CellStarts;
+  std::vector<uint32_t> m_CellObjects;
+  // Objects spanning too many cells, or without a usable rect. These are
+  // returned for every query.
+  std::vector<uint32_t> m_LargeObjects;
+};
+
+#endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
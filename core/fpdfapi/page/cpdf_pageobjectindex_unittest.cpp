@@ -0,0 +1,154 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "core/fpdfapi/page/cpdf_pageobjectholder.h"
+#include "core/fpdfapi/page/cpdf_pathobject.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/base/containers/contains.h"
+
+namespace {
+
+constexpr int kGridSize = 32;
+
+// Fills |holder| with a |kGridSize| by |kGridSize| grid of 2x2 objects, one
+// every 10 units, in row order.
+void AddGridObjects(CPDF_PageObjectHolder* holder) {
+  for (int y = 0; y < kGridSize; ++y) {
+    for (int x = 0; x < kGridSize; ++x) {
+      auto path = std::make_unique<CPDF_PathObject>();
+      path->SetRect(CFX_FloatRect(x * 10, y * 10, x * 10 + 2, y * 10 + 2));
+      holder->AppendPageObject(std::move(path));
+    }
+  }
+}
+
+std::vector<uint32_t> ScanObjects(const CPDF_PageObjectHolder& holder,
+                                  const CFX_FloatRect& rect) {
+  std::vector<uint32_t> result;
+  for (uint32_t i = 0; i < holder.GetPageObjectCount(); ++i) {
+    const CFX_FloatRect& obj_rect = holder.GetPageObjectByIndex(i)->GetRect();
+    if (obj_rect.left <= rect.right && obj_rect.right >= rect.left &&
+        obj_rect.bottom <= rect.top && obj_rect.top >= rect.bottom) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+// Checks that the index finds a sorted superset of what a scan finds.
+void CheckFindObjects(const CPDF_PageObjectHolder& holder,
+                      const CFX_FloatRect& rect) {
+  const CPDF_PageObjectIndex* index = holder.GetObjectIndex();
+  ASSERT_TRUE(index);
+  std::vector<uint32_t> found;
+  ASSERT_TRUE(index->FindObjects(rect, &found));
+  EXPECT_TRUE(std::is_sorted(found.begin(), found.end()));
+  for (uint32_t i : ScanObjects(holder, rect))
+    EXPECT_TRUE(pdfium::Contains(found, i)) << i;
+}
+
+}  // namespace
+
+TEST(CPDFPageObjectIndex, TooFewObjects) {
+  CPDF_PageObjectHolder holder(nullptr,
+                               pdfium::MakeRetain<CPDF_Dictionary>().Get(),
+                               nullptr, nullptr);
+  for (size_t i = 1; i < CPDF_PageObjectIndex::kMinObjectCount; ++i)
+    holder.AppendPageObject(std::make_unique<CPDF_PathObject>());
+  EXPECT_FALSE(holder.GetObjectIndex());
+
+  holder.AppendPageObject(std::make_unique<CPDF_PathObject>());
+  EXPECT_TRUE(holder.GetObjectIndex());
+}
+
+TEST(CPDFPageObjectIndex, FindObjects) {
+  CPDF_PageObjectHolder holder(nullptr,
+                               pdfium::MakeRetain<CPDF_Dictionary>().Get(),
+                               nullptr, nullptr);
+  AddGridObjects(&holder);
+  const CPDF_PageObjectIndex* index = holder.GetObjectIndex();
+  ASSERT_TRUE(index);
+  EXPECT_EQ(1024u, index->GetObjectCount());
+
+  std::vector<uint32_t> found;
+  ASSERT_TRUE(index->FindObjects(CFX_FloatRect(41, 51, 59, 59), &found));
+  EXPECT_LT(found.size(), 64u);
+  EXPECT_TRUE(pdfium::Contains(found, 5 * kGridSize + 5));
+
+  // Rects touching an object at its edge find it.
+  CheckFindObjects(holder, CFX_FloatRect(42, 52, 50, 60));
+  CheckFindObjects(holder, CFX_FloatRect(0, 0, 1, 1));
+  CheckFindObjects(holder, CFX_FloatRect(100.5f, 200.5f, 130.5f, 230.5f));
+  CheckFindObjects(holder, CFX_FloatRect(-500, -500, 0, 0));
+  CheckFindObjects(holder, CFX_FloatRect(312, 312, 1000, 1000));
+
+  // Rects covering much of the page are left to a scan.
+  EXPECT_FALSE(index->FindObjects(CFX_FloatRect(0, 0, 200, 200), &found));
+  EXPECT_TRUE(found.empty());
+  EXPECT_FALSE(index->FindObjects(CFX_FloatRect(0, 0, 0, NAN), &found));
+}
+
+TEST(CPDFPageObjectIndex, LargeObjects) {
+  CPDF_PageObjectHolder holder(nullptr,
+                               pdfium::MakeRetain<CPDF_Dictionary>().Get(),
+                               nullptr, nullptr);
+  auto background = std::make_unique<CPDF_PathObject>();
+  background->SetRect(CFX_FloatRect(0, 0, 320, 320));
+  holder.AppendPageObject(std::move(background));
+  AddGridObjects(&holder);
+  auto unbounded = std::make_unique<CPDF_PathObject>();
+  unbounded->SetRect(CFX_FloatRect(0, 0, INFINITY, 10));
+  holder.AppendPageObject(std::move(unbounded));
+
+  const CPDF_PageObjectIndex* index = holder.GetObjectIndex();
+  ASSERT_TRUE(index);
+  std::vector<uint32_t> found;
+  ASSERT_TRUE(index->FindObjects(CFX_FloatRect(201, 201, 209, 209), &found));
+  ASSERT_GE(found.size(), 2u);
+  EXPECT_EQ(0u, found.front());
+  EXPECT_EQ(1025u, found.back());
+}
+
+TEST(CPDFPageObjectIndex, Invalidation) {
+  CPDF_PageObjectHolder holder(nullptr,
+                               pdfium::MakeRetain<CPDF_Dictionary>().Get(),
+                               nullptr, nullptr);
+  AddGridObjects(&holder);
+  const CFX_FloatRect kRect(201, 201, 209, 209);
+  std::vector<uint32_t> found;
+  ASSERT_TRUE(holder.GetObjectIndex()->FindObjects(kRect, &found));
+  EXPECT_FALSE(pdfium::Contains(found, 0u));
+
+  // Setting the same rect again keeps the index.
+  const CPDF_PageObjectIndex* index = holder.GetObjectIndex();
+  CPDF_PageObject* first = holder.GetPageObjectByIndex(0);
+  first->SetRect(CFX_FloatRect(0, 0, 2, 2));
+  EXPECT_EQ(index, holder.GetObjectIndex());
+
+  // Moving an object updates the index.
+  first->SetRect(CFX_FloatRect(204, 204, 206, 206));
+  CheckFindObjects(holder, kRect);
+  ASSERT_TRUE(holder.GetObjectIndex()->FindObjects(kRect, &found));
+  EXPECT_TRUE(pdfium::Contains(found, 0u));
+
+  // So do removing and appending objects.
+  ASSERT_TRUE(holder.RemovePageObject(first));
+  std::unique_ptr<CPDF_PageObject> removed(first);
+  CheckFindObjects(holder, kRect);
+  removed->SetRect(CFX_FloatRect(0, 0, 2, 2));
+  holder.AppendPageObject(std::move(removed));
+  CheckFindObjects(holder, kRect);
+  CheckFindObjects(holder, CFX_FloatRect(0, 0, 1, 1));
+  ASSERT_TRUE(holder.GetObjectIndex()->FindObjects(CFX_FloatRect(0, 0, 1, 1),
+                                                   &found));
+  EXPECT_TRUE(pdfium::Contains(found, 1023u));
+}
@@ -36,6 +36,7 @@ class CPDF_Path {
   void Append(const CFX_Path& path, const CFX_Matrix* pMatrix);
   void AppendFloatRect(const CFX_FloatRect& rect);
   void AppendRect(float left, float bottom, float right, float top);
+  void AppendPoints(pdfium::span<const CFX_Path::Point> points);
   void AppendPoint(const CFX_PointF& point, CFX_Path::Point::Type type);
   void AppendPointAndClose(const CFX_PointF& point, CFX_Path::Point::Type type);
 
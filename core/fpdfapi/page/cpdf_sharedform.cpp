@@ -0,0 +1,62 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_sharedform.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/fpdfapi/page/cpdf_allstates.h"
+#include "core/fpdfapi/page/cpdf_form.h"
+
+namespace {
+
+// The text matrix changes with every "cm" in the caller, but forms that use
+// it are never shared, so it is left out of the comparison.
+bool TextStatesMatch(const CPDF_TextState& a, const CPDF_TextState& b) {
+  if (a == b)
+    return true;
+
+  const float* a_ctm = a.GetCTM();
+  const float* b_ctm = b.GetCTM();
+  return a.GetFont() == b.GetFont() && a.GetFontSize() == b.GetFontSize() &&
+         a.GetCharSpace() == b.GetCharSpace() &&
+         a.GetWordSpace() == b.GetWordSpace() &&
+         a.GetTextMode() == b.GetTextMode() &&
+         std::equal(a_ctm, a_ctm + 4, b_ctm);
+}
+
+}  // namespace
+
+CPDF_SharedForm::CPDF_SharedForm(std::unique_ptr<CPDF_Form> pForm,
+                                 const CPDF_GraphicStates& states)
+    : m_pForm(std::move(pForm)),
+      m_bShared(true),
+      m_GeneralState(states.m_GeneralState),
+      m_GraphState(states.m_GraphState),
+      m_ColorState(states.m_ColorState),
+      m_TextState(states.m_TextState) {}
+
+CPDF_SharedForm::CPDF_SharedForm(std::unique_ptr<CPDF_Form> pForm)
+    : m_pForm(std::move(pForm)), m_bShared(false) {}
+
+CPDF_SharedForm::~CPDF_SharedForm() = default;
+
+bool CPDF_SharedForm::WasParsedWith(const CPDF_GraphicStates& states) const {
+  return m_bShared && m_GeneralState == states.m_GeneralState &&
+         m_GraphState == states.m_GraphState &&
+         m_ColorState == states.m_ColorState &&
+         TextStatesMatch(m_TextState, states.m_TextState);
+}
+
+RetainPtr<CPDF_SharedForm> CPDF_SharedForm::CloneUnshared() const {
+  CPDF_AllStates status;
+  status.m_GeneralState = m_GeneralState;
+  status.m_GraphState = m_GraphState;
+  status.m_ColorState = m_ColorState;
+  status.m_TextState = m_TextState;
+  std::unique_ptr<CPDF_Form> pForm = m_pForm->CloneUnparsed();
+  pForm->ParseContent(&status, nullptr, nullptr);
+  return pdfium::MakeRetain<CPDF_SharedForm>(std::move(pForm));
+}
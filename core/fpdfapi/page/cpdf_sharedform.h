@@ -0,0 +1,53 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PAGE_CPDF_SHAREDFORM_H_
+#define CORE_FPDFAPI_PAGE_CPDF_SHAREDFORM_H_
+
+#include <memory>
+
+#include "core/fpdfapi/page/cpdf_graphicstates.h"
+#include "core/fxcrt/observed_ptr.h"
+#include "core/fxcrt/retain_ptr.h"
+
+class CPDF_Form;
+
+// Parsed content of a form XObject, shared by every form object that draws
+// the same stream with the same inherited graphic states. The page objects of
+// the form must not be modified while it is shared; see
+// CPDF_FormObject::GetMutableForm().
+class CPDF_SharedForm final : public Retainable, public Observable {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  CPDF_Form* form() const { return m_pForm.get(); }
+
+  // Returns true if |form()| would parse the same with |states|. States are
+  // mostly compared by identity, which is cheap and never gives false
+  // matches. Always false once the form is no longer shared.
+  bool WasParsedWith(const CPDF_GraphicStates& states) const;
+
+  bool IsShared() const { return m_bShared; }
+  void StopSharing() { m_bShared = false; }
+
+  // Returns an unshared copy, parsed again with the same states.
+  RetainPtr<CPDF_SharedForm> CloneUnshared() const;
+
+ private:
+  CPDF_SharedForm(std::unique_ptr<CPDF_Form> pForm,
+                  const CPDF_GraphicStates& states);
+  explicit CPDF_SharedForm(std::unique_ptr<CPDF_Form> pForm);
+  ~CPDF_SharedForm() override;
+
+  std::unique_ptr<CPDF_Form> const m_pForm;
+  bool m_bShared;
+  // Holding these keeps the shared state objects from being modified in
+  // place, so that identity keeps implying equal values.
+  CPDF_GeneralState m_GeneralState;
+  CFX_GraphState m_GraphState;
+  CPDF_ColorState m_ColorState;
+  CPDF_TextState m_TextState;
+};
+
+#endif  // CORE_FPDFAPI_PAGE_CPDF_SHAREDFORM_H_
@@ -6,6 +6,8 @@
 
 #include "core/fpdfapi/page/cpdf_streamcontentparser.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <memory>
 #include <utility>
@@ -23,8 +25,8 @@
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fpdfapi/page/cpdf_pathobject.h"
 #include "core/fpdfapi/page/cpdf_shadingobject.h"
+#include "core/fpdfapi/page/cpdf_sharedform.h"
 #include "core/fpdfapi/page/cpdf_shadingpattern.h"
-#include "core/fpdfapi/page/cpdf_streamparser.h"
 #include "core/fpdfapi/page/cpdf_textobject.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
@@ -41,7 +43,6 @@
 #include "third_party/base/check.h"
 #include "third_party/base/containers/contains.h"
 #include "third_party/base/cxx17_backports.h"
-#include "third_party/base/no_destructor.h"
 #include "third_party/base/notreached.h"
 #include "third_party/base/span.h"
 
@@ -63,6 +64,9 @@ const char kPathOperatorCubicBezier3 = 'y';
 const char kPathOperatorClosePath = 'h';
 const char kPathOperatorRectangle[] = "re";
 
+// Bounds |m_SharedPaths|; dropping entries only stops later paths from sharing.
+constexpr size_t kMaxSharedPaths = 1024;
+
 CFX_FloatRect GetShadingBBox(CPDF_ShadingPattern* pShading,
                              const CFX_Matrix& matrix) {
   ShadingType type = pShading->GetShadingType();
@@ -240,6 +244,28 @@ void ReplaceAbbr(CPDF_Object* pObj) {
     ReplaceAbbrInArray(pArray);
 }
 
+size_t HashPathPoints(pdfium::span<const CFX_Path::Point> points) {
+  size_t hash = points.size();
+  for (const CFX_Path::Point& point : points) {
+    uint32_t x;
+    uint32_t y;
+    memcpy(&x, &point.m_Point.x, sizeof(x));
+    memcpy(&y, &point.m_Point.y, sizeof(y));
+    hash = hash * 1000003 ^ x;
+    hash = hash * 1000003 ^ y;
+    hash = hash * 1000003 ^ (static_cast<size_t>(point.m_Type) << 1 |
+                             static_cast<size_t>(point.m_CloseFigure));
+  }
+  return hash;
+}
+
+bool PathPointsEqual(const CPDF_Path& path,
+                     pdfium::span<const CFX_Path::Point> points) {
+  const std::vector<CFX_Path::Point>& path_points = path.GetPoints();
+  return path_points.size() == points.size() &&
+         std::equal(points.begin(), points.end(), path_points.begin());
+}
+
 }  // namespace
 
 CPDF_StreamContentParser::CPDF_StreamContentParser(
@@ -260,12 +286,14 @@ CPDF_StreamContentParser::CPDF_StreamContentParser(
                                                   pPageResources)),
       m_pObjectHolder(pObjHolder),
       m_ParsedSet(pParsedSet),
+      m_bTextOnly(pObjHolder->IsTextOnly()),
       m_BBox(rcBBox),
       m_pCurStates(std::make_unique<CPDF_AllStates>()) {
   if (pmtContentToUser)
     m_mtContentToUser = *pmtContentToUser;
   if (pStates) {
     m_pCurStates->Copy(*pStates);
+    m_bTextMatrixInherited = true;
   } else {
     m_pCurStates->m_GeneralState.Emplace();
     m_pCurStates->m_GraphState.Emplace();
@@ -430,134 +458,226 @@ void CPDF_StreamContentParser::SetGraphicStates(CPDF_PageObject* pObj,
   }
 }
 
-// static
-CPDF_StreamContentParser::OpCodes
-CPDF_StreamContentParser::InitializeOpCodes() {
-  return OpCodes({
-      {FXBSTR_ID('"', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_NextLineShowText_Space},
-      {FXBSTR_ID('\'', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_NextLineShowText},
-      {FXBSTR_ID('B', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_FillStrokePath},
-      {FXBSTR_ID('B', '*', 0, 0),
-       &CPDF_StreamContentParser::Handle_EOFillStrokePath},
-      {FXBSTR_ID('B', 'D', 'C', 0),
-       &CPDF_StreamContentParser::Handle_BeginMarkedContent_Dictionary},
-      {FXBSTR_ID('B', 'I', 0, 0), &CPDF_StreamContentParser::Handle_BeginImage},
-      {FXBSTR_ID('B', 'M', 'C', 0),
-       &CPDF_StreamContentParser::Handle_BeginMarkedContent},
-      {FXBSTR_ID('B', 'T', 0, 0), &CPDF_StreamContentParser::Handle_BeginText},
-      {FXBSTR_ID('C', 'S', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetColorSpace_Stroke},
-      {FXBSTR_ID('D', 'P', 0, 0),
-       &CPDF_StreamContentParser::Handle_MarkPlace_Dictionary},
-      {FXBSTR_ID('D', 'o', 0, 0),
-       &CPDF_StreamContentParser::Handle_ExecuteXObject},
-      {FXBSTR_ID('E', 'I', 0, 0), &CPDF_StreamContentParser::Handle_EndImage},
-      {FXBSTR_ID('E', 'M', 'C', 0),
-       &CPDF_StreamContentParser::Handle_EndMarkedContent},
-      {FXBSTR_ID('E', 'T', 0, 0), &CPDF_StreamContentParser::Handle_EndText},
-      {FXBSTR_ID('F', 0, 0, 0), &CPDF_StreamContentParser::Handle_FillPathOld},
-      {FXBSTR_ID('G', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SetGray_Stroke},
-      {FXBSTR_ID('I', 'D', 0, 0),
-       &CPDF_StreamContentParser::Handle_BeginImageData},
-      {FXBSTR_ID('J', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetLineCap},
-      {FXBSTR_ID('K', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCMYKColor_Stroke},
-      {FXBSTR_ID('M', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SetMiterLimit},
-      {FXBSTR_ID('M', 'P', 0, 0), &CPDF_StreamContentParser::Handle_MarkPlace},
-      {FXBSTR_ID('Q', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_RestoreGraphState},
-      {FXBSTR_ID('R', 'G', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetRGBColor_Stroke},
-      {FXBSTR_ID('S', 0, 0, 0), &CPDF_StreamContentParser::Handle_StrokePath},
-      {FXBSTR_ID('S', 'C', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetColor_Stroke},
-      {FXBSTR_ID('S', 'C', 'N', 0),
-       &CPDF_StreamContentParser::Handle_SetColorPS_Stroke},
-      {FXBSTR_ID('T', '*', 0, 0),
-       &CPDF_StreamContentParser::Handle_MoveToNextLine},
-      {FXBSTR_ID('T', 'D', 0, 0),
-       &CPDF_StreamContentParser::Handle_MoveTextPoint_SetLeading},
-      {FXBSTR_ID('T', 'J', 0, 0),
-       &CPDF_StreamContentParser::Handle_ShowText_Positioning},
-      {FXBSTR_ID('T', 'L', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetTextLeading},
-      {FXBSTR_ID('T', 'c', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCharSpace},
-      {FXBSTR_ID('T', 'd', 0, 0),
-       &CPDF_StreamContentParser::Handle_MoveTextPoint},
-      {FXBSTR_ID('T', 'f', 0, 0), &CPDF_StreamContentParser::Handle_SetFont},
-      {FXBSTR_ID('T', 'j', 0, 0), &CPDF_StreamContentParser::Handle_ShowText},
-      {FXBSTR_ID('T', 'm', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetTextMatrix},
-      {FXBSTR_ID('T', 'r', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetTextRenderMode},
-      {FXBSTR_ID('T', 's', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetTextRise},
-      {FXBSTR_ID('T', 'w', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetWordSpace},
-      {FXBSTR_ID('T', 'z', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetHorzScale},
-      {FXBSTR_ID('W', 0, 0, 0), &CPDF_StreamContentParser::Handle_Clip},
-      {FXBSTR_ID('W', '*', 0, 0), &CPDF_StreamContentParser::Handle_EOClip},
-      {FXBSTR_ID('b', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_CloseFillStrokePath},
-      {FXBSTR_ID('b', '*', 0, 0),
-       &CPDF_StreamContentParser::Handle_CloseEOFillStrokePath},
-      {FXBSTR_ID('c', 0, 0, 0), &CPDF_StreamContentParser::Handle_CurveTo_123},
-      {FXBSTR_ID('c', 'm', 0, 0),
-       &CPDF_StreamContentParser::Handle_ConcatMatrix},
-      {FXBSTR_ID('c', 's', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetColorSpace_Fill},
-      {FXBSTR_ID('d', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetDash},
-      {FXBSTR_ID('d', '0', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCharWidth},
-      {FXBSTR_ID('d', '1', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCachedDevice},
-      {FXBSTR_ID('f', 0, 0, 0), &CPDF_StreamContentParser::Handle_FillPath},
-      {FXBSTR_ID('f', '*', 0, 0), &CPDF_StreamContentParser::Handle_EOFillPath},
-      {FXBSTR_ID('g', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetGray_Fill},
-      {FXBSTR_ID('g', 's', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetExtendGraphState},
-      {FXBSTR_ID('h', 0, 0, 0), &CPDF_StreamContentParser::Handle_ClosePath},
-      {FXBSTR_ID('i', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetFlat},
-      {FXBSTR_ID('j', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetLineJoin},
-      {FXBSTR_ID('k', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCMYKColor_Fill},
-      {FXBSTR_ID('l', 0, 0, 0), &CPDF_StreamContentParser::Handle_LineTo},
-      {FXBSTR_ID('m', 0, 0, 0), &CPDF_StreamContentParser::Handle_MoveTo},
-      {FXBSTR_ID('n', 0, 0, 0), &CPDF_StreamContentParser::Handle_EndPath},
-      {FXBSTR_ID('q', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SaveGraphState},
-      {FXBSTR_ID('r', 'e', 0, 0), &CPDF_StreamContentParser::Handle_Rectangle},
-      {FXBSTR_ID('r', 'g', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetRGBColor_Fill},
-      {FXBSTR_ID('r', 'i', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetRenderIntent},
-      {FXBSTR_ID('s', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_CloseStrokePath},
-      {FXBSTR_ID('s', 'c', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetColor_Fill},
-      {FXBSTR_ID('s', 'c', 'n', 0),
-       &CPDF_StreamContentParser::Handle_SetColorPS_Fill},
-      {FXBSTR_ID('s', 'h', 0, 0), &CPDF_StreamContentParser::Handle_ShadeFill},
-      {FXBSTR_ID('v', 0, 0, 0), &CPDF_StreamContentParser::Handle_CurveTo_23},
-      {FXBSTR_ID('w', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetLineWidth},
-      {FXBSTR_ID('y', 0, 0, 0), &CPDF_StreamContentParser::Handle_CurveTo_13},
-  });
-}
-
 void CPDF_StreamContentParser::OnOperator(ByteStringView op) {
-  static const pdfium::base::NoDestructor<OpCodes> s_OpCodes(
-      InitializeOpCodes());
-
-  auto it = s_OpCodes->find(op.GetID());
-  if (it != s_OpCodes->end())
-    (this->*it->second)();
+  // A switch lets the compiler build a branch tree over the constant IDs
+  // instead of walking map nodes for every operator in the stream.
+  switch (op.GetID()) {
+    case FXBSTR_ID('"', 0, 0, 0):
+      Handle_NextLineShowText_Space();
+      break;
+    case FXBSTR_ID('\'', 0, 0, 0):
+      Handle_NextLineShowText();
+      break;
+    case FXBSTR_ID('B', 0, 0, 0):
+      Handle_FillStrokePath();
+      break;
+    case FXBSTR_ID('B', '*', 0, 0):
+      Handle_EOFillStrokePath();
+      break;
+    case FXBSTR_ID('B', 'D', 'C', 0):
+      Handle_BeginMarkedContent_Dictionary();
+      break;
+    case FXBSTR_ID('B', 'I', 0, 0):
+      Handle_BeginImage();
+      break;
+    case FXBSTR_ID('B', 'M', 'C', 0):
+      Handle_BeginMarkedContent();
+      break;
+    case FXBSTR_ID('B', 'T', 0, 0):
+      Handle_BeginText();
+      break;
+    case FXBSTR_ID('C', 'S', 0, 0):
+      Handle_SetColorSpace_Stroke();
+      break;
+    case FXBSTR_ID('D', 'P', 0, 0):
+      Handle_MarkPlace_Dictionary();
+      break;
+    case FXBSTR_ID('D', 'o', 0, 0):
+      Handle_ExecuteXObject();
+      break;
+    case FXBSTR_ID('E', 'I', 0, 0):
+      Handle_EndImage();
+      break;
+    case FXBSTR_ID('E', 'M', 'C', 0):
+      Handle_EndMarkedContent();
+      break;
+    case FXBSTR_ID('E', 'T', 0, 0):
+      Handle_EndText();
+      break;
+    case FXBSTR_ID('F', 0, 0, 0):
+      Handle_FillPathOld();
+      break;
+    case FXBSTR_ID('G', 0, 0, 0):
+      Handle_SetGray_Stroke();
+      break;
+    case FXBSTR_ID('I', 'D', 0, 0):
+      Handle_BeginImageData();
+      break;
+    case FXBSTR_ID('J', 0, 0, 0):
+      Handle_SetLineCap();
+      break;
+    case FXBSTR_ID('K', 0, 0, 0):
+      Handle_SetCMYKColor_Stroke();
+      break;
+    case FXBSTR_ID('M', 0, 0, 0):
+      Handle_SetMiterLimit();
+      break;
+    case FXBSTR_ID('M', 'P', 0, 0):
+      Handle_MarkPlace();
+      break;
+    case FXBSTR_ID('Q', 0, 0, 0):
+      Handle_RestoreGraphState();
+      break;
+    case FXBSTR_ID('R', 'G', 0, 0):
+      Handle_SetRGBColor_Stroke();
+      break;
+    case FXBSTR_ID('S', 0, 0, 0):
+      Handle_StrokePath();
+      break;
+    case FXBSTR_ID('S', 'C', 0, 0):
+      Handle_SetColor_Stroke();
+      break;
+    case FXBSTR_ID('S', 'C', 'N', 0):
+      Handle_SetColorPS_Stroke();
+      break;
+    case FXBSTR_ID('T', '*', 0, 0):
+      Handle_MoveToNextLine();
+      break;
+    case FXBSTR_ID('T', 'D', 0, 0):
+      Handle_MoveTextPoint_SetLeading();
+      break;
+    case FXBSTR_ID('T', 'J', 0, 0):
+      Handle_ShowText_Positioning();
+      break;
+    case FXBSTR_ID('T', 'L', 0, 0):
+      Handle_SetTextLeading();
+      break;
+    case FXBSTR_ID('T', 'c', 0, 0):
+      Handle_SetCharSpace();
+      break;
+    case FXBSTR_ID('T', 'd', 0, 0):
+      Handle_MoveTextPoint();
+      break;
+    case FXBSTR_ID('T', 'f', 0, 0):
+      Handle_SetFont();
+      break;
+    case FXBSTR_ID('T', 'j', 0, 0):
+      Handle_ShowText();
+      break;
+    case FXBSTR_ID('T', 'm', 0, 0):
+      Handle_SetTextMatrix();
+      break;
+    case FXBSTR_ID('T', 'r', 0, 0):
+      Handle_SetTextRenderMode();
+      break;
+    case FXBSTR_ID('T', 's', 0, 0):
+      Handle_SetTextRise();
+      break;
+    case FXBSTR_ID('T', 'w', 0, 0):
+      Handle_SetWordSpace();
+      break;
+    case FXBSTR_ID('T', 'z', 0, 0):
+      Handle_SetHorzScale();
+      break;
+    case FXBSTR_ID('W', 0, 0, 0):
+      Handle_Clip();
+      break;
+    case FXBSTR_ID('W', '*', 0, 0):
+      Handle_EOClip();
+      break;
+    case FXBSTR_ID('b', 0, 0, 0):
+      Handle_CloseFillStrokePath();
+      break;
+    case FXBSTR_ID('b', '*', 0, 0):
+      Handle_CloseEOFillStrokePath();
+      break;
+    case FXBSTR_ID('c', 0, 0, 0):
+      Handle_CurveTo_123();
+      break;
+    case FXBSTR_ID('c', 'm', 0, 0):
+      Handle_ConcatMatrix();
+      break;
+    case FXBSTR_ID('c', 's', 0, 0):
+      Handle_SetColorSpace_Fill();
+      break;
+    case FXBSTR_ID('d', 0, 0, 0):
+      Handle_SetDash();
+      break;
+    case FXBSTR_ID('d', '0', 0, 0):
+      Handle_SetCharWidth();
+      break;
+    case FXBSTR_ID('d', '1', 0, 0):
+      Handle_SetCachedDevice();
+      break;
+    case FXBSTR_ID('f', 0, 0, 0):
+      Handle_FillPath();
+      break;
+    case FXBSTR_ID('f', '*', 0, 0):
+      Handle_EOFillPath();
+      break;
+    case FXBSTR_ID('g', 0, 0, 0):
+      Handle_SetGray_Fill();
+      break;
+    case FXBSTR_ID('g', 's', 0, 0):
+      Handle_SetExtendGraphState();
+      break;
+    case FXBSTR_ID('h', 0, 0, 0):
+      Handle_ClosePath();
+      break;
+    case FXBSTR_ID('i', 0, 0, 0):
+      Handle_SetFlat();
+      break;
+    case FXBSTR_ID('j', 0, 0, 0):
+      Handle_SetLineJoin();
+      break;
+    case FXBSTR_ID('k', 0, 0, 0):
+      Handle_SetCMYKColor_Fill();
+      break;
+    case FXBSTR_ID('l', 0, 0, 0):
+      Handle_LineTo();
+      break;
+    case FXBSTR_ID('m', 0, 0, 0):
+      Handle_MoveTo();
+      break;
+    case FXBSTR_ID('n', 0, 0, 0):
+      Handle_EndPath();
+      break;
+    case FXBSTR_ID('q', 0, 0, 0):
+      Handle_SaveGraphState();
+      break;
+    case FXBSTR_ID('r', 'e', 0, 0):
+      Handle_Rectangle();
+      break;
+    case FXBSTR_ID('r', 'g', 0, 0):
+      Handle_SetRGBColor_Fill();
+      break;
+    case FXBSTR_ID('r', 'i', 0, 0):
+      Handle_SetRenderIntent();
+      break;
+    case FXBSTR_ID('s', 0, 0, 0):
+      Handle_CloseStrokePath();
+      break;
+    case FXBSTR_ID('s', 'c', 0, 0):
+      Handle_SetColor_Fill();
+      break;
+    case FXBSTR_ID('s', 'c', 'n', 0):
+      Handle_SetColorPS_Fill();
+      break;
+    case FXBSTR_ID('s', 'h', 0, 0):
+      Handle_ShadeFill();
+      break;
+    case FXBSTR_ID('v', 0, 0, 0):
+      Handle_CurveTo_23();
+      break;
+    case FXBSTR_ID('w', 0, 0, 0):
+      Handle_SetLineWidth();
+      break;
+    case FXBSTR_ID('y', 0, 0, 0):
+      Handle_CurveTo_13();
+      break;
+    default:
+      break;
+  }
 }
 
 void CPDF_StreamContentParser::Handle_CloseFillStrokePath() {
@@ -643,6 +763,7 @@ void CPDF_StreamContentParser::Handle_BeginImage() {
   pDict->SetNewFor<CPDF_Name>("Subtype", "Image");
   RetainPtr<CPDF_Stream> pStream =
       m_pSyntax->ReadInlineStream(m_pDocument.Get(), std::move(pDict), pCSObj);
+  bool bFoundEnd = false;
   while (1) {
     CPDF_StreamParser::SyntaxType type = m_pSyntax->ParseNextElement();
     if (type == CPDF_StreamParser::EndOfData) {
@@ -652,9 +773,19 @@ void CPDF_StreamContentParser::Handle_BeginImage() {
       continue;
     }
     if (m_pSyntax->GetWord() == "EI") {
+      bFoundEnd = true;
       break;
     }
   }
+  // Without "EI", the image may have been cut short by the end of the window.
+  if (!bFoundEnd && m_DataEnd == DataEnd::kWindowEnd) {
+    m_bNeedMoreData = true;
+    return;
+  }
+  // The image data still had to be read to find where it ends.
+  if (m_bTextOnly)
+    return;
+
   CPDF_ImageObject* pObj = AddImage(std::move(pStream));
   // Record the bounding box of this image, so rendering code can draw it
   // properly.
@@ -751,7 +882,7 @@ void CPDF_StreamContentParser::Handle_ExecuteXObject() {
     return;
   }
 
-  if (type == "Image") {
+  if (type == "Image" && !m_bTextOnly) {
     CPDF_ImageObject* pObj = pXObject->IsInline()
                                  ? AddImage(ToStream(pXObject->Clone()))
                                  : AddImage(pXObject->GetObjNum());
@@ -771,14 +902,35 @@ void CPDF_StreamContentParser::AddForm(CPDF_Stream* pStream) {
   status.m_GraphState = m_pCurStates->m_GraphState;
   status.m_ColorState = m_pCurStates->m_ColorState;
   status.m_TextState = m_pCurStates->m_TextState;
-  auto form = std::make_unique<CPDF_Form>(
-      m_pDocument.Get(), m_pPageResources.Get(), pStream, m_pResources.Get());
-  form->ParseContent(&status, nullptr, m_ParsedSet.Get());
+
+  // Forms drawn many times with the same inherited states are parsed once.
+  CPDF_DocPageData* pPageData =
+      CPDF_DocPageData::FromDocument(m_pDocument.Get());
+  const CPDF_DocPageData::FormKey key = {
+      pStream, m_pPageResources.Get(),
+      CPDF_Form::ChooseResourcesDict(
+          pStream->GetDict()->GetDictFor("Resources"), m_pResources.Get(),
+          m_pPageResources.Get()),
+      m_bTextOnly};
+  RetainPtr<CPDF_SharedForm> pSharedForm =
+      pPageData->GetSharedForm(key, status);
+  if (!pSharedForm) {
+    auto form = std::make_unique<CPDF_Form>(
+        m_pDocument.Get(), m_pPageResources.Get(), pStream, m_pResources.Get());
+    form->SetTextOnly(m_bTextOnly);
+    form->ParseContent(&status, nullptr, m_ParsedSet.Get());
+    const bool bShareable = form->IsShareable();
+    pSharedForm = pdfium::MakeRetain<CPDF_SharedForm>(std::move(form), status);
+    if (bShareable)
+      pPageData->AddSharedForm(key, pSharedForm);
+    else
+      m_pObjectHolder->SetNotShareable();
+  }
 
   CFX_Matrix matrix = m_pCurStates->m_CTM * m_mtContentToUser;
 
-  auto pFormObj = std::make_unique<CPDF_FormObject>(GetCurrentStreamIndex(),
-                                                    std::move(form), matrix);
+  auto pFormObj = std::make_unique<CPDF_FormObject>(
+      m_CurrentStreamIndex, std::move(pSharedForm), matrix);
   if (!m_pObjectHolder->BackgroundAlphaNeeded() &&
       pFormObj->form()->BackgroundAlphaNeeded()) {
     m_pObjectHolder->SetBackgroundAlphaNeeded(true);
@@ -793,7 +945,7 @@ CPDF_ImageObject* CPDF_StreamContentParser::AddImage(
   if (!pStream)
     return nullptr;
 
-  auto pImageObj = std::make_unique<CPDF_ImageObject>(GetCurrentStreamIndex());
+  auto pImageObj = std::make_unique<CPDF_ImageObject>(m_CurrentStreamIndex);
   pImageObj->SetImage(
       pdfium::MakeRetain<CPDF_Image>(m_pDocument.Get(), std::move(pStream)));
 
@@ -801,7 +953,7 @@ CPDF_ImageObject* CPDF_StreamContentParser::AddImage(
 }
 
 CPDF_ImageObject* CPDF_StreamContentParser::AddImage(uint32_t streamObjNum) {
-  auto pImageObj = std::make_unique<CPDF_ImageObject>(GetCurrentStreamIndex());
+  auto pImageObj = std::make_unique<CPDF_ImageObject>(m_CurrentStreamIndex);
   pImageObj->SetImage(CPDF_DocPageData::FromDocument(m_pDocument.Get())
                           ->GetImage(streamObjNum));
 
@@ -813,7 +965,7 @@ CPDF_ImageObject* CPDF_StreamContentParser::AddImage(
   if (!pImage)
     return nullptr;
 
-  auto pImageObj = std::make_unique<CPDF_ImageObject>(GetCurrentStreamIndex());
+  auto pImageObj = std::make_unique<CPDF_ImageObject>(m_CurrentStreamIndex);
   pImageObj->SetImage(CPDF_DocPageData::FromDocument(m_pDocument.Get())
                           ->GetImage(pImage->GetStream()->GetObjNum()));
 
@@ -1076,6 +1228,9 @@ void CPDF_StreamContentParser::Handle_SetColorPS_Stroke() {
 }
 
 void CPDF_StreamContentParser::Handle_ShadeFill() {
+  if (m_bTextOnly)
+    return;
+
   RetainPtr<CPDF_ShadingPattern> pShading = FindShading(GetString(0));
   if (!pShading)
     return;
@@ -1084,7 +1239,7 @@ void CPDF_StreamContentParser::Handle_ShadeFill() {
     return;
 
   CFX_Matrix matrix = m_pCurStates->m_CTM * m_mtContentToUser;
-  auto pObj = std::make_unique<CPDF_ShadingObject>(GetCurrentStreamIndex(),
+  auto pObj = std::make_unique<CPDF_ShadingObject>(m_CurrentStreamIndex,
                                                    pShading.Get(), matrix);
   SetGraphicStates(pObj.get(), false, false, false);
   CFX_FloatRect bbox =
@@ -1233,8 +1388,11 @@ void CPDF_StreamContentParser::AddTextObject(const ByteString* pStrs,
   const TextRenderingMode text_mode =
       pFont->IsType3Font() ? TextRenderingMode::MODE_FILL
                            : m_pCurStates->m_TextState.GetTextMode();
+  // The text matrix of the caller is only meaningful to the caller.
+  if (m_bTextMatrixInherited)
+    m_pObjectHolder->SetNotShareable();
   {
-    auto pText = std::make_unique<CPDF_TextObject>(GetCurrentStreamIndex());
+    auto pText = std::make_unique<CPDF_TextObject>(m_CurrentStreamIndex);
     m_pLastTextObject = pText.get();
     SetGraphicStates(pText.get(), true, true, true);
     if (TextRenderingModeIsStrokeMode(text_mode)) {
@@ -1273,13 +1431,6 @@ float CPDF_StreamContentParser::GetVerticalTextSize(float fKerning) const {
   return fKerning * m_pCurStates->m_TextState.GetFontSize() / 1000;
 }
 
-int32_t CPDF_StreamContentParser::GetCurrentStreamIndex() {
-  auto it =
-      std::upper_bound(m_StreamStartOffsets.begin(), m_StreamStartOffsets.end(),
-                       m_pSyntax->GetPos() + m_StartParseOffset);
-  return (it - m_StreamStartOffsets.begin()) - 1;
-}
-
 void CPDF_StreamContentParser::Handle_ShowText() {
   ByteString str = GetString(0);
   if (!str.IsEmpty())
@@ -1344,6 +1495,7 @@ void CPDF_StreamContentParser::Handle_SetTextMatrix() {
 }
 
 void CPDF_StreamContentParser::OnChangeTextMatrix() {
+  m_bTextMatrixInherited = false;
   CFX_Matrix text_matrix(m_pCurStates->m_TextHorzScale, 0.0f, 0.0f, 1.0f, 0.0f,
                          0.0f);
   text_matrix.Concat(m_pCurStates->m_TextMatrix);
@@ -1422,6 +1574,10 @@ void CPDF_StreamContentParser::Handle_Invalid() {}
 
 void CPDF_StreamContentParser::AddPathPoint(const CFX_PointF& point,
                                             CFX_Path::Point::Type type) {
+  // No path is ever built, so AddPathObject() neither adds paths nor clips.
+  if (m_bTextOnly)
+    return;
+
   // If the path point is the same move as the previous one and neither of them
   // closes the path, then just skip it.
   if (type == CFX_Path::Point::Type::kMove && !m_PathPoints.empty() &&
@@ -1448,7 +1604,7 @@ void CPDF_StreamContentParser::AddPathPointAndClose(
     const CFX_PointF& point,
     CFX_Path::Point::Type type) {
   m_PathCurrent = point;
-  if (m_PathPoints.empty())
+  if (m_bTextOnly || m_PathPoints.empty())
     return;
 
   m_PathPoints.push_back(CFX_Path::Point(point, type, /*close=*/true));
@@ -1478,18 +1634,12 @@ void CPDF_StreamContentParser::AddPathObject(
   if (path_points.back().IsTypeAndOpen(CFX_Path::Point::Type::kMove))
     path_points.pop_back();
 
-  CPDF_Path path;
-  for (const auto& point : path_points) {
-    if (point.m_CloseFigure)
-      path.AppendPointAndClose(point.m_Point, point.m_Type);
-    else
-      path.AppendPoint(point.m_Point, point.m_Type);
-  }
-
   CFX_Matrix matrix = m_pCurStates->m_CTM * m_mtContentToUser;
   bool bStroke = render_type == RenderType::kStroke;
+  CPDF_Path path;
   if (bStroke || fill_type != CFX_FillRenderOptions::FillType::kNoFill) {
-    auto pPathObj = std::make_unique<CPDF_PathObject>(GetCurrentStreamIndex());
+    path = GetSharedPath(path_points);
+    auto pPathObj = std::make_unique<CPDF_PathObject>(m_CurrentStreamIndex);
     pPathObj->set_stroke(bStroke);
     pPathObj->set_filltype(fill_type);
     pPathObj->path() = path;
@@ -1498,28 +1648,48 @@ void CPDF_StreamContentParser::AddPathObject(
     m_pObjectHolder->AppendPageObject(std::move(pPathObj));
   }
   if (path_clip_type != CFX_FillRenderOptions::FillType::kNoFill) {
+    if (!path.HasRef())
+      path.AppendPoints(path_points);
     if (!matrix.IsIdentity())
       path.Transform(matrix);
     m_pCurStates->m_ClipPath.AppendPathWithAutoMerge(path, path_clip_type);
   }
 }
 
+CPDF_Path CPDF_StreamContentParser::GetSharedPath(
+    pdfium::span<const CFX_Path::Point> points) {
+  size_t hash = HashPathPoints(points);
+  auto it = m_SharedPaths.find(hash);
+  if (it != m_SharedPaths.end() && PathPointsEqual(it->second, points))
+    return it->second;
+
+  CPDF_Path path;
+  path.AppendPoints(points);
+  if (m_SharedPaths.size() >= kMaxSharedPaths)
+    m_SharedPaths.clear();
+  m_SharedPaths[hash] = path;
+  return path;
+}
+
 uint32_t CPDF_StreamContentParser::Parse(
     pdfium::span<const uint8_t> pData,
     uint32_t start_offset,
     uint32_t max_cost,
-    const std::vector<uint32_t>& stream_start_offsets) {
+    int32_t stream_index,
+    DataEnd data_end) {
   DCHECK(start_offset < pData.size());
+  m_bNeedMoreData = false;
+  m_DataEnd = data_end;
 
   // Parsing will be done from within |pDataStart|.
   pdfium::span<const uint8_t> pDataStart = pData.subspan(start_offset);
-  m_StartParseOffset = start_offset;
   if (m_ParsedSet->size() > kMaxFormLevel ||
       pdfium::Contains(*m_ParsedSet, pDataStart.data())) {
+    m_pObjectHolder->SetNotShareable();
     return pDataStart.size();
   }
 
-  m_StreamStartOffsets = stream_start_offsets;
+  m_CurrentStreamIndex = stream_index;
 
   ScopedSetInsertion<const uint8_t*> scopedInsert(m_ParsedSet.Get(),
                                                   pDataStart.data());
@@ -1534,11 +1704,19 @@ uint32_t CPDF_StreamContentParser::Parse(
     if (max_cost && cost >= max_cost) {
       break;
     }
-    switch (m_pSyntax->ParseNextElement()) {
+    const uint32_t element_start = m_pSyntax->GetPos();
+    const CPDF_StreamParser::SyntaxType type = m_pSyntax->ParseNextElement();
+    if (MayContinuePastEnd(type)) {
+      m_bNeedMoreData = true;
+      return element_start;
+    }
+    switch (type) {
       case CPDF_StreamParser::EndOfData:
         return m_pSyntax->GetPos();
       case CPDF_StreamParser::Keyword:
         OnOperator(m_pSyntax->GetWord());
+        if (m_bNeedMoreData)
+          return element_start;
         ClearAllParams();
         break;
       case CPDF_StreamParser::Number:
@@ -1556,6 +1734,22 @@ uint32_t CPDF_StreamContentParser::Parse(
   return m_pSyntax->GetPos();
 }
 
+bool CPDF_StreamContentParser::MayContinuePastEnd(
+    CPDF_StreamParser::SyntaxType type) const {
+  switch (m_DataEnd) {
+    case DataEnd::kFinal:
+      return false;
+    case DataEnd::kStreamEnd:
+      // An object may have been cut short by the end of the stream.
+      return type == CPDF_StreamParser::Others && m_pSyntax->IsAtEnd();
+    case DataEnd::kWindowEnd:
+      // Any element may have been. Inline images are checked by
+      // Handle_BeginImage(), which reads ahead to "EI".
+      return m_pSyntax->IsAtEnd();
+  }
+  return false;
+}
+
 void CPDF_StreamContentParser::ParsePathObject() {
   float params[6] = {};
   int nParams = 0;
@@ -1563,8 +1757,13 @@ void CPDF_StreamContentParser::ParsePathObject() {
   while (1) {
     CPDF_StreamParser::SyntaxType type = m_pSyntax->ParseNextElement();
     bool bProcessed = true;
+    if (type != CPDF_StreamParser::EndOfData && MayContinuePastEnd(type))
+      type = CPDF_StreamParser::EndOfData;
     switch (type) {
       case CPDF_StreamParser::EndOfData:
+        // Hand unused operands back, as the operator using them may be at the
+        // start of the next data.
+        m_pSyntax->SetPos(last_pos);
         return;
       case CPDF_StreamParser::Keyword: {
         ByteStringView strc = m_pSyntax->GetWord();
@@ -14,6 +14,8 @@
 #include <vector>
 
 #include "core/fpdfapi/page/cpdf_contentmarks.h"
+#include "core/fpdfapi/page/cpdf_path.h"
+#include "core/fpdfapi/page/cpdf_streamparser.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/fx_number.h"
 #include "core/fxcrt/fx_string.h"
@@ -36,7 +38,6 @@ class CPDF_PageObjectHolder;
 class CPDF_Pattern;
 class CPDF_ShadingPattern;
 class CPDF_Stream;
-class CPDF_StreamParser;
 class CPDF_TextObject;
 
 class CPDF_StreamContentParser {
@@ -52,10 +53,29 @@ class CPDF_StreamContentParser {
                            std::set<const uint8_t*>* pParsedSet);
   ~CPDF_StreamContentParser();
 
+  // What follows the data passed to Parse().
+  enum class DataEnd : uint8_t {
+    // Nothing: it is the end of the content.
+    kFinal,
+    // Another content stream. An object may continue in it, e.g. an array of
+    // TJ operands.
+    kStreamEnd,
+    // More of the same content stream. Any element may continue in it, and
+    // so may an inline image that does not reach its "EI" in the data.
+    kWindowEnd,
+  };
+
+  // Parses |pData|, which is all or part of content stream |stream_index|,
+  // from |start_offset| on, and returns the number of bytes parsed. Operands
+  // left over at the end of |pData| are kept for the operator at the start of
+  // the next call. An element that may continue past the end of |pData|, as
+  // told by |data_end|, is left unparsed and NeedsMoreData() returns true.
   uint32_t Parse(pdfium::span<const uint8_t> pData,
                  uint32_t start_offset,
                  uint32_t max_cost,
-                 const std::vector<uint32_t>& stream_start_offsets);
+                 int32_t stream_index,
+                 DataEnd data_end);
+  bool NeedsMoreData() const { return m_bNeedMoreData; }
   CPDF_PageObjectHolder* GetPageObjectHolder() const {
     return m_pObjectHolder.Get();
   }
@@ -84,9 +104,6 @@ class CPDF_StreamContentParser {
 
   static constexpr int kParamBufSize = 16;
 
-  using OpCodes = std::map<uint32_t, void (CPDF_StreamContentParser::*)()>;
-  static OpCodes InitializeOpCodes();
-
   void AddNameParam(ByteStringView bsName);
   void AddNumberParam(ByteStringView str);
   void AddObjectParam(RetainPtr<CPDF_Object> pObj);
@@ -114,11 +131,17 @@ class CPDF_StreamContentParser {
   float GetVerticalTextSize(float fKerning) const;
 
   void OnChangeTextMatrix();
+  // Whether the element just read may continue past the end of the data, as
+  // told by |m_DataEnd|.
+  bool MayContinuePastEnd(CPDF_StreamParser::SyntaxType type) const;
   void ParsePathObject();
   void AddPathPoint(const CFX_PointF& point, CFX_Path::Point::Type type);
   void AddPathPointAndClose(const CFX_PointF& point,
                             CFX_Path::Point::Type type);
   void AddPathRect(float x, float y, float w, float h);
+  // Returns a path holding |points| that shares its storage with an
+  // identical path built earlier by this parser, if any.
+  CPDF_Path GetSharedPath(pdfium::span<const CFX_Path::Point> points);
   void AddPathObject(CFX_FillRenderOptions::FillType fill_type,
                      RenderType render_type);
   CPDF_ImageObject* AddImage(RetainPtr<CPDF_Stream> pStream);
@@ -141,7 +164,6 @@ class CPDF_StreamContentParser {
 
   std::vector<float> GetColors() const;
   std::vector<float> GetNamedColors() const;
-  int32_t GetCurrentStreamIndex();
 
   void Handle_CloseFillStrokePath();
   void Handle_FillStrokePath();
@@ -222,6 +244,7 @@ class CPDF_StreamContentParser {
   RetainPtr<CPDF_Dictionary> const m_pResources;
   UnownedPtr<CPDF_PageObjectHolder> const m_pObjectHolder;
   UnownedPtr<std::set<const uint8_t*>> const m_ParsedSet;
+  const bool m_bTextOnly;
   CFX_Matrix m_mtContentToUser;
   const CFX_FloatRect m_BBox;
   uint32_t m_ParamStartPos = 0;
@@ -234,22 +257,25 @@ class CPDF_StreamContentParser {
   std::vector<CFX_Path::Point> m_PathPoints;
   CFX_PointF m_PathStart;
   CFX_PointF m_PathCurrent;
+  // Paths given to path objects so far, keyed by a hash of their points.
+  std::map<size_t, CPDF_Path> m_SharedPaths;
   CFX_FillRenderOptions::FillType m_PathClipType =
       CFX_FillRenderOptions::FillType::kNoFill;
   ByteString m_LastImageName;
   RetainPtr<CPDF_Image> m_pLastImage;
   bool m_bColored = false;
   bool m_bResourceMissing = false;
+  bool m_bNeedMoreData = false;
+  DataEnd m_DataEnd = DataEnd::kFinal;
+  // True while text objects would still use the text matrix inherited from
+  // the caller, i.e. until the matrix is first recomputed.
+  bool m_bTextMatrixInherited = false;
   std::vector<std::unique_ptr<CPDF_AllStates>> m_StateStack;
   float m_Type3Data[6] = {0.0f};
   ContentParam m_ParamBuf[kParamBufSize];
 
-  // The merged stream offsets at which a content stream ends and another
-  // begins.
-  std::vector<uint32_t> m_StreamStartOffsets;
-
-  // The merged stream offset at which the last |m_pSyntax| started parsing.
-  uint32_t m_StartParseOffset = 0;
+  // The content stream that |m_pSyntax| is parsing.
+  int32_t m_CurrentStreamIndex = 0;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_STREAMCONTENTPARSER_H_
@@ -242,46 +242,38 @@ CPDF_StreamParser::SyntaxType CPDF_StreamParser::ParseNextElement() {
     return Others;
   }
 
-  bool bIsNumber = true;
-  while (1) {
-    if (m_WordSize < kMaxWordLength)
-      m_WordBuffer[m_WordSize++] = ch;
-
+  // Keywords, numbers and names are left in |m_pBuf| rather than copied into
+  // |m_WordBuffer|, since nearly every token in a content stream is one.
+  const uint32_t word_start = m_Pos - 1;
+  bool bIsNumber = PDFCharIsNumeric(ch);
+  while (PositionIsInBounds()) {
+    ch = m_pBuf[m_Pos];
+    if (PDFCharIsDelimiter(ch) || PDFCharIsWhitespace(ch))
+      break;
     if (!PDFCharIsNumeric(ch))
       bIsNumber = false;
-
-    if (!PositionIsInBounds())
-      break;
-
-    ch = m_pBuf[m_Pos++];
-
-    if (PDFCharIsDelimiter(ch) || PDFCharIsWhitespace(ch)) {
-      m_Pos--;
-      break;
-    }
+    m_Pos++;
   }
-
-  m_WordBuffer[m_WordSize] = 0;
+  m_pWord = &m_pBuf[word_start];
+  m_WordSize = std::min(m_Pos - word_start, kMaxWordLength);
   if (bIsNumber)
     return Number;
 
-  if (m_WordBuffer[0] == '/')
+  if (m_pWord[0] == '/')
     return Name;
 
-  if (m_WordSize == 4) {
-    if (WordBufferMatches(kTrue)) {
-      m_pLastObj = pdfium::MakeRetain<CPDF_Boolean>(true);
-      return Others;
-    }
-    if (WordBufferMatches(kNull)) {
-      m_pLastObj = pdfium::MakeRetain<CPDF_Null>();
-      return Others;
-    }
-  } else if (m_WordSize == 5) {
-    if (WordBufferMatches(kFalse)) {
-      m_pLastObj = pdfium::MakeRetain<CPDF_Boolean>(false);
-      return Others;
-    }
+  ByteStringView word = GetWord();
+  if (word == kTrue) {
+    m_pLastObj = pdfium::MakeRetain<CPDF_Boolean>(true);
+    return Others;
+  }
+  if (word == kNull) {
+    m_pLastObj = pdfium::MakeRetain<CPDF_Null>();
+    return Others;
+  }
+  if (word == kFalse) {
+    m_pLastObj = pdfium::MakeRetain<CPDF_Boolean>(false);
+    return Others;
   }
   return Keyword;
 }
@@ -369,6 +361,7 @@ RetainPtr<CPDF_Object> CPDF_StreamParser::ReadNextObject(
 
 // TODO(npm): the following methods are almost identical in cpdf_syntaxparser
 void CPDF_StreamParser::GetNextWord(bool& bIsNumber) {
+  m_pWord = m_WordBuffer;
   m_WordSize = 0;
   bIsNumber = true;
   if (!PositionIsInBounds())
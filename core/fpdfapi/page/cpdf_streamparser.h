@@ -28,9 +28,10 @@ class CPDF_StreamParser {
 
   SyntaxType ParseNextElement();
   ByteStringView GetWord() const {
-    return ByteStringView(m_WordBuffer, m_WordSize);
+    return ByteStringView(m_pWord, m_WordSize);
   }
   uint32_t GetPos() const { return m_Pos; }
+  bool IsAtEnd() const { return !PositionIsInBounds(); }
   void SetPos(uint32_t pos) { m_Pos = pos; }
   const RetainPtr<CPDF_Object>& GetObject() const { return m_pLastObj; }
   RetainPtr<CPDF_Object> ReadNextObject(bool bAllowNestedArray,
@@ -52,6 +53,8 @@ class CPDF_StreamParser {
 
   uint32_t m_Pos = 0;       // Current byte position within |m_pBuf|.
   uint32_t m_WordSize = 0;  // Current byte position within |m_WordBuffer|.
+  // Start of the current word: either |m_WordBuffer| or a position in |m_pBuf|.
+  const uint8_t* m_pWord = m_WordBuffer;
   WeakPtr<ByteStringPool> m_pPool;
   RetainPtr<CPDF_Object> m_pLastObj;
   pdfium::span<const uint8_t> m_pBuf;
@@ -3,6 +3,8 @@
 // found in the LICENSE file.
 
 #include "core/fpdfapi/page/cpdf_streamparser.h"
+
+#include "core/fpdfapi/parser/cpdf_object.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 TEST(cpdf_streamparser, ReadHexString) {
@@ -45,3 +47,41 @@ TEST(cpdf_streamparser, ReadHexString) {
     EXPECT_EQ(1u, parser.GetPos());
   }
 }
+
+TEST(cpdf_streamparser, ParseNextElement) {
+  const char kData[] = "-1.5 2 re%comment\n/F1 true [1] BT ET";
+  CPDF_StreamParser parser(
+      pdfium::as_bytes(pdfium::make_span(kData, sizeof(kData) - 1)));
+  EXPECT_EQ(CPDF_StreamParser::Number, parser.ParseNextElement());
+  EXPECT_EQ("-1.5", parser.GetWord());
+  EXPECT_EQ(CPDF_StreamParser::Number, parser.ParseNextElement());
+  EXPECT_EQ("2", parser.GetWord());
+  EXPECT_EQ(CPDF_StreamParser::Keyword, parser.ParseNextElement());
+  EXPECT_EQ("re", parser.GetWord());
+  EXPECT_EQ(CPDF_StreamParser::Name, parser.ParseNextElement());
+  EXPECT_EQ("/F1", parser.GetWord());
+  EXPECT_EQ(CPDF_StreamParser::Others, parser.ParseNextElement());
+  ASSERT_TRUE(parser.GetObject());
+  EXPECT_TRUE(parser.GetObject()->IsBoolean());
+  EXPECT_EQ(CPDF_StreamParser::Others, parser.ParseNextElement());
+  ASSERT_TRUE(parser.GetObject());
+  EXPECT_TRUE(parser.GetObject()->IsArray());
+  EXPECT_EQ(CPDF_StreamParser::Keyword, parser.ParseNextElement());
+  EXPECT_EQ("BT", parser.GetWord());
+  EXPECT_EQ(CPDF_StreamParser::Keyword, parser.ParseNextElement());
+  EXPECT_EQ("ET", parser.GetWord());
+  EXPECT_EQ(CPDF_StreamParser::EndOfData, parser.ParseNextElement());
+  EXPECT_EQ("", parser.GetWord());
+}
+
+TEST(cpdf_streamparser, ParseNextElementLongWord) {
+  ByteString data(" ");
+  for (int i = 0; i < 300; ++i)
+    data += 'x';
+  data += " Q";
+  CPDF_StreamParser parser(data.raw_span());
+  EXPECT_EQ(CPDF_StreamParser::Keyword, parser.ParseNextElement());
+  EXPECT_EQ(255u, parser.GetWord().GetLength());
+  EXPECT_EQ(CPDF_StreamParser::Keyword, parser.ParseNextElement());
+  EXPECT_EQ("Q", parser.GetWord());
+}
@@ -320,18 +320,16 @@ CFX_PointF CPDF_TextObject::CalcPositionData(float horz_scale) {
     min_y = min_y * fontsize / 1000;
     max_y = max_y * fontsize / 1000;
   }
-  SetRect(
-      GetTextMatrix().TransformRect(CFX_FloatRect(min_x, min_y, max_x, max_y)));
-
-  if (!TextRenderingModeIsStrokeMode(m_TextState.GetTextMode()))
-    return ret;
-
-  float half_width = m_GraphState.GetLineWidth() / 2;
-  m_Rect.left -= half_width;
-  m_Rect.right += half_width;
-  m_Rect.top += half_width;
-  m_Rect.bottom -= half_width;
-
+  CFX_FloatRect rect =
+      GetTextMatrix().TransformRect(CFX_FloatRect(min_x, min_y, max_x, max_y));
+  if (TextRenderingModeIsStrokeMode(m_TextState.GetTextMode())) {
+    float half_width = m_GraphState.GetLineWidth() / 2;
+    rect.left -= half_width;
+    rect.right += half_width;
+    rect.top += half_width;
+    rect.bottom -= half_width;
+  }
+  SetRect(rect);
   return ret;
 }
 
@@ -35,6 +35,11 @@ class CPDF_TextState {
 
   void Emplace();
 
+  bool operator==(const CPDF_TextState& that) const {
+    return m_Ref == that.m_Ref;
+  }
+  bool operator!=(const CPDF_TextState& that) const { return !(*this == that); }
+
   RetainPtr<CPDF_Font> GetFont() const;
   void SetFont(const RetainPtr<CPDF_Font>& pFont);
 
@@ -19,6 +19,7 @@
 #include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_page_object_avail.h"
+#include "core/fpdfapi/parser/cpdf_range_planner.h"
 #include "core/fpdfapi/parser/cpdf_read_validator.h"
 #include "core/fpdfapi/parser/cpdf_reference.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
@@ -57,23 +58,34 @@ CPDF_Object* GetResourceObject(CPDF_Dictionary* pDict) {
   return nullptr;
 }
 
-class HintsScope {
+}  // namespace
+
+// Routes the segments requested while checking through the range planner,
+// which passes them on to |hints| as a few large reads once the check is done.
+class CPDF_DataAvail::HintsScope {
  public:
-  HintsScope(RetainPtr<CPDF_ReadValidator> validator,
-             CPDF_DataAvail::DownloadHints* hints)
-      : validator_(std::move(validator)) {
-    DCHECK(validator_);
-    validator_->SetDownloadHints(hints);
+  HintsScope(CPDF_DataAvail* avail, DownloadHints* hints)
+      : avail_(avail), hints_(hints) {
+    avail_->GetValidator()->SetDownloadHints(
+        hints_ ? avail_->m_pRangePlanner.get() : nullptr);
   }
 
-  ~HintsScope() { validator_->SetDownloadHints(nullptr); }
+  ~HintsScope() {
+    avail_->GetValidator()->SetDownloadHints(nullptr);
+    if (!hints_)
+      return;
+
+    for (const CPDF_RangePlanner::Range& range :
+         avail_->m_pRangePlanner->TakeRanges(avail_->GetCrossRefTable())) {
+      hints_->AddSegment(range.offset, range.size);
+    }
+  }
 
  private:
-  RetainPtr<CPDF_ReadValidator> validator_;
+  UnownedPtr<CPDF_DataAvail> const avail_;
+  UnownedPtr<DownloadHints> const hints_;
 };
 
-}  // namespace
-
 CPDF_DataAvail::FileAvail::~FileAvail() = default;
 
 CPDF_DataAvail::DownloadHints::~DownloadHints() = default;
@@ -83,7 +95,8 @@ CPDF_DataAvail::CPDF_DataAvail(
     const RetainPtr<IFX_SeekableReadStream>& pFileRead)
     : m_pFileRead(
           pdfium::MakeRetain<CPDF_ReadValidator>(pFileRead, pFileAvail)),
-      m_dwFileLen(m_pFileRead->GetSize()) {}
+      m_dwFileLen(m_pFileRead->GetSize()),
+      m_pRangePlanner(std::make_unique<CPDF_RangePlanner>(m_dwFileLen)) {}
 
 CPDF_DataAvail::~CPDF_DataAvail() {
   m_pHintTables.reset();
@@ -93,6 +106,7 @@ CPDF_DataAvail::~CPDF_DataAvail() {
 
 void CPDF_DataAvail::OnObservableDestroyed() {
   m_pDocument = nullptr;
+  m_pRangePlanner->InvalidateObjectPositions();
   m_pFormAvail.reset();
   m_PagesArray.clear();
   m_PagesObjAvail.clear();
@@ -106,7 +120,7 @@ CPDF_DataAvail::DocAvailStatus CPDF_DataAvail::IsDocAvail(
 
   DCHECK(m_SeenPageObjList.empty());
   AutoRestorer<std::set<uint32_t>> seen_objects_restorer(&m_SeenPageObjList);
-  const HintsScope hints_scope(GetValidator(), pHints);
+  const HintsScope hints_scope(this, pHints);
   while (!m_bDocAvail) {
     if (!CheckDocStatus())
       return kDataNotAvailable;
@@ -186,6 +200,9 @@ bool CPDF_DataAvail::CheckAndLoadAllXref() {
       return false;
     }
 
+    // The last cross-reference section usually runs up to the trailer at the
+    // end of the file, so it can be requested in one go.
+    m_pRangePlanner->AddSectionStart(last_xref_offset);
     m_pCrossRefAvail = std::make_unique<CPDF_CrossRefAvail>(GetSyntaxParser(),
                                                             last_xref_offset);
   }
@@ -222,13 +239,20 @@ RetainPtr<CPDF_Object> CPDF_DataAvail::GetObject(uint32_t objnum,
 
   CPDF_ReadValidator::ScopedSession read_session(GetValidator());
   RetainPtr<CPDF_Object> pRet = pParser->ParseIndirectObject(objnum);
-  if (!pRet)
+  if (GetValidator()->has_unavailable_data() &&
+      !GetValidator()->read_error()) {
+    // Parsing can fail just because the object is in a part of the file that
+    // has not arrived yet. Do not mistake that for a missing object, which
+    // makes callers fall back to loading the whole file.
+    *pExistInFile = true;
     return nullptr;
-
-  *pExistInFile = true;
+  }
   if (GetValidator()->has_read_problems())
     return nullptr;
+  if (!pRet)
+    return nullptr;
 
+  *pExistInFile = true;
   return pRet;
 }
 
@@ -807,7 +831,7 @@ CPDF_DataAvail::DocAvailStatus CPDF_DataAvail::IsPageAvail(
   if (pdfium::Contains(m_pagesLoadState, dwPage))
     return kDataAvailable;
 
-  const HintsScope hints_scope(GetValidator(), pHints);
+  const HintsScope hints_scope(this, pHints);
   if (m_pLinearized) {
     if (dwPage == m_pLinearized->GetFirstPageNo()) {
       auto* pPageDict = m_pDocument->GetPageDictionary(iPage);
@@ -910,6 +934,12 @@ RetainPtr<CPDF_ReadValidator> CPDF_DataAvail::GetValidator() const {
   return m_pFileRead;
 }
 
+const CPDF_CrossRefTable* CPDF_DataAvail::GetCrossRefTable() const {
+  const CPDF_Parser* pParser =
+      m_pDocument ? m_pDocument->GetParser() : &m_parser;
+  return pParser ? pParser->GetCrossRefTable() : nullptr;
+}
+
 CPDF_SyntaxParser* CPDF_DataAvail::GetSyntaxParser() const {
   return m_pDocument ? m_pDocument->GetParser()->m_pSyntax.get()
                      : m_parser.m_pSyntax.get();
@@ -954,7 +984,7 @@ CPDF_Dictionary* CPDF_DataAvail::GetPageDictionary(int index) const {
 
 CPDF_DataAvail::DocFormStatus CPDF_DataAvail::IsFormAvail(
     DownloadHints* pHints) {
-  const HintsScope hints_scope(GetValidator(), pHints);
+  const HintsScope hints_scope(this, pHints);
   return CheckAcroForm();
 }
 
@@ -1031,6 +1061,7 @@ CPDF_DataAvail::ParseDocument(
     return std::make_pair(error, nullptr);
 
   m_pDocument = document.get();
+  m_pRangePlanner->InvalidateObjectPositions();
   return std::make_pair(CPDF_Parser::SUCCESS, std::move(document));
 }
 
@@ -19,11 +19,13 @@
 #include "core/fxcrt/unowned_ptr.h"
 
 class CPDF_CrossRefAvail;
+class CPDF_CrossRefTable;
 class CPDF_Dictionary;
 class CPDF_HintTables;
 class CPDF_IndirectObjectHolder;
 class CPDF_LinearizedHeader;
 class CPDF_PageObjectAvail;
+class CPDF_RangePlanner;
 class CPDF_ReadValidator;
 class CPDF_SyntaxParser;
 
@@ -115,6 +117,8 @@ class CPDF_DataAvail final : public Observable::ObserverIface {
   const CPDF_HintTables* GetHintTables() const { return m_pHintTables.get(); }
 
  private:
+  class HintsScope;
+
   class PageNode {
    public:
     PageNode();
@@ -165,6 +169,7 @@ class CPDF_DataAvail final : public Observable::ObserverIface {
   bool IsFirstCheck(uint32_t dwPage);
   void ResetFirstCheck(uint32_t dwPage);
   bool ValidatePage(uint32_t dwPage) const;
+  const CPDF_CrossRefTable* GetCrossRefTable() const;
   CPDF_SyntaxParser* GetSyntaxParser() const;
 
   RetainPtr<CPDF_ReadValidator> m_pFileRead;
@@ -175,6 +180,7 @@ class CPDF_DataAvail final : public Observable::ObserverIface {
   std::unique_ptr<CPDF_CrossRefAvail> m_pCrossRefAvail;
   PDF_DATAAVAIL_STATUS m_docStatus = PDF_DATAAVAIL_HEADER;
   const FX_FILESIZE m_dwFileLen;
+  std::unique_ptr<CPDF_RangePlanner> const m_pRangePlanner;
   UnownedPtr<CPDF_Document> m_pDocument;
   std::vector<uint32_t> m_PageObjList;
   std::set<uint32_t> m_SeenPageObjList;
@@ -11,6 +11,7 @@
 #include "core/fpdfapi/parser/cpdf_linearized_header.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_page_tree_index.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fpdfapi/parser/cpdf_read_validator.h"
 #include "core/fpdfapi/parser/cpdf_reference.h"
@@ -251,6 +252,12 @@ void CPDF_Document::ResetTraversal() {
   m_pTreeTraversal.clear();
 }
 
+void CPDF_Document::OnPageTreeEdited() {
+  ResetTraversal();
+  if (m_pPageTreeIndex)
+    m_pPageTreeIndex->ResetNodes();
+}
+
 void CPDF_Document::SetParser(std::unique_ptr<CPDF_Parser> pParser) {
   DCHECK(!m_pParser);
   m_pParser = std::move(pParser);
@@ -305,6 +312,12 @@ void CPDF_Document::SetPageObjNum(int iPage, uint32_t objNum) {
   m_PageList[iPage] = objNum;
 }
 
+CPDF_PageTreeIndex* CPDF_Document::GetPageTreeIndex() {
+  if (!m_pPageTreeIndex)
+    m_pPageTreeIndex = std::make_unique<CPDF_PageTreeIndex>(this);
+  return m_pPageTreeIndex.get();
+}
+
 JBig2_DocumentContext* CPDF_Document::GetOrCreateCodecContext() {
   if (!m_pCodecContext)
     m_pCodecContext = std::make_unique<JBig2_DocumentContext>();
@@ -414,7 +427,7 @@ bool CPDF_Document::InsertDeletePDFPage(CPDF_Dictionary* pPages,
       }
       pPages->SetNewFor<CPDF_Number>(
           "Count", pPages->GetIntegerFor("Count") + (bInsert ? 1 : -1));
-      ResetTraversal();
+      OnPageTreeEdited();
       break;
     }
     int nPages = pKid->GetIntegerFor("Count");
@@ -453,7 +466,7 @@ bool CPDF_Document::InsertNewPage(int iPage, CPDF_Dictionary* pPageDict) {
     pPagesList->AppendNew<CPDF_Reference>(this, pPageDict->GetObjNum());
     pPages->SetNewFor<CPDF_Number>("Count", nPages + 1);
     pPageDict->SetNewFor<CPDF_Reference>("Parent", this, pPages->GetObjNum());
-    ResetTraversal();
+    OnPageTreeEdited();
   } else {
     std::set<CPDF_Dictionary*> stack = {pPages};
     if (!InsertDeletePDFPage(pPages, iPage, pPageDict, true, &stack))
@@ -17,6 +17,7 @@
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 
+class CPDF_PageTreeIndex;
 class CPDF_ReadValidator;
 class CPDF_StreamAcc;
 class IFX_SeekableReadStream;
@@ -52,6 +53,9 @@ class CPDF_Document : public Observable,
     virtual void ClearStockFont() = 0;
     virtual RetainPtr<CPDF_StreamAcc> GetFontFileStreamAcc(
         const CPDF_Stream* pFontStream) = 0;
+    // Returns a digest of the font program loaded by GetFontFileStreamAcc(),
+    // or an empty string if it is not loaded.
+    virtual ByteString GetFontFileDigest(const CPDF_Stream* pFontStream) = 0;
     virtual void MaybePurgeFontFileStreamAcc(
         const CPDF_Stream* pFontStream) = 0;
 
@@ -105,6 +109,10 @@ class CPDF_Document : public Observable,
 
   void SetPageObjNum(int iPage, uint32_t objNum);
 
+  // Created on first use. Indexing all pages with it is optional, and only
+  // makes later lookups cheaper.
+  CPDF_PageTreeIndex* GetPageTreeIndex();
+
   JBig2_DocumentContext* GetOrCreateCodecContext();
   LinkListIface* GetLinksContext() const { return m_pLinksContext.get(); }
   void SetLinksContext(std::unique_ptr<LinkListIface> pContext) {
@@ -163,6 +171,7 @@ class CPDF_Document : public Observable,
                            std::set<CPDF_Dictionary*>* pVisited);
   bool InsertNewPage(int iPage, CPDF_Dictionary* pPageDict);
   void ResetTraversal();
+  void OnPageTreeEdited();
   CPDF_Parser::Error HandleLoadResult(CPDF_Parser::Error error);
 
   std::unique_ptr<CPDF_Parser> m_pParser;
@@ -189,6 +198,7 @@ class CPDF_Document : public Observable,
   std::unique_ptr<JBig2_DocumentContext> m_pCodecContext;
   std::unique_ptr<LinkListIface> m_pLinksContext;
   std::vector<uint32_t> m_PageList;  // Page number to page's dict objnum.
+  std::unique_ptr<CPDF_PageTreeIndex> m_pPageTreeIndex;
 
   // Must be second to last.
   StockFontClearer m_StockFontClearer;
@@ -0,0 +1,129 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_page_tree_index.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "constants/page_object.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fxcrt/pauseindicator_iface.h"
+#include "third_party/base/containers/contains.h"
+#include "third_party/base/cxx17_backports.h"
+
+namespace {
+
+const char* const kAttrKeys[] = {
+    pdfium::page_object::kMediaBox,
+    pdfium::page_object::kCropBox,
+    pdfium::page_object::kRotate,
+};
+
+const CPDF_Object* FindPageAttr(const CPDF_Dictionary* pPageDict,
+                                const char* key) {
+  std::set<const CPDF_Dictionary*> visited;
+  while (pPageDict && !pdfium::Contains(visited, pPageDict)) {
+    visited.insert(pPageDict);
+    if (const CPDF_Object* pObj = pPageDict->GetDirectObjectFor(key))
+      return pObj;
+
+    pPageDict = pPageDict->GetDictFor(pdfium::page_object::kParent);
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+CPDF_PageTreeIndex::CPDF_PageTreeIndex(CPDF_Document* pDoc) : m_pDoc(pDoc) {
+  static_assert(pdfium::size(kAttrKeys) == kAttrCount, "kAttrKeys mismatch");
+}
+
+CPDF_PageTreeIndex::~CPDF_PageTreeIndex() = default;
+
+bool CPDF_PageTreeIndex::Continue(PauseIndicatorIface* pPause) {
+  // Pages may have been deleted since the last call.
+  const int page_count = m_pDoc->GetPageCount();
+  m_NextPage = std::min(m_NextPage, page_count);
+  while (m_NextPage < page_count) {
+    const CPDF_Dictionary* pPageDict =
+        m_pDoc->GetPageDictionary(m_NextPage++);
+    if (pPageDict) {
+      const CPDF_Dictionary* pParent =
+          pPageDict->GetDictFor(pdfium::page_object::kParent);
+      if (pParent && pParent != pPageDict)
+        GetNode(pParent);
+    }
+    if (pPause && m_NextPage % kPagesPerPauseCheck == 0 &&
+        m_NextPage < page_count && pPause->NeedToPauseNow()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CPDF_PageTreeIndex::IsComplete() const {
+  return m_NextPage >= m_pDoc->GetPageCount();
+}
+
+const CPDF_Object* CPDF_PageTreeIndex::GetPageAttr(
+    const CPDF_Dictionary* pPageDict,
+    Attr attr) {
+  const size_t index = static_cast<size_t>(attr);
+  if (const CPDF_Object* pObj = pPageDict->GetDirectObjectFor(kAttrKeys[index]))
+    return pObj;
+
+  const CPDF_Dictionary* pParent =
+      pPageDict->GetDictFor(pdfium::page_object::kParent);
+  if (!pParent || pParent == pPageDict)
+    return nullptr;
+
+  const Node* pNode = GetNode(pParent);
+  if (pNode)
+    return pNode->m_Attrs[index].Get();
+
+  return FindPageAttr(pPageDict, kAttrKeys[index]);
+}
+
+void CPDF_PageTreeIndex::ResetNodes() {
+  m_Nodes.clear();
+}
+
+const CPDF_PageTreeIndex::Node* CPDF_PageTreeIndex::GetNode(
+    const CPDF_Dictionary* pDict) {
+  // Collect the nodes up to the first one already resolved, from the bottom.
+  std::vector<const CPDF_Dictionary*> chain;
+  std::set<const CPDF_Dictionary*> visited;
+  const Node* pResolved = nullptr;
+  while (pDict) {
+    auto it = m_Nodes.find(pDict);
+    if (it != m_Nodes.end()) {
+      pResolved = it->second.get();
+      break;
+    }
+    if (!visited.insert(pDict).second)
+      return nullptr;
+
+    chain.push_back(pDict);
+    pDict = pDict->GetDictFor(pdfium::page_object::kParent);
+  }
+
+  // Resolve them from the top, each one inheriting from its parent.
+  for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+    auto pNode = std::make_unique<Node>();
+    pNode->m_pDict.Reset(*it);
+    for (size_t i = 0; i < kAttrCount; ++i) {
+      const CPDF_Object* pObj = (*it)->GetDirectObjectFor(kAttrKeys[i]);
+      if (pObj)
+        pNode->m_Attrs[i].Reset(pObj);
+      else if (pResolved)
+        pNode->m_Attrs[i] = pResolved->m_Attrs[i];
+    }
+    pResolved = pNode.get();
+    m_Nodes[*it] = std::move(pNode);
+  }
+  return pResolved;
+}
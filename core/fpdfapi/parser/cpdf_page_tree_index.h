@@ -0,0 +1,69 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_PAGE_TREE_INDEX_H_
+#define CORE_FPDFAPI_PARSER_CPDF_PAGE_TREE_INDEX_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <map>
+#include <memory>
+
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
+
+class CPDF_Dictionary;
+class CPDF_Document;
+class CPDF_Object;
+class PauseIndicatorIface;
+
+// Flat index over the page tree of a CPDF_Document. Resolves the page
+// dictionary of every page in one pass, so that later lookups by page index
+// are O(1), and resolves the attributes pages inherit once per /Pages node
+// instead of walking the /Parent chain for every page.
+class CPDF_PageTreeIndex {
+ public:
+  // Page attributes that can be inherited from /Pages nodes.
+  enum class Attr { kMediaBox = 0, kCropBox, kRotate };
+
+  // Pages resolved between two checks of the pause indicator.
+  static constexpr int kPagesPerPauseCheck = 64;
+
+  explicit CPDF_PageTreeIndex(CPDF_Document* pDoc);
+  ~CPDF_PageTreeIndex();
+
+  // Resolves the page dictionaries of the pages not indexed yet, in page
+  // order. Returns true once all pages are indexed, or false if |pPause|
+  // asked to stop first, in which case it can be called again to continue.
+  bool Continue(PauseIndicatorIface* pPause);
+  bool IsComplete() const;
+
+  // Returns the value of |attr| for |pPageDict|, the same way
+  // CPDF_Page::GetPageAttr() finds it: on the page itself, or else on the
+  // nearest /Parent that has it.
+  const CPDF_Object* GetPageAttr(const CPDF_Dictionary* pPageDict, Attr attr);
+
+  // Forgets the resolved attributes of all /Pages nodes. Called when the page
+  // tree is edited.
+  void ResetNodes();
+
+ private:
+  static constexpr size_t kAttrCount = 3;
+
+  struct Node {
+    RetainPtr<const CPDF_Dictionary> m_pDict;
+    std::array<RetainPtr<const CPDF_Object>, kAttrCount> m_Attrs;
+  };
+
+  // Returns the resolved attributes of the /Pages node |pDict|, or nullptr
+  // if its /Parent chain has a cycle.
+  const Node* GetNode(const CPDF_Dictionary* pDict);
+
+  UnownedPtr<CPDF_Document> const m_pDoc;
+  int m_NextPage = 0;
+  std::map<const CPDF_Dictionary*, std::unique_ptr<Node>> m_Nodes;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_PAGE_TREE_INDEX_H_
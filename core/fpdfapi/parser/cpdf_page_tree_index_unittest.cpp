@@ -0,0 +1,206 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_page_tree_index.h"
+
+#include <memory>
+#include <utility>
+
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/page/cpdf_pagemodule.h"
+#include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_reference.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
+#include "core/fxcrt/pauseindicator_iface.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+using Attr = CPDF_PageTreeIndex::Attr;
+
+constexpr int kBranchPageCount = 150;
+constexpr int kPageCount = kBranchPageCount + 2;
+
+class AlwaysPause final : public PauseIndicatorIface {
+ public:
+  bool NeedToPauseNow() override { return true; }
+};
+
+// /Pages (MediaBox, Rotate 90)
+//   page 0 (Rotate 180)
+//   /Pages (CropBox, Rotate 0)
+//     pages 1 to |kBranchPageCount|
+//   page |kBranchPageCount| + 1
+class CPDF_TestDocumentForPageTree final : public CPDF_Document {
+ public:
+  CPDF_TestDocumentForPageTree()
+      : CPDF_Document(std::make_unique<CPDF_DocRenderData>(),
+                      std::make_unique<CPDF_DocPageData>()) {
+    CPDF_Dictionary* pRoot = NewPagesNode(nullptr);
+    pRoot->SetRectFor("MediaBox", CFX_FloatRect(0, 0, 200, 300));
+    pRoot->SetNewFor<CPDF_Number>("Rotate", 90);
+    pRoot->SetNewFor<CPDF_Number>("Count", kPageCount);
+    NewPage(pRoot)->SetNewFor<CPDF_Number>("Rotate", 180);
+    CPDF_Dictionary* pBranch = NewPagesNode(pRoot);
+    pBranch->SetRectFor("CropBox", CFX_FloatRect(10, 10, 100, 100));
+    pBranch->SetNewFor<CPDF_Number>("Rotate", 0);
+    pBranch->SetNewFor<CPDF_Number>("Count", kBranchPageCount);
+    for (int i = 0; i < kBranchPageCount; ++i)
+      NewPage(pBranch);
+    NewPage(pRoot);
+
+    SetRootForTesting(NewIndirect<CPDF_Dictionary>());
+    GetRoot()->SetNewFor<CPDF_Reference>("Pages", this, pRoot->GetObjNum());
+    ResizePageListForTesting(kPageCount);
+  }
+
+ private:
+  CPDF_Dictionary* NewPagesNode(CPDF_Dictionary* pParent) {
+    CPDF_Dictionary* pNode = NewIndirect<CPDF_Dictionary>();
+    pNode->SetNewFor<CPDF_Name>("Type", "Pages");
+    pNode->SetNewFor<CPDF_Array>("Kids");
+    if (pParent)
+      AddKid(pParent, pNode);
+    return pNode;
+  }
+
+  CPDF_Dictionary* NewPage(CPDF_Dictionary* pParent) {
+    CPDF_Dictionary* pPage = NewIndirect<CPDF_Dictionary>();
+    pPage->SetNewFor<CPDF_Name>("Type", "Page");
+    AddKid(pParent, pPage);
+    return pPage;
+  }
+
+  void AddKid(CPDF_Dictionary* pParent, CPDF_Dictionary* pKid) {
+    pParent->GetArrayFor("Kids")->AppendNew<CPDF_Reference>(
+        this, pKid->GetObjNum());
+    pKid->SetNewFor<CPDF_Reference>("Parent", this, pParent->GetObjNum());
+  }
+};
+
+}  // namespace
+
+class CPDF_PageTreeIndexTest : public testing::Test {
+ public:
+  void SetUp() override { CPDF_PageModule::Create(); }
+  void TearDown() override { CPDF_PageModule::Destroy(); }
+};
+
+TEST_F(CPDF_PageTreeIndexTest, IndexAllPages) {
+  CPDF_TestDocumentForPageTree document;
+  CPDF_PageTreeIndex* pIndex = document.GetPageTreeIndex();
+  EXPECT_FALSE(pIndex->IsComplete());
+  EXPECT_FALSE(document.IsPageLoaded(kPageCount - 1));
+
+  EXPECT_TRUE(pIndex->Continue(nullptr));
+  EXPECT_TRUE(pIndex->IsComplete());
+  for (int i = 0; i < kPageCount; ++i) {
+    EXPECT_TRUE(document.IsPageLoaded(i));
+    EXPECT_TRUE(document.GetPageDictionary(i));
+  }
+}
+
+TEST_F(CPDF_PageTreeIndexTest, Pause) {
+  CPDF_TestDocumentForPageTree document;
+  CPDF_PageTreeIndex* pIndex = document.GetPageTreeIndex();
+  AlwaysPause pause;
+  int calls = 1;
+  while (!pIndex->Continue(&pause)) {
+    EXPECT_FALSE(pIndex->IsComplete());
+    ++calls;
+  }
+  EXPECT_EQ((kPageCount + CPDF_PageTreeIndex::kPagesPerPauseCheck - 1) /
+                CPDF_PageTreeIndex::kPagesPerPauseCheck,
+            calls);
+  EXPECT_TRUE(pIndex->IsComplete());
+  for (int i = 0; i < kPageCount; ++i)
+    EXPECT_TRUE(document.IsPageLoaded(i));
+
+  // Deleting pages keeps the index complete.
+  document.DeletePage(0);
+  EXPECT_TRUE(pIndex->IsComplete());
+  EXPECT_TRUE(pIndex->Continue(&pause));
+}
+
+TEST_F(CPDF_PageTreeIndexTest, InheritedAttrs) {
+  CPDF_TestDocumentForPageTree document;
+  CPDF_PageTreeIndex* pIndex = document.GetPageTreeIndex();
+
+  const CPDF_Dictionary* pFirst = document.GetPageDictionary(0);
+  ASSERT_TRUE(pFirst);
+  const CPDF_Array* pMediaBox =
+      ToArray(pIndex->GetPageAttr(pFirst, Attr::kMediaBox));
+  ASSERT_TRUE(pMediaBox);
+  EXPECT_EQ(CFX_FloatRect(0, 0, 200, 300), pMediaBox->GetRect());
+  EXPECT_FALSE(pIndex->GetPageAttr(pFirst, Attr::kCropBox));
+  ASSERT_TRUE(pIndex->GetPageAttr(pFirst, Attr::kRotate));
+  EXPECT_EQ(180, pIndex->GetPageAttr(pFirst, Attr::kRotate)->GetInteger());
+
+  for (int i = 1; i <= kBranchPageCount; ++i) {
+    const CPDF_Dictionary* pPage = document.GetPageDictionary(i);
+    ASSERT_TRUE(pPage);
+    EXPECT_EQ(pMediaBox, pIndex->GetPageAttr(pPage, Attr::kMediaBox));
+    const CPDF_Array* pCropBox =
+        ToArray(pIndex->GetPageAttr(pPage, Attr::kCropBox));
+    ASSERT_TRUE(pCropBox);
+    EXPECT_EQ(CFX_FloatRect(10, 10, 100, 100), pCropBox->GetRect());
+    ASSERT_TRUE(pIndex->GetPageAttr(pPage, Attr::kRotate));
+    EXPECT_EQ(0, pIndex->GetPageAttr(pPage, Attr::kRotate)->GetInteger());
+  }
+
+  const CPDF_Dictionary* pLast = document.GetPageDictionary(kPageCount - 1);
+  ASSERT_TRUE(pLast);
+  EXPECT_EQ(pMediaBox, pIndex->GetPageAttr(pLast, Attr::kMediaBox));
+  EXPECT_FALSE(pIndex->GetPageAttr(pLast, Attr::kCropBox));
+  ASSERT_TRUE(pIndex->GetPageAttr(pLast, Attr::kRotate));
+  EXPECT_EQ(90, pIndex->GetPageAttr(pLast, Attr::kRotate)->GetInteger());
+}
+
+TEST_F(CPDF_PageTreeIndexTest, ParentCycle) {
+  CPDF_TestDocumentForPageTree document;
+  CPDF_PageTreeIndex* pIndex = document.GetPageTreeIndex();
+
+  // /Parent of node A is node B, and /Parent of node B is node A.
+  CPDF_Dictionary* pNodeA = document.NewIndirect<CPDF_Dictionary>();
+  CPDF_Dictionary* pNodeB = document.NewIndirect<CPDF_Dictionary>();
+  pNodeA->SetNewFor<CPDF_Reference>("Parent", &document, pNodeB->GetObjNum());
+  pNodeA->SetNewFor<CPDF_Number>("Rotate", 270);
+  pNodeB->SetNewFor<CPDF_Reference>("Parent", &document, pNodeA->GetObjNum());
+  pNodeB->SetRectFor("MediaBox", CFX_FloatRect(0, 0, 50, 50));
+
+  auto pPage = pdfium::MakeRetain<CPDF_Dictionary>();
+  pPage->SetNewFor<CPDF_Reference>("Parent", &document, pNodeA->GetObjNum());
+  ASSERT_TRUE(pIndex->GetPageAttr(pPage.Get(), Attr::kRotate));
+  EXPECT_EQ(270, pIndex->GetPageAttr(pPage.Get(), Attr::kRotate)->GetInteger());
+  EXPECT_TRUE(pIndex->GetPageAttr(pPage.Get(), Attr::kMediaBox));
+  EXPECT_FALSE(pIndex->GetPageAttr(pPage.Get(), Attr::kCropBox));
+}
+
+TEST_F(CPDF_PageTreeIndexTest, ResetOnPageTreeEdits) {
+  CPDF_TestDocumentForPageTree document;
+  CPDF_PageTreeIndex* pIndex = document.GetPageTreeIndex();
+
+  const CPDF_Dictionary* pLast = document.GetPageDictionary(kPageCount - 1);
+  ASSERT_TRUE(pLast);
+  ASSERT_TRUE(pIndex->GetPageAttr(pLast, Attr::kRotate));
+  EXPECT_EQ(90, pIndex->GetPageAttr(pLast, Attr::kRotate)->GetInteger());
+
+  // Inserting or deleting pages resolves the /Pages nodes again.
+  CPDF_Dictionary* pRoot = document.GetRoot()->GetDictFor("Pages");
+  pRoot->SetNewFor<CPDF_Number>("Rotate", 270);
+  ASSERT_TRUE(document.CreateNewPage(kPageCount));
+  EXPECT_EQ(270, pIndex->GetPageAttr(pLast, Attr::kRotate)->GetInteger());
+
+  pRoot->SetNewFor<CPDF_Number>("Rotate", 0);
+  document.DeletePage(kPageCount);
+  EXPECT_EQ(0, pIndex->GetPageAttr(pLast, Attr::kRotate)->GetInteger());
+
+  pRoot->SetNewFor<CPDF_Number>("Rotate", 180);
+  ASSERT_TRUE(document.CreateNewPage(1));
+  EXPECT_EQ(180, pIndex->GetPageAttr(pLast, Attr::kRotate)->GetInteger());
+}
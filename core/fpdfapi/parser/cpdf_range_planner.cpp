@@ -0,0 +1,138 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_range_planner.h"
+
+#include <algorithm>
+
+#include "core/fpdfapi/parser/cpdf_cross_ref_table.h"
+#include "core/fxcrt/fx_safe_types.h"
+
+namespace {
+
+struct Span {
+  FX_FILESIZE begin;
+  FX_FILESIZE end;
+};
+
+}  // namespace
+
+CPDF_RangePlanner::CPDF_RangePlanner(FX_FILESIZE file_size)
+    : m_FileSize(file_size) {}
+
+CPDF_RangePlanner::~CPDF_RangePlanner() = default;
+
+void CPDF_RangePlanner::InvalidateObjectPositions() {
+  m_bSectionStartsDirty = true;
+}
+
+void CPDF_RangePlanner::AddSectionStart(FX_FILESIZE offset) {
+  if (offset <= 0 || offset >= m_FileSize)
+    return;
+
+  m_ExtraStarts.push_back(offset);
+  m_bSectionStartsDirty = true;
+}
+
+void CPDF_RangePlanner::AddSegment(FX_FILESIZE offset, size_t size) {
+  if (offset < 0 || offset >= m_FileSize || size == 0)
+    return;
+
+  m_Segments.push_back({offset, size});
+}
+
+std::vector<CPDF_RangePlanner::Range> CPDF_RangePlanner::TakeRanges(
+    const CPDF_CrossRefTable* pTable) {
+  std::vector<Range> ranges;
+  if (m_Segments.empty())
+    return ranges;
+
+  UpdateSectionStarts(pTable);
+  std::vector<Span> spans;
+  spans.reserve(m_Segments.size());
+  for (const Range& segment : m_Segments) {
+    FX_SAFE_FILESIZE safe_end = segment.offset;
+    safe_end += segment.size;
+    Span span = {segment.offset,
+                 std::min<FX_FILESIZE>(safe_end.ValueOrDefault(m_FileSize),
+                                       m_FileSize)};
+    // The validator aligns segments to its buffer size, so a segment for the
+    // start of a section can begin in the unknown part before it.
+    const size_t first = FindSection(span.begin);
+    if (first < m_SectionStarts.size() &&
+        span.begin - m_SectionStarts[first] <= kMaxObjectSize) {
+      span.begin = m_SectionStarts[first];
+    }
+    const size_t last = FindSection(span.end - 1);
+    if (last < m_SectionStarts.size() &&
+        GetSectionEnd(last) - span.end <= kMaxObjectSize) {
+      span.end = std::max(span.end, GetSectionEnd(last));
+      const FX_FILESIZE read_ahead_end = span.end + kReadAheadSize;
+      for (size_t next = last + 1; next < m_SectionStarts.size(); ++next) {
+        const FX_FILESIZE next_end = GetSectionEnd(next);
+        if (next_end > read_ahead_end)
+          break;
+        span.end = next_end;
+      }
+    }
+    spans.push_back(span);
+  }
+  m_Segments.clear();
+
+  std::sort(spans.begin(), spans.end(), [](const Span& a, const Span& b) {
+    return a.begin < b.begin;
+  });
+  Span current = spans.front();
+  for (size_t i = 1; i < spans.size(); ++i) {
+    if (spans[i].begin <= current.end + kMaxGapSize) {
+      current.end = std::max(current.end, spans[i].end);
+      continue;
+    }
+    ranges.push_back(
+        {current.begin, static_cast<size_t>(current.end - current.begin)});
+    current = spans[i];
+  }
+  ranges.push_back(
+      {current.begin, static_cast<size_t>(current.end - current.begin)});
+  return ranges;
+}
+
+void CPDF_RangePlanner::UpdateSectionStarts(
+    const CPDF_CrossRefTable* pTable) {
+  const size_t object_count = pTable ? pTable->objects_info().size() : 0;
+  if (!m_bSectionStartsDirty && object_count == m_IndexedObjectCount)
+    return;
+
+  m_SectionStarts = m_ExtraStarts;
+  if (pTable) {
+    for (const auto& it : pTable->objects_info()) {
+      const CPDF_CrossRefTable::ObjectInfo& info = it.second;
+      if (info.type != CPDF_CrossRefTable::ObjectType::kNormal &&
+          info.type != CPDF_CrossRefTable::ObjectType::kObjStream) {
+        continue;
+      }
+      if (info.pos > 0 && info.pos < m_FileSize)
+        m_SectionStarts.push_back(info.pos);
+    }
+  }
+  std::sort(m_SectionStarts.begin(), m_SectionStarts.end());
+  m_SectionStarts.erase(
+      std::unique(m_SectionStarts.begin(), m_SectionStarts.end()),
+      m_SectionStarts.end());
+  m_IndexedObjectCount = object_count;
+  m_bSectionStartsDirty = false;
+}
+
+size_t CPDF_RangePlanner::FindSection(FX_FILESIZE offset) const {
+  auto it = std::upper_bound(m_SectionStarts.begin(), m_SectionStarts.end(),
+                             offset);
+  if (it == m_SectionStarts.begin())
+    return m_SectionStarts.size();
+  return it - m_SectionStarts.begin() - 1;
+}
+
+FX_FILESIZE CPDF_RangePlanner::GetSectionEnd(size_t index) const {
+  return index + 1 < m_SectionStarts.size() ? m_SectionStarts[index + 1]
+                                            : m_FileSize;
+}
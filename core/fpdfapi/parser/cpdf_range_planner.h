@@ -0,0 +1,73 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_RANGE_PLANNER_H_
+#define CORE_FPDFAPI_PARSER_CPDF_RANGE_PLANNER_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_data_avail.h"
+#include "core/fxcrt/fx_types.h"
+
+class CPDF_CrossRefTable;
+
+// Collects the data a CPDF_DataAvail check found missing and turns it into a
+// few large reads, so that a file served over a network takes one round trip
+// per level of the object graph instead of one per object or per buffer.
+//
+// A request that falls inside an object whose file position is known grows
+// to cover the whole object, followed by any small objects right after it,
+// which tend to be the ones it refers to. Requests closer to each other than
+// |kMaxGapSize| are merged.
+class CPDF_RangePlanner final : public CPDF_DataAvail::DownloadHints {
+ public:
+  struct Range {
+    FX_FILESIZE offset;
+    size_t size;
+  };
+
+  // Requests are only grown to objects no larger than this.
+  static constexpr FX_FILESIZE kMaxObjectSize = 1024 * 1024;
+  static constexpr FX_FILESIZE kReadAheadSize = 32 * 1024;
+  static constexpr FX_FILESIZE kMaxGapSize = 16 * 1024;
+
+  explicit CPDF_RangePlanner(FX_FILESIZE file_size);
+  ~CPDF_RangePlanner() override;
+
+  // Call when the cross-reference table passed to TakeRanges() is replaced by
+  // another one, so that its object positions are read again.
+  void InvalidateObjectPositions();
+
+  // Records that a section, e.g. a cross-reference table, starts at |offset|.
+  void AddSectionStart(FX_FILESIZE offset);
+
+  // CPDF_DataAvail::DownloadHints:
+  void AddSegment(FX_FILESIZE offset, size_t size) override;
+
+  // Returns the planned reads for the segments added so far, sorted by
+  // offset and not overlapping, and forgets the segments. Object positions
+  // are taken from |pTable|, which may be null, whenever its object count has
+  // changed since the last call.
+  std::vector<Range> TakeRanges(const CPDF_CrossRefTable* pTable);
+
+ private:
+  void UpdateSectionStarts(const CPDF_CrossRefTable* pTable);
+
+  // Index into |m_SectionStarts| of the section containing |offset|, or
+  // |m_SectionStarts.size()| if |offset| is before the first section.
+  size_t FindSection(FX_FILESIZE offset) const;
+  FX_FILESIZE GetSectionEnd(size_t index) const;
+
+  const FX_FILESIZE m_FileSize;
+  size_t m_IndexedObjectCount = 0;
+  std::vector<FX_FILESIZE> m_ExtraStarts;
+  // Sorted and unique.
+  std::vector<FX_FILESIZE> m_SectionStarts;
+  bool m_bSectionStartsDirty = false;
+  std::vector<Range> m_Segments;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_RANGE_PLANNER_H_
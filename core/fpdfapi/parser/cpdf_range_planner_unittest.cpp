@@ -0,0 +1,143 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_range_planner.h"
+
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_cross_ref_table.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr FX_FILESIZE kFileSize = 1024 * 1024;
+
+}  // namespace
+
+TEST(CPDF_RangePlannerTest, Empty) {
+  CPDF_RangePlanner planner(kFileSize);
+  EXPECT_TRUE(planner.TakeRanges(nullptr).empty());
+
+  // Out of range segments are dropped.
+  planner.AddSegment(-1, 10);
+  planner.AddSegment(kFileSize, 10);
+  planner.AddSegment(100, 0);
+  EXPECT_TRUE(planner.TakeRanges(nullptr).empty());
+}
+
+TEST(CPDF_RangePlannerTest, MergeNearbySegments) {
+  CPDF_RangePlanner planner(kFileSize);
+  planner.AddSegment(200000, 512);
+  planner.AddSegment(1024, 512);
+  planner.AddSegment(0, 512);
+  planner.AddSegment(1536 + CPDF_RangePlanner::kMaxGapSize, 512);
+  planner.AddSegment(kFileSize - 100, 1000);
+
+  std::vector<CPDF_RangePlanner::Range> ranges = planner.TakeRanges(nullptr);
+  ASSERT_EQ(3u, ranges.size());
+  EXPECT_EQ(0, ranges[0].offset);
+  EXPECT_EQ(static_cast<size_t>(CPDF_RangePlanner::kMaxGapSize + 2048),
+            ranges[0].size);
+  EXPECT_EQ(200000, ranges[1].offset);
+  EXPECT_EQ(512u, ranges[1].size);
+  EXPECT_EQ(kFileSize - 100, ranges[2].offset);
+  EXPECT_EQ(100u, ranges[2].size);
+
+  // Segments are forgotten once taken.
+  EXPECT_TRUE(planner.TakeRanges(nullptr).empty());
+}
+
+TEST(CPDF_RangePlannerTest, GrowToSections) {
+  CPDF_RangePlanner planner(kFileSize);
+  planner.AddSectionStart(100000);
+  planner.AddSectionStart(150000);
+  planner.AddSectionStart(160000);
+  planner.AddSectionStart(190000);
+  planner.AddSectionStart(500000);
+
+  // Before the first section: left alone.
+  planner.AddSegment(1000, 512);
+  // Inside the section at 100000: grown to all of it, then over the section
+  // at 150000 that ends within the read ahead, but not over the one at 160000
+  // that ends past it.
+  planner.AddSegment(120000, 512);
+  // Inside the last section: grown to the end of the file.
+  planner.AddSegment(900000, 512);
+
+  std::vector<CPDF_RangePlanner::Range> ranges = planner.TakeRanges(nullptr);
+  ASSERT_EQ(3u, ranges.size());
+  EXPECT_EQ(1000, ranges[0].offset);
+  EXPECT_EQ(512u, ranges[0].size);
+  EXPECT_EQ(100000, ranges[1].offset);
+  EXPECT_EQ(60000u, ranges[1].size);
+  EXPECT_EQ(500000, ranges[2].offset);
+  EXPECT_EQ(static_cast<size_t>(kFileSize - 500000), ranges[2].size);
+}
+
+TEST(CPDF_RangePlannerTest, DoNotGrowToHugeSections) {
+  CPDF_RangePlanner planner(4 * kFileSize);
+  planner.AddSectionStart(1000);
+  planner.AddSectionStart(3 * kFileSize);
+
+  // Only grown towards a section boundary that is close enough.
+  planner.AddSegment(kFileSize * 3 / 2, 512);
+  planner.AddSegment(1500, 512);
+
+  std::vector<CPDF_RangePlanner::Range> ranges = planner.TakeRanges(nullptr);
+  ASSERT_EQ(2u, ranges.size());
+  EXPECT_EQ(1000, ranges[0].offset);
+  EXPECT_EQ(1012u, ranges[0].size);
+  EXPECT_EQ(kFileSize * 3 / 2, ranges[1].offset);
+  EXPECT_EQ(512u, ranges[1].size);
+}
+
+TEST(CPDF_RangePlannerTest, GrowIntoSection) {
+  CPDF_RangePlanner planner(kFileSize);
+  planner.AddSectionStart(100100);
+  planner.AddSectionStart(101000);
+  planner.AddSectionStart(300000);
+
+  // Starts before the first section, but ends inside it.
+  planner.AddSegment(99840, 512);
+
+  std::vector<CPDF_RangePlanner::Range> ranges = planner.TakeRanges(nullptr);
+  ASSERT_EQ(1u, ranges.size());
+  EXPECT_EQ(99840, ranges[0].offset);
+  EXPECT_EQ(1160u, ranges[0].size);
+}
+
+TEST(CPDF_RangePlannerTest, GrowToObjects) {
+  CPDF_RangePlanner planner(kFileSize);
+  CPDF_CrossRefTable table;
+  table.AddNormal(1, 0, 100000);
+  table.AddNormal(2, 0, 400000);
+  table.AddCompressed(3, 2);
+
+  planner.AddSegment(100200, 512);
+  std::vector<CPDF_RangePlanner::Range> ranges = planner.TakeRanges(&table);
+  ASSERT_EQ(1u, ranges.size());
+  EXPECT_EQ(100000, ranges[0].offset);
+  EXPECT_EQ(300000u, ranges[0].size);
+
+  // Positions are read again once the table has more objects.
+  table.AddNormal(4, 0, 200000);
+  planner.AddSegment(100200, 512);
+  ranges = planner.TakeRanges(&table);
+  ASSERT_EQ(1u, ranges.size());
+  EXPECT_EQ(100000, ranges[0].offset);
+  EXPECT_EQ(100000u, ranges[0].size);
+
+  // Or when told that the table was replaced.
+  CPDF_CrossRefTable other_table;
+  other_table.AddNormal(1, 0, 100000);
+  other_table.AddNormal(2, 0, 150000);
+  other_table.AddNormal(3, 0, 300000);
+  other_table.AddNormal(4, 0, 700000);
+  planner.InvalidateObjectPositions();
+  planner.AddSegment(100200, 512);
+  ranges = planner.TakeRanges(&other_table);
+  ASSERT_EQ(1u, ranges.size());
+  EXPECT_EQ(100000, ranges[0].offset);
+  EXPECT_EQ(50000u, ranges[0].size);
+}
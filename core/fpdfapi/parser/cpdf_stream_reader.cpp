@@ -0,0 +1,137 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_stream_reader.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
+#include "core/fpdfapi/parser/fpdf_parser_decode.h"
+#include "core/fxcodec/flate/flatemodule.h"
+#include "core/fxcrt/span_util.h"
+
+namespace {
+
+bool IsFlateDecoder(const ByteString& decoder) {
+  return decoder == "FlateDecode" || decoder == "Fl";
+}
+
+}  // namespace
+
+CPDF_StreamReader::CPDF_StreamReader(RetainPtr<const CPDF_Stream> pStream)
+    : m_pStream(std::move(pStream)) {
+  if (!m_pStream || !m_pStream->HasFilter())
+    return;
+
+  // Mirror CPDF_StreamAcc: an invalid filter chain yields the raw data, and
+  // Crypt filters are no-ops because decryption already happened on load.
+  Optional<DecoderArray> decoder_array =
+      GetDecoderArray(m_pStream->GetDict());
+  if (!decoder_array.has_value())
+    return;
+
+  DecoderArray decoders;
+  for (auto& decoder : decoder_array.value()) {
+    if (decoder.first != "Crypt")
+      decoders.push_back(std::move(decoder));
+  }
+  if (decoders.empty())
+    return;
+
+  // Predictors and the other filters are left to the whole-buffer decoders.
+  if (decoders.size() == 1 && IsFlateDecoder(decoders[0].first) &&
+      !decoders[0].second) {
+    m_Mode = Mode::kFlate;
+    m_pFlateDecoder = std::make_unique<fxcodec::FlateStreamDecoder>();
+    return;
+  }
+  m_Mode = Mode::kWholeBuffer;
+}
+
+CPDF_StreamReader::~CPDF_StreamReader() = default;
+
+size_t CPDF_StreamReader::Read(pdfium::span<uint8_t> buffer) {
+  if (!m_pStream || buffer.empty())
+    return 0;
+
+  switch (m_Mode) {
+    case Mode::kRaw:
+      return ReadRaw(buffer);
+    case Mode::kFlate:
+      return ReadFlate(buffer);
+    case Mode::kWholeBuffer:
+      return ReadWholeBuffer(buffer);
+  }
+  return 0;
+}
+
+pdfium::span<const uint8_t> CPDF_StreamReader::ReadRawChunk() {
+  const uint32_t raw_size = m_pStream->GetRawSize();
+  if (m_RawOffset >= raw_size)
+    return {};
+
+  if (m_pStream->IsMemoryBased()) {
+    m_RawOffset = raw_size;
+    return {m_pStream->GetInMemoryRawData(), raw_size};
+  }
+
+  const uint32_t chunk_size = std::min(kRawChunkSize, raw_size - m_RawOffset);
+  m_RawChunk.resize(chunk_size);
+  if (!m_pStream->ReadRawData(m_RawOffset, m_RawChunk.data(), chunk_size)) {
+    m_RawOffset = raw_size;
+    return {};
+  }
+  m_RawOffset += chunk_size;
+  return m_RawChunk;
+}
+
+size_t CPDF_StreamReader::ReadRaw(pdfium::span<uint8_t> buffer) {
+  size_t written = 0;
+  while (written < buffer.size()) {
+    if (m_RawSpan.empty()) {
+      m_RawSpan = ReadRawChunk();
+      if (m_RawSpan.empty())
+        break;
+    }
+    size_t copy_size = std::min(m_RawSpan.size(), buffer.size() - written);
+    fxcrt::spancpy(buffer.subspan(written), m_RawSpan.first(copy_size));
+    m_RawSpan = m_RawSpan.subspan(copy_size);
+    written += copy_size;
+  }
+  return written;
+}
+
+size_t CPDF_StreamReader::ReadFlate(pdfium::span<uint8_t> buffer) {
+  size_t written = 0;
+  while (written < buffer.size() && !m_pFlateDecoder->IsDone()) {
+    size_t decoded = m_pFlateDecoder->Decode(buffer.subspan(written));
+    written += decoded;
+    if (decoded)
+      continue;
+    if (!m_pFlateDecoder->NeedsInput())
+      break;
+
+    pdfium::span<const uint8_t> chunk = ReadRawChunk();
+    if (chunk.empty())
+      break;
+    m_pFlateDecoder->SetInput(chunk);
+  }
+  return written;
+}
+
+size_t CPDF_StreamReader::ReadWholeBuffer(pdfium::span<uint8_t> buffer) {
+  if (!m_pWholeBufferAcc) {
+    m_pWholeBufferAcc = pdfium::MakeRetain<CPDF_StreamAcc>(m_pStream.Get());
+    m_pWholeBufferAcc->LoadAllDataFiltered();
+  }
+  pdfium::span<const uint8_t> data =
+      m_pWholeBufferAcc->GetSpan().subspan(m_WholeBufferOffset);
+  size_t copy_size = std::min(data.size(), buffer.size());
+  fxcrt::spancpy(buffer, data.first(copy_size));
+  m_WholeBufferOffset += copy_size;
+  return copy_size;
+}
@@ -0,0 +1,67 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_STREAM_READER_H_
+#define CORE_FPDFAPI_PARSER_CPDF_STREAM_READER_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/fxcrt/fx_memory_wrappers.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "third_party/base/span.h"
+
+class CPDF_Stream;
+class CPDF_StreamAcc;
+
+namespace fxcodec {
+class FlateStreamDecoder;
+}
+
+// Sequential, pull-based access to the decoded contents of a stream. Unlike
+// CPDF_StreamAcc, which decodes the whole stream before returning anything,
+// this reads the raw data in windows of kRawChunkSize bytes and decodes it
+// as the caller asks for more, so peak memory does not depend on the stream
+// size. Unfiltered and FlateDecode streams are handled incrementally. Other
+// filter chains fall back to decoding the whole stream with CPDF_StreamAcc on
+// the first Read(); the bytes returned are the same either way.
+class CPDF_StreamReader {
+ public:
+  static constexpr uint32_t kRawChunkSize = 64 * 1024;
+
+  explicit CPDF_StreamReader(RetainPtr<const CPDF_Stream> pStream);
+  CPDF_StreamReader(const CPDF_StreamReader&) = delete;
+  CPDF_StreamReader& operator=(const CPDF_StreamReader&) = delete;
+  ~CPDF_StreamReader();
+
+  // Fills |buffer| with the next decoded bytes and returns the number of bytes
+  // written. Returns less than |buffer|.size() only at the end of the data.
+  size_t Read(pdfium::span<uint8_t> buffer);
+
+  bool IsIncremental() const { return m_Mode != Mode::kWholeBuffer; }
+
+ private:
+  enum class Mode { kRaw, kFlate, kWholeBuffer };
+
+  // Returns the next window of raw stream data, or an empty span at the end
+  // of the data or on a read error.
+  pdfium::span<const uint8_t> ReadRawChunk();
+
+  size_t ReadRaw(pdfium::span<uint8_t> buffer);
+  size_t ReadFlate(pdfium::span<uint8_t> buffer);
+  size_t ReadWholeBuffer(pdfium::span<uint8_t> buffer);
+
+  RetainPtr<const CPDF_Stream> const m_pStream;
+  Mode m_Mode = Mode::kRaw;
+  uint32_t m_RawOffset = 0;
+  pdfium::span<const uint8_t> m_RawSpan;
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> m_RawChunk;
+  std::unique_ptr<fxcodec::FlateStreamDecoder> m_pFlateDecoder;
+  RetainPtr<CPDF_StreamAcc> m_pWholeBufferAcc;
+  uint32_t m_WholeBufferOffset = 0;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_STREAM_READER_H_
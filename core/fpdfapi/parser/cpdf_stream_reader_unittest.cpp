@@ -0,0 +1,164 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_stream_reader.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
+#include "core/fxcodec/flate/flatemodule.h"
+#include "core/fxcrt/cfx_readonlymemorystream.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/invalid_seekable_read_stream.h"
+
+namespace {
+
+std::vector<uint8_t> MakeTestData(size_t size) {
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i)
+    data[i] = static_cast<uint8_t>((i * 7) ^ (i >> 9));
+  return data;
+}
+
+// Drains |reader| using reads of |read_size| bytes.
+std::vector<uint8_t> ReadAll(CPDF_StreamReader* reader, size_t read_size) {
+  std::vector<uint8_t> result;
+  std::vector<uint8_t> buffer(read_size);
+  while (size_t read = reader->Read(buffer)) {
+    result.insert(result.end(), buffer.begin(), buffer.begin() + read);
+    if (read < read_size)
+      break;
+  }
+  return result;
+}
+
+std::vector<uint8_t> ReadAllWithStreamAcc(const CPDF_Stream* stream) {
+  auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(stream);
+  stream_acc->LoadAllDataFiltered();
+  pdfium::span<const uint8_t> span = stream_acc->GetSpan();
+  return std::vector<uint8_t>(span.begin(), span.end());
+}
+
+RetainPtr<CPDF_Stream> MakeFlateStream(pdfium::span<const uint8_t> data) {
+  std::unique_ptr<uint8_t, FxFreeDeleter> encoded;
+  uint32_t encoded_size = 0;
+  EXPECT_TRUE(
+      FlateModule::Encode(data.data(), data.size(), &encoded, &encoded_size));
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Name>("Filter", "FlateDecode");
+  return pdfium::MakeRetain<CPDF_Stream>(std::move(encoded), encoded_size,
+                                         std::move(dict));
+}
+
+}  // namespace
+
+TEST(CPDF_StreamReaderTest, NullStream) {
+  CPDF_StreamReader reader(nullptr);
+  uint8_t buffer[16];
+  EXPECT_EQ(0u, reader.Read(buffer));
+}
+
+TEST(CPDF_StreamReaderTest, UnfilteredMemoryStream) {
+  const std::vector<uint8_t> data = MakeTestData(1000);
+  auto stream = pdfium::MakeRetain<CPDF_Stream>();
+  stream->SetData(data);
+
+  CPDF_StreamReader reader(stream);
+  EXPECT_TRUE(reader.IsIncremental());
+  EXPECT_EQ(data, ReadAll(&reader, 33));
+}
+
+TEST(CPDF_StreamReaderTest, UnfilteredFileStream) {
+  // Spans several raw chunks.
+  const std::vector<uint8_t> data =
+      MakeTestData(3 * CPDF_StreamReader::kRawChunkSize + 17);
+  auto stream = pdfium::MakeRetain<CPDF_Stream>();
+  stream->InitStreamFromFile(pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(data),
+                             pdfium::MakeRetain<CPDF_Dictionary>());
+
+  CPDF_StreamReader reader(stream);
+  EXPECT_TRUE(reader.IsIncremental());
+  EXPECT_EQ(data, ReadAll(&reader, 5000));
+}
+
+TEST(CPDF_StreamReaderTest, ReadRawDataFailed) {
+  auto stream = pdfium::MakeRetain<CPDF_Stream>();
+  stream->InitStreamFromFile(
+      pdfium::MakeRetain<InvalidSeekableReadStream>(1024),
+      pdfium::MakeRetain<CPDF_Dictionary>());
+
+  CPDF_StreamReader reader(stream);
+  uint8_t buffer[16];
+  EXPECT_EQ(0u, reader.Read(buffer));
+}
+
+TEST(CPDF_StreamReaderTest, FlateMemoryStream) {
+  const std::vector<uint8_t> data = MakeTestData(200000);
+  RetainPtr<CPDF_Stream> stream = MakeFlateStream(data);
+
+  CPDF_StreamReader reader(stream);
+  EXPECT_TRUE(reader.IsIncremental());
+  EXPECT_EQ(data, ReadAll(&reader, 4096));
+}
+
+TEST(CPDF_StreamReaderTest, FlateFileStream) {
+  const std::vector<uint8_t> data =
+      MakeTestData(4 * CPDF_StreamReader::kRawChunkSize);
+  RetainPtr<CPDF_Stream> memory_stream = MakeFlateStream(data);
+  auto stream = pdfium::MakeRetain<CPDF_Stream>();
+  stream->InitStreamFromFile(
+      pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(pdfium::make_span(
+          memory_stream->GetInMemoryRawData(), memory_stream->GetRawSize())),
+      ToDictionary(memory_stream->GetDict()->Clone()));
+
+  CPDF_StreamReader reader(stream);
+  EXPECT_TRUE(reader.IsIncremental());
+  EXPECT_EQ(data, ReadAll(&reader, 1000));
+}
+
+TEST(CPDF_StreamReaderTest, FlateOutputPendingAfterInput) {
+  // Without the checksum at the end, inflate() consumes the last input byte
+  // while most of the output for the final match is still to be written.
+  const std::vector<uint8_t> data(1165, 'x');
+  RetainPtr<CPDF_Stream> full_stream = MakeFlateStream(data);
+  auto stream = pdfium::MakeRetain<CPDF_Stream>();
+  stream->InitStream(pdfium::make_span(full_stream->GetInMemoryRawData(),
+                                       full_stream->GetRawSize() - 4),
+                     ToDictionary(full_stream->GetDict()->Clone()));
+
+  CPDF_StreamReader reader(stream);
+  EXPECT_EQ(data, ReadAll(&reader, 100));
+}
+
+TEST(CPDF_StreamReaderTest, TruncatedFlateStream) {
+  const std::vector<uint8_t> data = MakeTestData(50000);
+  RetainPtr<CPDF_Stream> full_stream = MakeFlateStream(data);
+  auto stream = pdfium::MakeRetain<CPDF_Stream>();
+  stream->InitStream(pdfium::make_span(full_stream->GetInMemoryRawData(),
+                                       full_stream->GetRawSize() / 2),
+                     ToDictionary(full_stream->GetDict()->Clone()));
+
+  CPDF_StreamReader reader(stream);
+  EXPECT_EQ(ReadAllWithStreamAcc(stream.Get()), ReadAll(&reader, 1000));
+}
+
+TEST(CPDF_StreamReaderTest, NonIncrementalFilter) {
+  static const char kHexData[] = "48656C6C6F2C20776F726C6421>";
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Name>("Filter", "ASCIIHexDecode");
+  auto stream = pdfium::MakeRetain<CPDF_Stream>();
+  stream->InitStream(
+      pdfium::as_bytes(pdfium::make_span(kHexData, sizeof(kHexData) - 1)),
+      std::move(dict));
+
+  CPDF_StreamReader reader(stream);
+  EXPECT_FALSE(reader.IsIncremental());
+  std::vector<uint8_t> result = ReadAll(&reader, 5);
+  EXPECT_EQ("Hello, world!", ByteString(result.data(), result.size()));
+}
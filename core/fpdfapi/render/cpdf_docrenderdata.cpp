@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <array>
 #include <memory>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -19,13 +20,38 @@
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/render/cpdf_type3cache.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
 
 namespace {
 
 const int kMaxOutputs = 16;
 
+auto MatrixTie(const CFX_Matrix& m) {
+  return std::tie(m.a, m.b, m.c, m.d, m.e, m.f);
+}
+
+size_t GetBitmapBytes(const RetainPtr<CFX_DIBitmap>& pBitmap) {
+  return static_cast<size_t>(pBitmap->GetPitch()) * pBitmap->GetHeight();
+}
+
 }  // namespace
 
+bool CPDF_DocRenderData::PatternCellKey::operator<(
+    const PatternCellKey& other) const {
+  if (pattern_obj != other.pattern_obj)
+    return pattern_obj < other.pattern_obj;
+  if (MatrixTie(pattern_to_form) != MatrixTie(other.pattern_to_form))
+    return MatrixTie(pattern_to_form) < MatrixTie(other.pattern_to_form);
+  if (MatrixTie(parent_matrix) != MatrixTie(other.parent_matrix))
+    return MatrixTie(parent_matrix) < MatrixTie(other.parent_matrix);
+  if (MatrixTie(object_to_device) != MatrixTie(other.object_to_device))
+    return MatrixTie(object_to_device) < MatrixTie(other.object_to_device);
+  return std::tie(width, height, options, fill_alpha, stroke_alpha,
+                  blend_type) < std::tie(other.width, other.height,
+                                         other.options, other.fill_alpha,
+                                         other.stroke_alpha, other.blend_type);
+}
+
 // static
 CPDF_DocRenderData* CPDF_DocRenderData::FromDocument(
     const CPDF_Document* pDoc) {
@@ -39,12 +65,47 @@ CPDF_DocRenderData::~CPDF_DocRenderData() = default;
 RetainPtr<CPDF_Type3Cache> CPDF_DocRenderData::GetCachedType3(
     CPDF_Type3Font* pFont) {
   auto it = m_Type3FaceMap.find(pFont);
-  if (it != m_Type3FaceMap.end() && it->second)
-    return pdfium::WrapRetain(it->second.Get());
+  if (it != m_Type3FaceMap.end() && it->second.cache->GetFont() == pFont) {
+    m_Type3CacheLru.splice(m_Type3CacheLru.begin(), m_Type3CacheLru,
+                           it->second.lru_it);
+  } else {
+    // A new font may be reusing the address of a destroyed one, so take the
+    // chance to drop every cache whose font is gone.
+    for (auto dead = m_Type3FaceMap.begin(); dead != m_Type3FaceMap.end();) {
+      if (dead->second.cache->GetFont()) {
+        ++dead;
+      } else {
+        m_Type3CacheLru.erase(dead->second.lru_it);
+        dead = m_Type3FaceMap.erase(dead);
+      }
+    }
+    m_Type3CacheLru.push_front(pFont);
+    m_Type3FaceMap[pFont] = {pdfium::MakeRetain<CPDF_Type3Cache>(pFont),
+                             m_Type3CacheLru.begin()};
+  }
+  TrimType3Caches();
+  return m_Type3FaceMap[pFont].cache;
+}
+
+void CPDF_DocRenderData::TrimType3Caches() {
+  size_t total_bytes = 0;
+  for (const auto& entry : m_Type3FaceMap)
+    total_bytes += entry.second.cache->GetGlyphBytes();
+
+  for (auto it = m_Type3CacheLru.rbegin();
+       it != m_Type3CacheLru.rend() && total_bytes > kMaxType3GlyphBytes;
+       ++it) {
+    // Glyphs of a cache held elsewhere may still be pointed to.
+    CPDF_Type3Cache* pCache = m_Type3FaceMap[*it].cache.Get();
+    if (!pCache->HasOneRef())
+      continue;
 
-  auto pCache = pdfium::MakeRetain<CPDF_Type3Cache>(pFont);
-  m_Type3FaceMap[pFont].Reset(pCache.Get());
-  return pCache;
+    const size_t cache_bytes = pCache->GetGlyphBytes();
+    const size_t excess_bytes = total_bytes - kMaxType3GlyphBytes;
+    pCache->TrimToSize(cache_bytes > excess_bytes ? cache_bytes - excess_bytes
+                                                  : 0);
+    total_bytes -= cache_bytes - pCache->GetGlyphBytes();
+  }
 }
 
 RetainPtr<CPDF_TransferFunc> CPDF_DocRenderData::GetTransferFunc(
@@ -61,6 +122,36 @@ RetainPtr<CPDF_TransferFunc> CPDF_DocRenderData::GetTransferFunc(
   return pFunc;
 }
 
+RetainPtr<CFX_DIBitmap> CPDF_DocRenderData::GetCachedPatternCell(
+    const PatternCellKey& key) {
+  auto it = m_PatternCellMap.find(key);
+  if (it == m_PatternCellMap.end())
+    return nullptr;
+
+  m_PatternCellLru.splice(m_PatternCellLru.begin(), m_PatternCellLru,
+                          it->second.lru_it);
+  return it->second.bitmap;
+}
+
+void CPDF_DocRenderData::CachePatternCell(
+    const PatternCellKey& key,
+    const RetainPtr<CFX_DIBitmap>& pBitmap) {
+  const size_t bytes = GetBitmapBytes(pBitmap);
+  if (bytes > kMaxPatternCellBytes / 4 || m_PatternCellMap.count(key))
+    return;
+
+  while (!m_PatternCellLru.empty() &&
+         m_PatternCellBytes + bytes > kMaxPatternCellBytes) {
+    auto victim = m_PatternCellMap.find(m_PatternCellLru.back());
+    m_PatternCellBytes -= GetBitmapBytes(victim->second.bitmap);
+    m_PatternCellMap.erase(victim);
+    m_PatternCellLru.pop_back();
+  }
+  m_PatternCellLru.push_front(key);
+  m_PatternCellMap[key] = {pBitmap, m_PatternCellLru.begin()};
+  m_PatternCellBytes += bytes;
+}
+
 RetainPtr<CPDF_TransferFunc> CPDF_DocRenderData::CreateTransferFunc(
     const CPDF_Object* pObj) const {
   std::unique_ptr<CPDF_Function> pFuncs[3];
@@ -7,12 +7,19 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_DOCRENDERDATA_H_
 #define CORE_FPDFAPI_RENDER_CPDF_DOCRENDERDATA_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
 #include <map>
 
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/dib/fx_dib.h"
 
+class CFX_DIBitmap;
 class CPDF_Font;
 class CPDF_Object;
 class CPDF_TransferFunc;
@@ -29,18 +36,71 @@ class CPDF_DocRenderData : public CPDF_Document::RenderDataIface {
   CPDF_DocRenderData(const CPDF_DocRenderData&) = delete;
   CPDF_DocRenderData& operator=(const CPDF_DocRenderData&) = delete;
 
+  // Identifies a rendered tiling pattern cell. Everything that affects the
+  // pixels of the cell must be part of the key.
+  struct PatternCellKey {
+    bool operator<(const PatternCellKey& other) const;
+
+    const CPDF_Object* pattern_obj = nullptr;
+    CFX_Matrix pattern_to_form;
+    CFX_Matrix parent_matrix;
+    CFX_Matrix object_to_device;
+    int width = 0;
+    int height = 0;
+    // Render option bits, including the color mode.
+    uint32_t options = 0;
+    // From the general state of the object filled with the pattern.
+    float fill_alpha = 1.0f;
+    float stroke_alpha = 1.0f;
+    BlendMode blend_type = BlendMode::kNormal;
+  };
+
+  // Cells stay cached across pages, up to this many bytes of bitmaps.
+  static constexpr size_t kMaxPatternCellBytes = 16 * 1024 * 1024;
+
+  // Glyphs of all Type 3 fonts of the document stay cached up to this many
+  // bytes of bitmaps.
+  static constexpr size_t kMaxType3GlyphBytes = 8 * 1024 * 1024;
+
+  // Evicts glyphs of the least recently used fonts first when the glyphs of
+  // all fonts exceed |kMaxType3GlyphBytes|. Caches also held elsewhere, such
+  // as by a text object being drawn, are left alone.
   RetainPtr<CPDF_Type3Cache> GetCachedType3(CPDF_Type3Font* pFont);
   RetainPtr<CPDF_TransferFunc> GetTransferFunc(const CPDF_Object* pObj);
 
+  // The returned bitmap is shared, and must not be modified.
+  RetainPtr<CFX_DIBitmap> GetCachedPatternCell(const PatternCellKey& key);
+  void CachePatternCell(const PatternCellKey& key,
+                        const RetainPtr<CFX_DIBitmap>& pBitmap);
+
  protected:
   // protected for use by test subclasses.
   RetainPtr<CPDF_TransferFunc> CreateTransferFunc(
       const CPDF_Object* pObj) const;
 
  private:
-  std::map<CPDF_Font*, ObservedPtr<CPDF_Type3Cache>> m_Type3FaceMap;
+  void TrimType3Caches();
+
+  struct Type3CacheEntry {
+    RetainPtr<CPDF_Type3Cache> cache;
+    std::list<CPDF_Font*>::iterator lru_it;
+  };
+  // Retained so that glyphs survive from one text object to the next. Each
+  // cache observes its font, and is dropped once the font is gone.
+  std::map<CPDF_Font*, Type3CacheEntry> m_Type3FaceMap;
+  // Most recently used first.
+  std::list<CPDF_Font*> m_Type3CacheLru;
   std::map<const CPDF_Object*, ObservedPtr<CPDF_TransferFunc>>
       m_TransferFuncMap;
+
+  struct PatternCellEntry {
+    RetainPtr<CFX_DIBitmap> bitmap;
+    std::list<PatternCellKey>::iterator lru_it;
+  };
+  std::map<PatternCellKey, PatternCellEntry> m_PatternCellMap;
+  // Most recently used first.
+  std::list<PatternCellKey> m_PatternCellLru;
+  size_t m_PatternCellBytes = 0;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_DOCRENDERDATA_H_
@@ -7,12 +7,22 @@
 #include <memory>
 #include <utility>
 
+#include "core/fpdfapi/font/cpdf_type3char.h"
+#include "core/fpdfapi/font/cpdf_type3font.h"
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/page/cpdf_pagemodule.h"
 #include "core/fpdfapi/page/cpdf_transferfunc.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_reference.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/render/cpdf_type3cache.h"
 #include "core/fxcrt/fx_memory_wrappers.h"
+#include "core/fxge/cfx_glyphbitmap.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/base/cxx17_backports.h"
 
@@ -265,4 +275,135 @@ TEST(CPDF_DocRenderDataTest, BadTransferFunctions) {
   }
 }
 
+TEST(CPDF_DocRenderDataTest, PatternCellCache) {
+  static constexpr size_t kCellBytes = 512 * 512 * 4;
+  auto make_key = [](int index) {
+    CPDF_DocRenderData::PatternCellKey key;
+    key.object_to_device = CFX_Matrix(1, 0, 0, 1, index, 0);
+    key.width = 512;
+    key.height = 512;
+    return key;
+  };
+  auto make_cell = []() {
+    auto pBitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+    EXPECT_TRUE(pBitmap->Create(512, 512, FXDIB_Format::kArgb));
+    return pBitmap;
+  };
+
+  TestDocRenderData render_data;
+  CPDF_DocRenderData::PatternCellKey key = make_key(0);
+  EXPECT_FALSE(render_data.GetCachedPatternCell(key));
+  RetainPtr<CFX_DIBitmap> pCell = make_cell();
+  render_data.CachePatternCell(key, pCell);
+  EXPECT_EQ(pCell, render_data.GetCachedPatternCell(key));
+
+  CPDF_DocRenderData::PatternCellKey alpha_key = key;
+  alpha_key.fill_alpha = 0.5f;
+  EXPECT_FALSE(render_data.GetCachedPatternCell(alpha_key));
+
+  // Fill the budget, touching the first cell so the second one is evicted.
+  static constexpr int kCellCount =
+      CPDF_DocRenderData::kMaxPatternCellBytes / kCellBytes;
+  for (int i = 1; i < kCellCount; ++i)
+    render_data.CachePatternCell(make_key(i), make_cell());
+  EXPECT_TRUE(render_data.GetCachedPatternCell(make_key(1)));
+  EXPECT_TRUE(render_data.GetCachedPatternCell(key));
+  render_data.CachePatternCell(make_key(kCellCount), make_cell());
+  EXPECT_TRUE(render_data.GetCachedPatternCell(key));
+  EXPECT_FALSE(render_data.GetCachedPatternCell(make_key(2)));
+  EXPECT_TRUE(render_data.GetCachedPatternCell(make_key(kCellCount)));
+
+  // Cells larger than a quarter of the budget are never stored.
+  CPDF_DocRenderData::PatternCellKey big_key = make_key(-1);
+  auto pBig = pdfium::MakeRetain<CFX_DIBitmap>();
+  ASSERT_TRUE(pBig->Create(2048, 1024, FXDIB_Format::kArgb));
+  render_data.CachePatternCell(big_key, pBig);
+  EXPECT_FALSE(render_data.GetCachedPatternCell(big_key));
+}
+
+// Type 3 font whose only glyph, for 'a', is an 8x8 image mask.
+RetainPtr<CPDF_Font> CreateType3Font(CPDF_Document* pDoc) {
+  static const char kCharProc[] =
+      "8 0 0 0 8 8 d1 8 0 0 8 0 0 cm "
+      "BI /W 8 /H 8 /IM true /BPC 1 ID \xff\x81\x81\x81\x81\x81\x81\xff EI";
+  auto* pCharProc = pDoc->NewIndirect<CPDF_Stream>();
+  pCharProc->SetData(pdfium::as_bytes(pdfium::make_span(kCharProc)));
+
+  auto* pFontDict = pDoc->NewIndirect<CPDF_Dictionary>();
+  pFontDict->SetNewFor<CPDF_Name>("Type", "Font");
+  pFontDict->SetNewFor<CPDF_Name>("Subtype", "Type3");
+  pFontDict->SetRectFor("FontBBox", CFX_FloatRect(0, 0, 8, 8));
+  CPDF_Array* pFontMatrix = pFontDict->SetNewFor<CPDF_Array>("FontMatrix");
+  for (float value : {0.125f, 0.0f, 0.0f, 0.125f, 0.0f, 0.0f})
+    pFontMatrix->AppendNew<CPDF_Number>(value);
+  pFontDict->SetNewFor<CPDF_Dictionary>("CharProcs")
+      ->SetNewFor<CPDF_Reference>("a", pDoc, pCharProc->GetObjNum());
+  CPDF_Array* pDifferences = pFontDict->SetNewFor<CPDF_Dictionary>("Encoding")
+                                 ->SetNewFor<CPDF_Array>("Differences");
+  pDifferences->AppendNew<CPDF_Number>('a');
+  pDifferences->AppendNew<CPDF_Name>("a");
+  pFontDict->SetNewFor<CPDF_Number>("FirstChar", 'a');
+  pFontDict->SetNewFor<CPDF_Number>("LastChar", 'a');
+  pFontDict->SetNewFor<CPDF_Array>("Widths")->AppendNew<CPDF_Number>(8);
+  return CPDF_DocPageData::FromDocument(pDoc)->GetFont(pFontDict);
+}
+
+// Loads glyphs into |pCache| at new sizes, starting from |*size|, until it
+// holds at least |min_bytes|.
+void FillType3Cache(CPDF_Type3Cache* pCache, size_t min_bytes, int* size) {
+  while (pCache->GetGlyphBytes() < min_bytes) {
+    const CFX_Matrix matrix(*size, 0, 0, *size, 0, 0);
+    ++*size;
+    ASSERT_TRUE(pCache->LoadGlyph('a', matrix));
+  }
+}
+
 }  // namespace
+
+TEST(CPDF_DocRenderDataTest, Type3GlyphBudget) {
+  static constexpr size_t kMaxBytes = CPDF_DocRenderData::kMaxType3GlyphBytes;
+  CPDF_PageModule::Create();
+  {
+    CPDF_Document doc(std::make_unique<CPDF_DocRenderData>(),
+                      std::make_unique<CPDF_DocPageData>());
+    CPDF_DocRenderData* pRenderData = CPDF_DocRenderData::FromDocument(&doc);
+    RetainPtr<CPDF_Font> pFont1 = CreateType3Font(&doc);
+    RetainPtr<CPDF_Font> pFont2 = CreateType3Font(&doc);
+    ASSERT_TRUE(pFont1);
+    ASSERT_TRUE(pFont2);
+    ASSERT_NE(pFont1, pFont2);
+    CPDF_Type3Font* pType3Font1 = pFont1->AsType3Font();
+    CPDF_Type3Font* pType3Font2 = pFont2->AsType3Font();
+    ASSERT_TRUE(pType3Font1);
+    ASSERT_TRUE(pType3Font2);
+    for (CPDF_Type3Font* pType3Font : {pType3Font1, pType3Font2}) {
+      CPDF_Type3Char* pChar = pType3Font->LoadChar('a');
+      ASSERT_TRUE(pChar);
+      ASSERT_TRUE(pChar->LoadBitmapFromSoleImageOfForm());
+    }
+
+    int size = 50;
+    RetainPtr<CPDF_Type3Cache> pCache1 =
+        pRenderData->GetCachedType3(pType3Font1);
+    FillType3Cache(pCache1.Get(), kMaxBytes / 2, &size);
+    RetainPtr<CPDF_Type3Cache> pCache2 =
+        pRenderData->GetCachedType3(pType3Font2);
+    FillType3Cache(pCache2.Get(), kMaxBytes / 2, &size);
+    const size_t cache2_bytes = pCache2->GetGlyphBytes();
+
+    // Together the fonts are over budget, but both caches are in use.
+    EXPECT_EQ(pCache2, pRenderData->GetCachedType3(pType3Font2));
+    EXPECT_GT(pCache1->GetGlyphBytes() + cache2_bytes, kMaxBytes);
+
+    // Once released, the glyphs of the least recently used font go first.
+    pCache1.Reset();
+    pCache2.Reset();
+    pCache2 = pRenderData->GetCachedType3(pType3Font2);
+    EXPECT_EQ(cache2_bytes, pCache2->GetGlyphBytes());
+    pCache1 = pRenderData->GetCachedType3(pType3Font1);
+    EXPECT_EQ(cache2_bytes, pCache2->GetGlyphBytes());
+    EXPECT_LE(pCache1->GetGlyphBytes() + cache2_bytes, kMaxBytes);
+    EXPECT_GT(pCache1->GetGlyphBytes(), 0u);
+  }
+  CPDF_PageModule::Destroy();
+}
@@ -10,6 +10,7 @@
 #include "core/fpdfapi/page/cpdf_imageobject.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fpdfapi/page/cpdf_pageobjectholder.h"
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
 #include "core/fpdfapi/render/cpdf_pagerendercache.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfapi/render/cpdf_renderstatus.h"
@@ -46,7 +47,7 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
         return;
       }
       m_pCurrentLayer = m_pContext->GetLayer(m_LayerIndex);
-      m_LastObjectRendered = m_pCurrentLayer->GetObjectHolder()->end();
+      m_NextObjectIndex = 0;
       m_pRenderStatus = std::make_unique<CPDF_RenderStatus>(m_pContext.Get(),
                                                             m_pDevice.Get());
       if (m_pOptions)
@@ -57,20 +58,16 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
       m_pDevice->SaveState();
       m_ClipRect = m_pCurrentLayer->GetMatrix().GetInverse().TransformRect(
           CFX_FloatRect(m_pDevice->GetClipBox()));
+      FindVisibleObjects();
     }
-    CPDF_PageObjectHolder::const_iterator iter;
-    CPDF_PageObjectHolder::const_iterator iterEnd =
-        m_pCurrentLayer->GetObjectHolder()->end();
-    if (m_LastObjectRendered != iterEnd) {
-      iter = m_LastObjectRendered;
-      ++iter;
-    } else {
-      iter = m_pCurrentLayer->GetObjectHolder()->begin();
-    }
+    // Objects are indexed rather than iterated, as parsing may still append
+    // to the holder between calls.
+    const CPDF_PageObjectHolder* pHolder = m_pCurrentLayer->GetObjectHolder();
+    size_t index = SkipToVisibleObject(m_NextObjectIndex);
     int nObjsToGo = kStepLimit;
     bool is_mask = false;
-    while (iter != iterEnd) {
-      CPDF_PageObject* pCurObj = iter->get();
+    while (index < pHolder->GetPageObjectCount()) {
+      CPDF_PageObject* pCurObj = pHolder->GetPageObjectByIndex(index);
       if (pCurObj && pCurObj->GetRect().left <= m_ClipRect.right &&
           pCurObj->GetRect().right >= m_ClipRect.left &&
           pCurObj->GetRect().bottom <= m_ClipRect.top &&
@@ -78,7 +75,7 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
         if (m_pOptions->GetOptions().bBreakForMasks && pCurObj->IsImage() &&
             pCurObj->AsImage()->GetImage()->IsMask()) {
           if (m_pDevice->GetDeviceType() == DeviceType::kPrinter) {
-            m_LastObjectRendered = iter;
+            m_NextObjectIndex = index + 1;
             m_pRenderStatus->ProcessClipPath(pCurObj->m_ClipPath,
                                              m_pCurrentLayer->GetMatrix());
             return;
@@ -100,17 +97,17 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
         else
           --nObjsToGo;
       }
-      m_LastObjectRendered = iter;
+      m_NextObjectIndex = ++index;
       if (nObjsToGo == 0) {
         if (pPause && pPause->NeedToPauseNow())
           return;
         nObjsToGo = kStepLimit;
       }
-      ++iter;
-      if (is_mask && iter != iterEnd)
+      index = SkipToVisibleObject(index);
+      if (is_mask && index < pHolder->GetPageObjectCount())
         return;
     }
-    if (m_pCurrentLayer->GetObjectHolder()->GetParseState() ==
+    if (pHolder->GetParseState() ==
         CPDF_PageObjectHolder::ParseState::kParsed) {
       m_pRenderStatus.reset();
       m_pDevice->RestoreState(false);
@@ -121,11 +118,40 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
     } else if (is_mask) {
       return;
     } else {
+      // Draw what a parsing step produced before pausing, so that a page
+      // parsed while rendering shows its first objects as early as possible.
+      const size_t parsed_count = pHolder->GetPageObjectCount();
       m_pCurrentLayer->GetObjectHolder()->ContinueParse(pPause);
-      if (m_pCurrentLayer->GetObjectHolder()->GetParseState() !=
-          CPDF_PageObjectHolder::ParseState::kParsed) {
+      if (pHolder->GetParseState() !=
+              CPDF_PageObjectHolder::ParseState::kParsed &&
+          pHolder->GetPageObjectCount() == parsed_count) {
         return;
       }
     }
   }
 }
+
+void CPDF_ProgressiveRenderer::FindVisibleObjects() {
+  m_bHasVisibleObjects = false;
+  m_NextVisibleObject = 0;
+  const CPDF_PageObjectHolder* pHolder = m_pCurrentLayer->GetObjectHolder();
+  if (pHolder->GetParseState() != CPDF_PageObjectHolder::ParseState::kParsed)
+    return;
+
+  const CPDF_PageObjectIndex* pIndex = pHolder->GetObjectIndex();
+  m_bHasVisibleObjects =
+      pIndex && pIndex->FindObjects(m_ClipRect, &m_VisibleObjects);
+}
+
+size_t CPDF_ProgressiveRenderer::SkipToVisibleObject(size_t index) {
+  if (!m_bHasVisibleObjects)
+    return index;
+
+  while (m_NextVisibleObject < m_VisibleObjects.size() &&
+         m_VisibleObjects[m_NextVisibleObject] < index) {
+    ++m_NextVisibleObject;
+  }
+  if (m_NextVisibleObject == m_VisibleObjects.size())
+    return m_pCurrentLayer->GetObjectHolder()->GetPageObjectCount();
+  return m_VisibleObjects[m_NextVisibleObject];
+}
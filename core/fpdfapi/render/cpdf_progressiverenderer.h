@@ -8,6 +8,7 @@
 #define CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
 
 #include <memory>
+#include <vector>
 
 #include "core/fpdfapi/page/cpdf_pageobjectholder.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
@@ -45,6 +46,15 @@ class CPDF_ProgressiveRenderer {
   // Maximum page objects to render before checking for pause.
   static constexpr int kStepLimit = 100;
 
+  // Looks up the objects of the current layer that intersect |m_ClipRect|,
+  // if the layer is fully parsed and has an object index.
+  void FindVisibleObjects();
+
+  // Returns the index of the first object at or after |index| found by
+  // FindVisibleObjects(), or |index| itself if there was no lookup. Calls must
+  // not go backwards within a layer.
+  size_t SkipToVisibleObject(size_t index);
+
   Status m_Status = kReady;
   UnownedPtr<CPDF_RenderContext> const m_pContext;
   UnownedPtr<CFX_RenderDevice> const m_pDevice;
@@ -53,7 +63,10 @@ class CPDF_ProgressiveRenderer {
   CFX_FloatRect m_ClipRect;
   uint32_t m_LayerIndex = 0;
   CPDF_RenderContext::Layer* m_pCurrentLayer = nullptr;
-  CPDF_PageObjectHolder::const_iterator m_LastObjectRendered;
+  size_t m_NextObjectIndex = 0;
+  bool m_bHasVisibleObjects = false;
+  size_t m_NextVisibleObject = 0;
+  std::vector<uint32_t> m_VisibleObjects;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
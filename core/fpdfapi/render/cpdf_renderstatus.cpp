@@ -10,7 +10,6 @@
 #include <cmath>
 #include <memory>
 #include <numeric>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -29,6 +28,7 @@
 #include "core/fpdfapi/page/cpdf_occontext.h"
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
 #include "core/fpdfapi/page/cpdf_pathobject.h"
 #include "core/fpdfapi/page/cpdf_shadingobject.h"
 #include "core/fpdfapi/page/cpdf_shadingpattern.h"
@@ -126,6 +126,13 @@ bool IsAvailableMatrix(const CFX_Matrix& matrix) {
   return true;
 }
 
+bool IsObjectOutsideRect(const CPDF_PageObject* pObj,
+                         const CFX_FloatRect& rect) {
+  const CFX_FloatRect& obj_rect = pObj->GetRect();
+  return obj_rect.left > rect.right || obj_rect.right < rect.left ||
+         obj_rect.bottom > rect.top || obj_rect.top < rect.bottom;
+}
+
 bool MissingFillColor(const CPDF_ColorState* pColorState) {
   return !pColorState->HasRef() || pColorState->GetFillColor()->IsNull();
 }
@@ -203,23 +210,33 @@ void CPDF_RenderStatus::RenderObjectList(
 #endif
   CFX_FloatRect clip_rect = mtObj2Device.GetInverse().TransformRect(
       CFX_FloatRect(m_pDevice->GetClipBox()));
-  for (const auto& pCurObj : *pObjectHolder) {
-    if (pCurObj.get() == m_pStopObj) {
-      m_bStopped = true;
-      return;
+
+  // The stop object has to be found even when it is clipped out.
+  const CPDF_PageObjectIndex* pIndex =
+      m_pStopObj ? nullptr : pObjectHolder->GetObjectIndex();
+  std::vector<uint32_t> visible_objects;
+  if (pIndex && pIndex->FindObjects(clip_rect, &visible_objects)) {
+    for (uint32_t index : visible_objects) {
+      CPDF_PageObject* pCurObj = pObjectHolder->GetPageObjectByIndex(index);
+      if (!IsObjectOutsideRect(pCurObj, clip_rect)) {
+        RenderSingleObject(pCurObj, mtObj2Device);
+        if (m_bStopped)
+          return;
+      }
     }
-    if (!pCurObj)
-      continue;
+  } else {
+    for (const auto& pCurObj : *pObjectHolder) {
+      if (pCurObj.get() == m_pStopObj) {
+        m_bStopped = true;
+        return;
+      }
+      if (!pCurObj || IsObjectOutsideRect(pCurObj.get(), clip_rect))
+        continue;
 
-    if (pCurObj->GetRect().left > clip_rect.right ||
-        pCurObj->GetRect().right < clip_rect.left ||
-        pCurObj->GetRect().bottom > clip_rect.top ||
-        pCurObj->GetRect().top < clip_rect.bottom) {
-      continue;
+      RenderSingleObject(pCurObj.get(), mtObj2Device);
+      if (m_bStopped)
+        return;
     }
-    RenderSingleObject(pCurObj.get(), mtObj2Device);
-    if (m_bStopped)
-      return;
   }
 #if defined(_SKIA_SUPPORT_)
   DebugVerifyDeviceIsPreMultiplied();
@@ -513,7 +530,8 @@ void CPDF_RenderStatus::ProcessClipPath(const CPDF_ClipPath& ClipPath,
     }
     return;
   }
-  if (m_LastClipPath == ClipPath)
+  // Generated content often sets up an identical clip for every object.
+  if (m_LastClipPath.IsEquivalentTo(ClipPath))
     return;
 
   m_LastClipPath = ClipPath;
@@ -921,8 +939,8 @@ bool CPDF_RenderStatus::ProcessType3Text(CPDF_TextObject* textobj,
   float font_size = textobj->m_TextState.GetFontSize();
   char_matrix.Scale(font_size, font_size);
 
-  // Must come before |glyphs|, because |glyphs| points into |refTypeCache|.
-  std::set<RetainPtr<CPDF_Type3Cache>> refTypeCache;
+  // Must come before |glyphs|, because |glyphs| points into |pCache|.
+  RetainPtr<CPDF_Type3Cache> pCache;
   std::vector<TextGlyphPos> glyphs;
   if (!m_bPrint)
     glyphs.resize(textobj->GetCharCodes().size());
@@ -1018,16 +1036,18 @@ bool CPDF_RenderStatus::ProcessType3Text(CPDF_TextObject* textobj,
         if (!renderer.GetResult())
           return false;
       } else {
-        CPDF_Document* pDoc = pType3Font->GetDocument();
-        RetainPtr<CPDF_Type3Cache> pCache =
-            CPDF_DocRenderData::FromDocument(pDoc)->GetCachedType3(pType3Font);
+        // Fetch the cache once per text object. Fetching it may evict
+        // glyphs, which |glyphs| must not point to.
+        if (!pCache) {
+          CPDF_Document* pDoc = pType3Font->GetDocument();
+          pCache = CPDF_DocRenderData::FromDocument(pDoc)->GetCachedType3(
+              pType3Font);
+        }
 
         const CFX_GlyphBitmap* pBitmap = pCache->LoadGlyph(charcode, matrix);
         if (!pBitmap)
           continue;
 
-        refTypeCache.insert(std::move(pCache));
-
         CFX_Point origin(FXSYS_roundf(matrix.e), FXSYS_roundf(matrix.f));
         if (glyphs.empty()) {
           FX_SAFE_INT32 left = origin.x;
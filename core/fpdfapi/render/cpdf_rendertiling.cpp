@@ -6,18 +6,25 @@
 
 #include "core/fpdfapi/render/cpdf_rendertiling.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <tuple>
 
 #include "core/fpdfapi/page/cpdf_form.h"
+#include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fpdfapi/page/cpdf_tilingpattern.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
 #include "core/fpdfapi/render/cpdf_pagerendercache.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfapi/render/cpdf_renderstatus.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
+#include "third_party/base/cxx17_backports.h"
 
 namespace {
 
@@ -64,6 +71,126 @@ RetainPtr<CFX_DIBitmap> DrawPatternBitmap(
   return pBitmap;
 }
 
+// Returns false if the pattern cell rendered for |pPageObj| depends on more
+// than CPDF_DocRenderData::PatternCellKey can describe.
+bool GetPatternCellKey(const CPDF_TilingPattern* pPattern,
+                       const CPDF_PageObject* pPageObj,
+                       const CFX_Matrix& mtObj2Device,
+                       int width,
+                       int height,
+                       const CPDF_RenderOptions& options,
+                       CPDF_DocRenderData::PatternCellKey* key) {
+  const CPDF_GeneralState& state = pPageObj->m_GeneralState;
+  if (state.GetSoftMask() || state.GetTR())
+    return false;
+
+  const CPDF_RenderOptions::Options& flags = options.GetOptions();
+  const bool bits[] = {flags.bClearType,
+                       flags.bNoNativeText,
+                       flags.bForceHalftone,
+                       flags.bRectAA,
+                       flags.bBreakForMasks,
+                       flags.bNoTextSmooth,
+                       flags.bNoPathSmooth,
+                       flags.bNoImageSmooth,
+                       flags.bLimitedImageCache,
+                       flags.bConvertFillToStroke,
+                       options.ColorModeIs(CPDF_RenderOptions::kGray)};
+  uint32_t option_bits = 0;
+  for (size_t i = 0; i < pdfium::size(bits); ++i)
+    option_bits |= static_cast<uint32_t>(bits[i]) << i;
+
+  key->pattern_obj = pPattern->pattern_obj();
+  key->pattern_to_form = pPattern->pattern_to_form();
+  key->parent_matrix = pPattern->parent_matrix();
+  key->object_to_device = mtObj2Device;
+  key->width = width;
+  key->height = height;
+  key->options = option_bits;
+  if (state.HasRef()) {
+    key->fill_alpha = state.GetFillAlpha();
+    key->stroke_alpha = state.GetStrokeAlpha();
+    key->blend_type = state.GetBlendType();
+  }
+  return true;
+}
+
+// Returns the pattern cell as kArgb pixels, the way they would be composited
+// onto a transparent bitmap.
+RetainPtr<CFX_DIBitmap> GetArgbCell(const RetainPtr<CFX_DIBitmap>& pCell,
+                                    bool bColored,
+                                    FX_ARGB fill_argb) {
+  if (bColored)
+    return pCell;
+
+  auto pArgbCell = pdfium::MakeRetain<CFX_DIBitmap>();
+  if (!pArgbCell->Create(pCell->GetWidth(), pCell->GetHeight(),
+                         FXDIB_Format::kArgb)) {
+    return nullptr;
+  }
+
+  int fill_alpha;
+  int fill_r;
+  int fill_g;
+  int fill_b;
+  std::tie(fill_alpha, fill_r, fill_g, fill_b) = ArgbDecode(fill_argb);
+  uint32_t colors[256];
+  for (int i = 0; i < 256; ++i) {
+    FXARGB_SETDIB(reinterpret_cast<uint8_t*>(&colors[i]),
+                  ArgbEncode(fill_alpha * i / 255, fill_r, fill_g, fill_b));
+  }
+  for (int row = 0; row < pCell->GetHeight(); ++row) {
+    const uint8_t* src_scan = pCell->GetScanline(row);
+    uint32_t* dest_scan =
+        reinterpret_cast<uint32_t*>(pArgbCell->GetWritableScanline(row));
+    for (int col = 0; col < pCell->GetWidth(); ++col)
+      dest_scan[col] = colors[src_scan[col]];
+  }
+  return pArgbCell;
+}
+
+// Fills all of |pScreen| with copies of |pCell|, whose top left corner is at
+// (|origin_x|, |origin_y|) in |pScreen|, on a grid of the cell's size. Cells
+// on such a grid neither overlap nor leave gaps, so that compositing them onto
+// a transparent bitmap amounts to copying them.
+void TileAlignedCells(const RetainPtr<CFX_DIBitmap>& pScreen,
+                      const RetainPtr<CFX_DIBitmap>& pCell,
+                      int origin_x,
+                      int origin_y) {
+  const int cell_width = pCell->GetWidth();
+  const int cell_height = pCell->GetHeight();
+  const int screen_width = pScreen->GetWidth();
+  const int screen_height = pScreen->GetHeight();
+  int phase_x = -origin_x % cell_width;
+  if (phase_x < 0)
+    phase_x += cell_width;
+  int phase_y = -origin_y % cell_height;
+  if (phase_y < 0)
+    phase_y += cell_height;
+
+  // Rows repeat every |cell_height| rows, so only the first cell row needs to
+  // be assembled from cell pixels.
+  const int assembled_rows = std::min(cell_height, screen_height);
+  for (int row = 0; row < assembled_rows; ++row) {
+    const uint8_t* src_scan =
+        pCell->GetScanline((phase_y + row) % cell_height);
+    uint8_t* dest_scan = pScreen->GetWritableScanline(row);
+    int col = 0;
+    int src_col = phase_x;
+    while (col < screen_width) {
+      int count = std::min(cell_width - src_col, screen_width - col);
+      memcpy(dest_scan + col * 4, src_scan + src_col * 4, count * 4);
+      col += count;
+      src_col = 0;
+    }
+  }
+  const size_t row_bytes = static_cast<size_t>(screen_width) * 4;
+  for (int row = assembled_rows; row < screen_height; ++row) {
+    memcpy(pScreen->GetWritableScanline(row),
+           pScreen->GetScanline(row - cell_height), row_bytes);
+  }
+}
+
 }  // namespace
 
 // static
@@ -168,23 +295,35 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderTiling::Draw(
   }
   float left_offset = cell_bbox.left - mtPattern2Device.e;
   float top_offset = cell_bbox.bottom - mtPattern2Device.f;
-  RetainPtr<CFX_DIBitmap> pPatternBitmap;
-  if (width * height < 16) {
-    RetainPtr<CFX_DIBitmap> pEnlargedBitmap = DrawPatternBitmap(
-        pContext->GetDocument(), pContext->GetPageCache(), pPattern,
-        pPatternForm, mtObj2Device, 8, 8, options.GetOptions());
-    pPatternBitmap = pEnlargedBitmap->StretchTo(
-        width, height, FXDIB_ResampleOptions(), nullptr);
-  } else {
-    pPatternBitmap = DrawPatternBitmap(
-        pContext->GetDocument(), pContext->GetPageCache(), pPattern,
-        pPatternForm, mtObj2Device, width, height, options.GetOptions());
-  }
-  if (!pPatternBitmap)
-    return nullptr;
+  CPDF_DocRenderData* pDocCache =
+      CPDF_DocRenderData::FromDocument(pContext->GetDocument());
+  CPDF_DocRenderData::PatternCellKey cell_key;
+  const bool bCacheable =
+      pDocCache && GetPatternCellKey(pPattern, pPageObj, mtObj2Device, width,
+                                     height, options, &cell_key);
+  RetainPtr<CFX_DIBitmap> pPatternBitmap =
+      bCacheable ? pDocCache->GetCachedPatternCell(cell_key) : nullptr;
+  if (!pPatternBitmap) {
+    if (width * height < 16) {
+      RetainPtr<CFX_DIBitmap> pEnlargedBitmap = DrawPatternBitmap(
+          pContext->GetDocument(), pContext->GetPageCache(), pPattern,
+          pPatternForm, mtObj2Device, 8, 8, options.GetOptions());
+      pPatternBitmap = pEnlargedBitmap->StretchTo(
+          width, height, FXDIB_ResampleOptions(), nullptr);
+    } else {
+      pPatternBitmap = DrawPatternBitmap(
+          pContext->GetDocument(), pContext->GetPageCache(), pPattern,
+          pPatternForm, mtObj2Device, width, height, options.GetOptions());
+    }
+    if (!pPatternBitmap)
+      return nullptr;
 
-  if (options.ColorModeIs(CPDF_RenderOptions::kGray))
-    pPatternBitmap->ConvertColorScale(0, 0xffffff);
+    if (options.ColorModeIs(CPDF_RenderOptions::kGray))
+      pPatternBitmap->ConvertColorScale(0, 0xffffff);
+
+    if (bCacheable)
+      pDocCache->CachePatternCell(cell_key, pPatternBitmap);
+  }
 
   FX_ARGB fill_argb = pRenderStatus->GetFillArgb(pPageObj);
   int clip_width = clip_box.right - clip_box.left;
@@ -193,6 +332,18 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderTiling::Draw(
   if (!pScreen->Create(clip_width, clip_height, FXDIB_Format::kArgb))
     return nullptr;
 
+  if (bAligned && (width > 1 || height > 1)) {
+    RetainPtr<CFX_DIBitmap> pArgbCell =
+        GetArgbCell(pPatternBitmap, pPattern->colored(), fill_argb);
+    if (!pArgbCell)
+      return nullptr;
+
+    TileAlignedCells(pScreen, pArgbCell,
+                     FXSYS_roundf(mtPattern2Device.e) - clip_box.left,
+                     FXSYS_roundf(mtPattern2Device.f) - clip_box.top);
+    return pScreen;
+  }
+
   pScreen->Clear(0);
   const uint8_t* const src_buf = pPatternBitmap->GetBuffer();
   for (int col = min_col; col <= max_col; col++) {
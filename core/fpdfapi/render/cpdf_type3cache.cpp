@@ -91,6 +91,11 @@ int DetectLastScan(const RetainPtr<CFX_DIBitmap>& pBitmap) {
   return -1;
 }
 
+size_t GetGlyphBitmapBytes(const CFX_GlyphBitmap* pGlyph) {
+  const RetainPtr<CFX_DIBitmap>& pBitmap = pGlyph->GetBitmap();
+  return static_cast<size_t>(pBitmap->GetPitch()) * pBitmap->GetHeight();
+}
+
 }  // namespace
 
 CPDF_Type3Cache::CPDF_Type3Cache(CPDF_Type3Font* pFont) : m_pFont(pFont) {}
@@ -113,21 +118,42 @@ const CFX_GlyphBitmap* CPDF_Type3Cache::LoadGlyph(uint32_t charcode,
   } else {
     pSizeCache = it->second.get();
   }
+  const GlyphKey key(pSizeCache, charcode);
   const CFX_GlyphBitmap* pExisting = pSizeCache->GetBitmap(charcode);
-  if (pExisting)
+  if (pExisting) {
+    m_GlyphLru.splice(m_GlyphLru.begin(), m_GlyphLru, m_GlyphLruMap[key]);
     return pExisting;
+  }
 
   std::unique_ptr<CFX_GlyphBitmap> pNewBitmap =
       RenderGlyph(pSizeCache, charcode, mtMatrix);
   CFX_GlyphBitmap* pGlyphBitmap = pNewBitmap.get();
   pSizeCache->SetBitmap(charcode, std::move(pNewBitmap));
+  if (pGlyphBitmap) {
+    m_GlyphBytes += GetGlyphBitmapBytes(pGlyphBitmap);
+    m_GlyphLru.push_front(key);
+    m_GlyphLruMap[key] = m_GlyphLru.begin();
+  }
   return pGlyphBitmap;
 }
 
+void CPDF_Type3Cache::TrimToSize(size_t max_bytes) {
+  while (m_GlyphBytes > max_bytes && !m_GlyphLru.empty()) {
+    const GlyphKey& key = m_GlyphLru.back();
+    m_GlyphBytes -= GetGlyphBitmapBytes(key.first->GetBitmap(key.second));
+    key.first->RemoveBitmap(key.second);
+    m_GlyphLruMap.erase(key);
+    m_GlyphLru.pop_back();
+  }
+}
+
 std::unique_ptr<CFX_GlyphBitmap> CPDF_Type3Cache::RenderGlyph(
     CPDF_Type3GlyphMap* pSize,
     uint32_t charcode,
     const CFX_Matrix& mtMatrix) {
+  if (!m_pFont)
+    return nullptr;
+
   const CPDF_Type3Char* pChar = m_pFont->LoadChar(charcode);
   if (!pChar || !pChar->GetBitmap())
     return nullptr;
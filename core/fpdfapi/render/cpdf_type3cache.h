@@ -7,8 +7,13 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_TYPE3CACHE_H_
 #define CORE_FPDFAPI_RENDER_CPDF_TYPE3CACHE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
 #include <map>
 #include <memory>
+#include <utility>
 
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/fx_system.h"
@@ -24,10 +29,21 @@ class CPDF_Type3Cache final : public Retainable, public Observable {
  public:
   CONSTRUCT_VIA_MAKE_RETAIN;
 
+  // The returned glyph stays valid until the next call to TrimToSize().
   const CFX_GlyphBitmap* LoadGlyph(uint32_t charcode,
                                    const CFX_Matrix& mtMatrix);
 
+  // Evicts the least recently used glyphs until the cached glyph bitmaps take
+  // at most |max_bytes|.
+  void TrimToSize(size_t max_bytes);
+
+  // Returns nullptr once the font has been destroyed.
+  CPDF_Type3Font* GetFont() const { return m_pFont.Get(); }
+  size_t GetGlyphBytes() const { return m_GlyphBytes; }
+
  private:
+  using GlyphKey = std::pair<CPDF_Type3GlyphMap*, uint32_t>;
+
   explicit CPDF_Type3Cache(CPDF_Type3Font* pFont);
   ~CPDF_Type3Cache() override;
 
@@ -35,8 +51,14 @@ class CPDF_Type3Cache final : public Retainable, public Observable {
                                                uint32_t charcode,
                                                const CFX_Matrix& mtMatrix);
 
-  RetainPtr<CPDF_Type3Font> const m_pFont;
+  // Not retained, so that caches kept by the document do not keep fonts
+  // alive after their pages are gone.
+  ObservedPtr<CPDF_Type3Font> const m_pFont;
+  size_t m_GlyphBytes = 0;
   std::map<ByteString, std::unique_ptr<CPDF_Type3GlyphMap>> m_SizeMap;
+  // Cached glyphs, most recently used first.
+  std::list<GlyphKey> m_GlyphLru;
+  std::map<GlyphKey, std::list<GlyphKey>::iterator> m_GlyphLruMap;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_TYPE3CACHE_H_
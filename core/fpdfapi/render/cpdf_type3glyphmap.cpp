@@ -54,3 +54,7 @@ void CPDF_Type3GlyphMap::SetBitmap(uint32_t charcode,
                                    std::unique_ptr<CFX_GlyphBitmap> pMap) {
   m_GlyphMap[charcode] = std::move(pMap);
 }
+
+void CPDF_Type3GlyphMap::RemoveBitmap(uint32_t charcode) {
+  m_GlyphMap.erase(charcode);
+}
@@ -26,6 +26,7 @@ class CPDF_Type3GlyphMap {
 
   const CFX_GlyphBitmap* GetBitmap(uint32_t charcode) const;
   void SetBitmap(uint32_t charcode, std::unique_ptr<CFX_GlyphBitmap> pMap);
+  void RemoveBitmap(uint32_t charcode);
 
  private:
   std::vector<int> m_TopBlue;
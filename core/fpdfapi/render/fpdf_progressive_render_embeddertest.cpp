@@ -7,6 +7,7 @@
 #include "build/build_config.h"
 #include "core/fxcrt/fx_system.h"
 #include "core/fxge/dib/fx_dib.h"
+#include "public/fpdf_edit.h"
 #include "public/fpdf_progressive.h"
 #include "testing/embedder_test.h"
 #include "testing/embedder_test_constants.h"
@@ -299,6 +300,52 @@ TEST_F(FPDFProgressiveRenderEmbedderTest, RenderFormsWithPause) {
   UnloadPage(page);
 }
 
+TEST_F(FPDFProgressiveRenderEmbedderTest, RenderWhileParsingWithPause) {
+  // Test that a page loaded without parsing its content gets parsed by the
+  // progressive renderer, with the same result as a page parsed up front.
+  ASSERT_TRUE(OpenDocument("split_streams.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  const int expected_object_count = FPDFPage_CountObjects(page);
+  FakePause pause(true);
+  bool render_done = StartRenderPage(page, &pause);
+  while (!render_done)
+    render_done = ContinueRenderPage(page, &pause);
+  ScopedFPDFBitmap expected_bitmap = FinishRenderPage(page);
+  UnloadPage(page);
+
+  ScopedFPDFPage unparsed_page(
+      FPDF_LoadPageForProgressiveRender(document(), 0));
+  ASSERT_TRUE(unparsed_page);
+  EXPECT_EQ(0, FPDFPage_CountObjects(unparsed_page.get()));
+  render_done = StartRenderPage(unparsed_page.get(), &pause);
+  EXPECT_FALSE(render_done);
+  EXPECT_LT(0, FPDFPage_CountObjects(unparsed_page.get()));
+  while (!render_done)
+    render_done = ContinueRenderPage(unparsed_page.get(), &pause);
+  ScopedFPDFBitmap bitmap = FinishRenderPage(unparsed_page.get());
+  EXPECT_EQ(HashBitmap(expected_bitmap.get()), HashBitmap(bitmap.get()));
+  EXPECT_EQ(expected_object_count, FPDFPage_CountObjects(unparsed_page.get()));
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, CloseWhileParsing) {
+  ASSERT_TRUE(OpenDocument("split_streams.pdf"));
+  EXPECT_FALSE(FPDF_LoadPageForProgressiveRender(document(), 1));
+
+  // FPDF_RenderPage_Close() finishes parsing, even without rendering.
+  ScopedFPDFPage page(FPDF_LoadPageForProgressiveRender(document(), 0));
+  ASSERT_TRUE(page);
+  FPDF_RenderPage_Close(page.get());
+  EXPECT_LT(0, FPDFPage_CountObjects(page.get()));
+
+  // Pages may also be closed before parsing is done.
+  ScopedFPDFPage unparsed_page(
+      FPDF_LoadPageForProgressiveRender(document(), 0));
+  ASSERT_TRUE(unparsed_page);
+  FakePause pause(true);
+  EXPECT_FALSE(StartRenderPage(unparsed_page.get(), &pause));
+}
+
 void FPDFProgressiveRenderEmbedderTest::VerifyRenderingWithColorScheme(
     int page_num,
     int flags,
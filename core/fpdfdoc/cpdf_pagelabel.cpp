@@ -8,6 +8,7 @@
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
 #include "core/fpdfdoc/cpdf_numbertree.h"
 
@@ -95,13 +96,21 @@ Optional<WideString> CPDF_PageLabel::GetLabel(int nPage) const {
 
   CPDF_NumberTree numberTree(pLabels);
   const CPDF_Object* pValue = nullptr;
+  const int nCachedPage = nPage >= m_CachedPage ? m_CachedPage : -1;
   int n = nPage;
-  while (n >= 0) {
+  while (n > nCachedPage) {
     pValue = numberTree.LookupValue(n);
     if (pValue)
       break;
     n--;
   }
+  if (!pValue && nCachedPage >= 0) {
+    n = m_CachedKey;
+    pValue = m_pCachedValue.Get();
+  }
+  m_CachedPage = nPage;
+  m_CachedKey = pValue ? n : -1;
+  m_pCachedValue = pValue;
 
   WideString label;
   if (pValue) {
@@ -12,16 +12,24 @@
 #include "third_party/base/optional.h"
 
 class CPDF_Document;
+class CPDF_Object;
 
 class CPDF_PageLabel {
  public:
   explicit CPDF_PageLabel(CPDF_Document* pDocument);
   ~CPDF_PageLabel();
 
+  // Looking up pages in increasing order reuses the previous lookup, so
+  // labelling a range of pages with one instance is linear in its length.
   Optional<WideString> GetLabel(int nPage) const;
 
  private:
   UnownedPtr<CPDF_Document> const m_pDocument;
+  // The number tree entry in effect for |m_CachedPage|, i.e. the one with
+  // the largest key not above it, or none if |m_CachedKey| is -1.
+  mutable int m_CachedPage = -1;
+  mutable int m_CachedKey = -1;
+  mutable UnownedPtr<const CPDF_Object> m_pCachedValue;
 };
 
 #endif  // CORE_FPDFDOC_CPDF_PAGELABEL_H_
@@ -0,0 +1,35 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdftext/cpdf_doctextiterator.h"
+
+#include "core/fpdfapi/page/cpdf_page.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdftext/cpdf_textpage.h"
+
+CPDF_DocTextIterator::CPDF_DocTextIterator(CPDF_Document* pDoc, bool rtl)
+    : m_pDocument(pDoc), m_rtl(rtl) {}
+
+CPDF_DocTextIterator::~CPDF_DocTextIterator() = default;
+
+CPDF_TextPage* CPDF_DocTextIterator::Next() {
+  m_pTextPage.reset();
+  m_pPage.Reset();
+
+  const int page_count = m_pDocument->GetPageCount();
+  while (m_PageIndex + 1 < page_count) {
+    ++m_PageIndex;
+    CPDF_Dictionary* pDict = m_pDocument->GetPageDictionary(m_PageIndex);
+    if (!pDict)
+      continue;
+
+    m_pPage = pdfium::MakeRetain<CPDF_Page>(m_pDocument.Get(), pDict);
+    m_pPage->SetTextOnly(true);
+    m_pPage->ParseContent();
+    m_pTextPage = std::make_unique<CPDF_TextPage>(m_pPage.Get(), m_rtl);
+    return m_pTextPage.get();
+  }
+  return nullptr;
+}
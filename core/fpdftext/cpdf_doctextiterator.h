@@ -0,0 +1,42 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFTEXT_CPDF_DOCTEXTITERATOR_H_
+#define CORE_FPDFTEXT_CPDF_DOCTEXTITERATOR_H_
+
+#include <memory>
+
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
+
+class CPDF_Document;
+class CPDF_Page;
+class CPDF_TextPage;
+
+// Visits the pages of a document in order, building a CPDF_TextPage for each
+// one. Pages are parsed in text-only mode, and only the current page is kept
+// in memory.
+class CPDF_DocTextIterator {
+ public:
+  CPDF_DocTextIterator(CPDF_Document* pDoc, bool rtl);
+  ~CPDF_DocTextIterator();
+
+  // Advances to the next page, skipping pages that cannot be loaded. Returns
+  // nullptr once all pages have been visited. The returned text page remains
+  // valid until the next call or until the iterator is destroyed.
+  CPDF_TextPage* Next();
+
+  // Index of the page last returned by Next().
+  int GetPageIndex() const { return m_PageIndex; }
+
+ private:
+  UnownedPtr<CPDF_Document> const m_pDocument;
+  const bool m_rtl;
+  int m_PageIndex = -1;
+  RetainPtr<CPDF_Page> m_pPage;
+  // Must be destroyed before |m_pPage|.
+  std::unique_ptr<CPDF_TextPage> m_pTextPage;
+};
+
+#endif  // CORE_FPDFTEXT_CPDF_DOCTEXTITERATOR_H_
@@ -0,0 +1,212 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdftext/cpdf_textindex.h"
+
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <utility>
+
+#include "core/fpdftext/cpdf_textpage.h"
+#include "core/fpdftext/cpdf_textpagefind.h"
+#include "third_party/base/check.h"
+#include "third_party/base/check_op.h"
+
+namespace {
+
+// Unicode noncharacter, never produced by text extraction.
+constexpr wchar_t kPageSeparator = 0xFFFF;
+
+// Aho-Corasick automaton that finds occurrences of any number of patterns in
+// time linear in the length of the text plus the number of occurrences.
+class MultiPatternMatcher {
+ public:
+  explicit MultiPatternMatcher(const std::vector<WideString>& patterns);
+
+  // Calls |callback(pattern_index, last_char_pos)| for every occurrence of
+  // every pattern in |text|, ordered by |last_char_pos|.
+  template <typename Callback>
+  void Scan(WideStringView text, const Callback& callback) const {
+    size_t state = 0;
+    for (size_t i = 0; i < text.GetLength(); ++i) {
+      state = NextState(state, text[i]);
+      for (size_t pattern_index : m_Nodes[state].outputs)
+        callback(pattern_index, i);
+    }
+  }
+
+ private:
+  static constexpr size_t kNoChild = static_cast<size_t>(-1);
+
+  struct Node {
+    std::map<wchar_t, size_t> children;
+    size_t fail = 0;
+    // Patterns ending at this node, including those reached via |fail|.
+    std::vector<size_t> outputs;
+  };
+
+  size_t GetChild(size_t node, wchar_t ch) const {
+    const auto& children = m_Nodes[node].children;
+    auto it = children.find(ch);
+    return it != children.end() ? it->second : kNoChild;
+  }
+
+  size_t NextState(size_t state, wchar_t ch) const {
+    while (true) {
+      size_t child = GetChild(state, ch);
+      if (child != kNoChild)
+        return child;
+      if (state == 0)
+        return 0;
+      state = m_Nodes[state].fail;
+    }
+  }
+
+  std::vector<Node> m_Nodes;
+};
+
+MultiPatternMatcher::MultiPatternMatcher(
+    const std::vector<WideString>& patterns)
+    : m_Nodes(1) {
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    const WideString& pattern = patterns[i];
+    if (pattern.IsEmpty())
+      continue;
+
+    size_t node = 0;
+    for (wchar_t ch : pattern) {
+      size_t child = GetChild(node, ch);
+      if (child == kNoChild) {
+        child = m_Nodes.size();
+        m_Nodes[node].children[ch] = child;
+        m_Nodes.emplace_back();
+      }
+      node = child;
+    }
+    m_Nodes[node].outputs.push_back(i);
+  }
+
+  // Breadth-first, so that every node's fail target is complete before the
+  // node's children are visited.
+  std::queue<size_t> pending;
+  for (const auto& child : m_Nodes[0].children)
+    pending.push(child.second);
+  while (!pending.empty()) {
+    size_t node = pending.front();
+    pending.pop();
+    for (const auto& child : m_Nodes[node].children) {
+      size_t fail = m_Nodes[node].fail;
+      size_t target = GetChild(fail, child.first);
+      while (target == kNoChild && fail != 0) {
+        fail = m_Nodes[fail].fail;
+        target = GetChild(fail, child.first);
+      }
+      Node& child_node = m_Nodes[child.second];
+      child_node.fail = target != kNoChild ? target : 0;
+      const std::vector<size_t>& inherited = m_Nodes[child_node.fail].outputs;
+      child_node.outputs.insert(child_node.outputs.end(), inherited.begin(),
+                                inherited.end());
+      pending.push(child.second);
+    }
+  }
+}
+
+}  // namespace
+
+CPDF_TextIndex::CPDF_TextIndex() = default;
+
+CPDF_TextIndex::~CPDF_TextIndex() = default;
+
+void CPDF_TextIndex::AddPage(int page_index, const CPDF_TextPage* text_page) {
+  WideString text = text_page->GetAllPageText();
+  std::vector<int> char_indices(text.GetLength());
+  for (size_t i = 0; i < char_indices.size(); ++i)
+    char_indices[i] = text_page->CharIndexFromTextIndex(static_cast<int>(i));
+  AddPageText(page_index, text, char_indices);
+}
+
+void CPDF_TextIndex::AddPageText(int page_index,
+                                 const WideString& text,
+                                 const std::vector<int>& char_indices) {
+  CHECK_EQ(text.GetLength(), char_indices.size());
+
+  if (!m_Pages.empty()) {
+    m_Text += kPageSeparator;
+    m_FoldedText += kPageSeparator;
+    m_CharIndices.push_back(-1);
+  }
+  m_Pages.push_back({page_index, m_Text.GetLength()});
+
+  WideString folded = text;
+  folded.MakeLower();
+  DCHECK_EQ(text.GetLength(), folded.GetLength());
+  m_Text += text;
+  m_FoldedText += folded;
+  m_CharIndices.insert(m_CharIndices.end(), char_indices.begin(),
+                       char_indices.end());
+}
+
+std::vector<CPDF_TextIndex::Match> CPDF_TextIndex::FindAll(
+    const std::vector<WideString>& queries,
+    const Options& options) const {
+  std::vector<WideString> patterns;
+  patterns.reserve(queries.size());
+  for (const WideString& query : queries) {
+    WideString pattern = query;
+    if (!options.bMatchCase)
+      pattern.MakeLower();
+    if (pattern.Find(kPageSeparator).has_value())
+      pattern.clear();
+    patterns.push_back(std::move(pattern));
+  }
+
+  // Pairs of (first text index, match), sorted once the scan is done.
+  std::vector<std::pair<size_t, Match>> found;
+  std::vector<size_t> next_allowed_start(patterns.size());
+  MultiPatternMatcher matcher(patterns);
+  const WideString& text = options.bMatchCase ? m_Text : m_FoldedText;
+  matcher.Scan(text.AsStringView(), [&](size_t query_index, size_t end) {
+    size_t start = end + 1 - patterns[query_index].GetLength();
+    if (start < next_allowed_start[query_index])
+      return;
+    if (options.bMatchWholeWord &&
+        !CPDF_TextPageFind::IsMatchWholeWord(m_Text, start, end)) {
+      return;
+    }
+    next_allowed_start[query_index] = options.bConsecutive ? start : end + 1;
+
+    Match match;
+    match.query_index = query_index;
+    match.page_index = GetPageForTextIndex(start).page_index;
+    match.char_index = m_CharIndices[start];
+    match.char_count = m_CharIndices[end] - m_CharIndices[start] + 1;
+    found.emplace_back(start, match);
+  });
+
+  std::sort(found.begin(), found.end(),
+            [](const std::pair<size_t, Match>& a,
+               const std::pair<size_t, Match>& b) {
+              if (a.first != b.first)
+                return a.first < b.first;
+              return a.second.query_index < b.second.query_index;
+            });
+
+  std::vector<Match> results;
+  results.reserve(found.size());
+  for (const auto& item : found)
+    results.push_back(item.second);
+  return results;
+}
+
+const CPDF_TextIndex::PageEntry& CPDF_TextIndex::GetPageForTextIndex(
+    size_t text_index) const {
+  DCHECK(!m_Pages.empty());
+  auto it = std::upper_bound(m_Pages.begin(), m_Pages.end(), text_index,
+                             [](size_t index, const PageEntry& page) {
+                               return index < page.text_start;
+                             });
+  DCHECK(it != m_Pages.begin());
+  return *(it - 1);
+}
@@ -0,0 +1,73 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFTEXT_CPDF_TEXTINDEX_H_
+#define CORE_FPDFTEXT_CPDF_TEXTINDEX_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/fx_string.h"
+
+class CPDF_TextPage;
+
+// Holds the extracted text of many pages of a document so that it can be
+// searched without reloading each page. All queries passed to FindAll() are
+// matched together in a single pass over the text. Queries are literal
+// strings; unlike CPDF_TextPageFind, they are not split into words.
+class CPDF_TextIndex {
+ public:
+  struct Options {
+    bool bMatchCase = false;
+    bool bMatchWholeWord = false;
+    bool bConsecutive = false;
+  };
+
+  struct Match {
+    size_t query_index;
+    int page_index;
+    // In terms of the char indices of the page's CPDF_TextPage.
+    int char_index;
+    int char_count;
+  };
+
+  CPDF_TextIndex();
+  ~CPDF_TextIndex();
+
+  void AddPage(int page_index, const CPDF_TextPage* text_page);
+
+  // |char_indices| maps each character of |text| to a char index on the
+  // page, as CPDF_TextPage::CharIndexFromTextIndex() does.
+  void AddPageText(int page_index,
+                   const WideString& text,
+                   const std::vector<int>& char_indices);
+
+  size_t GetPageCount() const { return m_Pages.size(); }
+
+  // Returns all occurrences of every non-empty query, ordered by page in the
+  // order they were added, then by position, then by query index. Unless
+  // |options.bConsecutive| is set, occurrences of the same query do not
+  // overlap.
+  std::vector<Match> FindAll(const std::vector<WideString>& queries,
+                             const Options& options) const;
+
+ private:
+  struct PageEntry {
+    int page_index;
+    size_t text_start;
+  };
+
+  const PageEntry& GetPageForTextIndex(size_t text_index) const;
+
+  // Text of all pages, joined by a separator that queries never match.
+  WideString m_Text;
+  // Lower-cased copy of |m_Text| for case-insensitive searches.
+  WideString m_FoldedText;
+  // Page char index for each character of |m_Text|, or -1.
+  std::vector<int> m_CharIndices;
+  std::vector<PageEntry> m_Pages;
+};
+
+#endif  // CORE_FPDFTEXT_CPDF_TEXTINDEX_H_
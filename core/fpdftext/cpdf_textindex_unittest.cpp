@@ -0,0 +1,156 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdftext/cpdf_textindex.h"
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+std::vector<int> IdentityCharIndices(const WideString& text) {
+  std::vector<int> char_indices(text.GetLength());
+  for (size_t i = 0; i < char_indices.size(); ++i)
+    char_indices[i] = static_cast<int>(i);
+  return char_indices;
+}
+
+void AddPage(CPDF_TextIndex* index, int page_index, const wchar_t* text) {
+  WideString str(text);
+  index->AddPageText(page_index, str, IdentityCharIndices(str));
+}
+
+}  // namespace
+
+TEST(CPDF_TextIndexTest, Empty) {
+  CPDF_TextIndex index;
+  EXPECT_EQ(0u, index.GetPageCount());
+  EXPECT_TRUE(index.FindAll({L"a"}, CPDF_TextIndex::Options()).empty());
+}
+
+TEST(CPDF_TextIndexTest, MultipleQueriesAcrossPages) {
+  CPDF_TextIndex index;
+  AddPage(&index, 0, L"Hello, world!");
+  AddPage(&index, 1, L"Goodbye, world.");
+  AddPage(&index, 2, L"");
+  AddPage(&index, 3, L"hello again");
+  EXPECT_EQ(4u, index.GetPageCount());
+
+  std::vector<CPDF_TextIndex::Match> matches =
+      index.FindAll({L"world", L"hello", L"missing"}, {});
+  ASSERT_EQ(4u, matches.size());
+
+  EXPECT_EQ(1u, matches[0].query_index);
+  EXPECT_EQ(0, matches[0].page_index);
+  EXPECT_EQ(0, matches[0].char_index);
+  EXPECT_EQ(5, matches[0].char_count);
+
+  EXPECT_EQ(0u, matches[1].query_index);
+  EXPECT_EQ(0, matches[1].page_index);
+  EXPECT_EQ(7, matches[1].char_index);
+  EXPECT_EQ(5, matches[1].char_count);
+
+  EXPECT_EQ(0u, matches[2].query_index);
+  EXPECT_EQ(1, matches[2].page_index);
+  EXPECT_EQ(9, matches[2].char_index);
+
+  EXPECT_EQ(1u, matches[3].query_index);
+  EXPECT_EQ(3, matches[3].page_index);
+  EXPECT_EQ(0, matches[3].char_index);
+}
+
+TEST(CPDF_TextIndexTest, NoMatchAcrossPages) {
+  CPDF_TextIndex index;
+  AddPage(&index, 0, L"abc");
+  AddPage(&index, 1, L"def");
+  EXPECT_TRUE(index.FindAll({L"cd", L"c\nd", L"c d"}, {}).empty());
+}
+
+TEST(CPDF_TextIndexTest, MatchCase) {
+  CPDF_TextIndex index;
+  AddPage(&index, 0, L"PDF pdf Pdf");
+
+  EXPECT_EQ(3u, index.FindAll({L"pdf"}, {}).size());
+
+  CPDF_TextIndex::Options options;
+  options.bMatchCase = true;
+  std::vector<CPDF_TextIndex::Match> matches =
+      index.FindAll({L"pdf"}, options);
+  ASSERT_EQ(1u, matches.size());
+  EXPECT_EQ(4, matches[0].char_index);
+}
+
+TEST(CPDF_TextIndexTest, MatchWholeWord) {
+  CPDF_TextIndex index;
+  AddPage(&index, 0, L"cat concatenate cat.");
+
+  CPDF_TextIndex::Options options;
+  options.bMatchWholeWord = true;
+  std::vector<CPDF_TextIndex::Match> matches =
+      index.FindAll({L"cat"}, options);
+  ASSERT_EQ(2u, matches.size());
+  EXPECT_EQ(0, matches[0].char_index);
+  EXPECT_EQ(16, matches[1].char_index);
+
+  EXPECT_EQ(3u, index.FindAll({L"cat"}, {}).size());
+}
+
+TEST(CPDF_TextIndexTest, Consecutive) {
+  CPDF_TextIndex index;
+  AddPage(&index, 0, L"aaaa");
+
+  std::vector<CPDF_TextIndex::Match> matches = index.FindAll({L"aa"}, {});
+  ASSERT_EQ(2u, matches.size());
+  EXPECT_EQ(0, matches[0].char_index);
+  EXPECT_EQ(2, matches[1].char_index);
+
+  CPDF_TextIndex::Options options;
+  options.bConsecutive = true;
+  matches = index.FindAll({L"aa"}, options);
+  ASSERT_EQ(3u, matches.size());
+  EXPECT_EQ(0, matches[0].char_index);
+  EXPECT_EQ(1, matches[1].char_index);
+  EXPECT_EQ(2, matches[2].char_index);
+}
+
+TEST(CPDF_TextIndexTest, OverlappingQueries) {
+  CPDF_TextIndex index;
+  AddPage(&index, 0, L"ushers");
+
+  std::vector<CPDF_TextIndex::Match> matches =
+      index.FindAll({L"he", L"she", L"his", L"hers", L""}, {});
+  ASSERT_EQ(3u, matches.size());
+  EXPECT_EQ(1u, matches[0].query_index);
+  EXPECT_EQ(1, matches[0].char_index);
+  EXPECT_EQ(0u, matches[1].query_index);
+  EXPECT_EQ(2, matches[1].char_index);
+  EXPECT_EQ(3u, matches[2].query_index);
+  EXPECT_EQ(2, matches[2].char_index);
+  EXPECT_EQ(4, matches[2].char_count);
+}
+
+TEST(CPDF_TextIndexTest, DuplicateQueries) {
+  CPDF_TextIndex index;
+  AddPage(&index, 0, L"abc");
+
+  std::vector<CPDF_TextIndex::Match> matches =
+      index.FindAll({L"b", L"B"}, {});
+  ASSERT_EQ(2u, matches.size());
+  EXPECT_EQ(0u, matches[0].query_index);
+  EXPECT_EQ(1u, matches[1].query_index);
+}
+
+TEST(CPDF_TextIndexTest, CharIndexMapping) {
+  CPDF_TextIndex index;
+  // Text index 3 starts a new run of chars that skips char index 3, as happens
+  // when a page contains a control character.
+  index.AddPageText(7, L"abcdef", {0, 1, 2, 4, 5, 6});
+
+  std::vector<CPDF_TextIndex::Match> matches = index.FindAll({L"cde"}, {});
+  ASSERT_EQ(1u, matches.size());
+  EXPECT_EQ(7, matches[0].page_index);
+  EXPECT_EQ(2, matches[0].char_index);
+  EXPECT_EQ(4, matches[0].char_count);
+}
@@ -7,6 +7,7 @@
 #include "core/fpdftext/cpdf_textpage.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -318,6 +319,19 @@ void CPDF_TextPage::Init() {
   }
   if (m_CharIndices.size() % 2)
     m_CharIndices.pop_back();
+
+  std::map<const CPDF_Font*, int> font_ids;
+  m_CharFontIds.reserve(m_CharList.size());
+  for (const CharInfo& charinfo : m_CharList) {
+    const CPDF_Font* font =
+        charinfo.m_pTextObj ? charinfo.m_pTextObj->GetFont().Get() : nullptr;
+    if (!font) {
+      m_CharFontIds.push_back(-1);
+      continue;
+    }
+    auto result = font_ids.emplace(font, fxcrt::CollectionSize<int>(font_ids));
+    m_CharFontIds.push_back(result.first->second);
+  }
 }
 
 int CPDF_TextPage::CountChars() const {
@@ -483,6 +497,11 @@ float CPDF_TextPage::GetCharFontSize(size_t index) const {
   return GetFontSize(m_CharList[index].m_pTextObj.Get());
 }
 
+int CPDF_TextPage::GetCharFontId(size_t index) const {
+  CHECK(index < m_CharFontIds.size());
+  return m_CharFontIds[index];
+}
+
 CFX_FloatRect CPDF_TextPage::GetCharLooseBounds(size_t index) const {
   return GetLooseBounds(GetCharInfo(index));
 }
@@ -18,6 +18,7 @@
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "third_party/base/optional.h"
+#include "third_party/base/span.h"
 
 class CPDF_FormObject;
 class CPDF_Page;
@@ -62,6 +63,14 @@ class CPDF_TextPage {
   float GetCharFontSize(size_t index) const;
   CFX_FloatRect GetCharLooseBounds(size_t index) const;
 
+  // Returns a small non-negative number identifying the font of the char at
+  // |index|, which is the same for all chars of the page using that font, or
+  // -1 if the char has no font. Ids are assigned in order of first use.
+  int GetCharFontId(size_t index) const;
+
+  // All chars of the page, stored contiguously.
+  pdfium::span<const CharInfo> GetCharInfos() const { return m_CharList; }
+
   std::vector<CFX_FloatRect> GetRectArray(int start, int count) const;
   int GetIndexAtPos(const CFX_PointF& point, const CFX_SizeF& tolerance) const;
   WideString GetTextByRect(const CFX_FloatRect& rect) const;
@@ -136,8 +145,10 @@ class CPDF_TextPage {
 
   UnownedPtr<const CPDF_Page> const m_pPage;
   std::vector<uint16_t, FxAllocAllocator<uint16_t>> m_CharIndices;
-  std::deque<CharInfo> m_CharList;
+  std::vector<CharInfo> m_CharList;
   std::deque<CharInfo> m_TempCharList;
+  // Parallel to |m_CharList|.
+  std::vector<int> m_CharFontIds;
   CFX_WideTextBuf m_TextBuf;
   CFX_WideTextBuf m_TempTextBuf;
   UnownedPtr<const CPDF_TextObject> m_pPrevTextObj;
@@ -37,51 +37,6 @@ bool IsIgnoreSpaceCharacter(wchar_t curChar) {
   return true;
 }
 
-bool IsMatchWholeWord(const WideString& csPageText,
-                      size_t startPos,
-                      size_t endPos) {
-  if (startPos > endPos)
-    return false;
-  wchar_t char_left = 0;
-  wchar_t char_right = 0;
-  size_t char_count = endPos - startPos + 1;
-  if (char_count == 0)
-    return false;
-  if (char_count == 1 && csPageText[startPos] > 255)
-    return true;
-  if (startPos >= 1)
-    char_left = csPageText[startPos - 1];
-  if (startPos + char_count < csPageText.GetLength())
-    char_right = csPageText[startPos + char_count];
-  if ((char_left > 'A' && char_left < 'a') ||
-      (char_left > 'a' && char_left < 'z') ||
-      (char_left > 0xfb00 && char_left < 0xfb06) ||
-      FXSYS_IsDecimalDigit(char_left) ||
-      (char_right > 'A' && char_right < 'a') ||
-      (char_right > 'a' && char_right < 'z') ||
-      (char_right > 0xfb00 && char_right < 0xfb06) ||
-      FXSYS_IsDecimalDigit(char_right)) {
-    return false;
-  }
-  if (!(('A' > char_left || char_left > 'Z') &&
-        ('a' > char_left || char_left > 'z') &&
-        ('A' > char_right || char_right > 'Z') &&
-        ('a' > char_right || char_right > 'z'))) {
-    return false;
-  }
-  if (char_count > 0) {
-    if (FXSYS_IsDecimalDigit(char_left) &&
-        FXSYS_IsDecimalDigit(csPageText[startPos])) {
-      return false;
-    }
-    if (FXSYS_IsDecimalDigit(char_right) &&
-        FXSYS_IsDecimalDigit(csPageText[endPos])) {
-      return false;
-    }
-  }
-  return true;
-}
-
 WideString GetStringCase(const WideString& wsOriginal, bool bMatchCase) {
   if (bMatchCase)
     return wsOriginal;
@@ -185,6 +140,52 @@ std::unique_ptr<CPDF_TextPageFind> CPDF_TextPageFind::Create(
   return find;
 }
 
+// static
+bool CPDF_TextPageFind::IsMatchWholeWord(const WideString& csPageText,
+                                         size_t startPos,
+                                         size_t endPos) {
+  if (startPos > endPos)
+    return false;
+  wchar_t char_left = 0;
+  wchar_t char_right = 0;
+  size_t char_count = endPos - startPos + 1;
+  if (char_count == 0)
+    return false;
+  if (char_count == 1 && csPageText[startPos] > 255)
+    return true;
+  if (startPos >= 1)
+    char_left = csPageText[startPos - 1];
+  if (startPos + char_count < csPageText.GetLength())
+    char_right = csPageText[startPos + char_count];
+  if ((char_left > 'A' && char_left < 'a') ||
+      (char_left > 'a' && char_left < 'z') ||
+      (char_left > 0xfb00 && char_left < 0xfb06) ||
+      FXSYS_IsDecimalDigit(char_left) ||
+      (char_right > 'A' && char_right < 'a') ||
+      (char_right > 'a' && char_right < 'z') ||
+      (char_right > 0xfb00 && char_right < 0xfb06) ||
+      FXSYS_IsDecimalDigit(char_right)) {
+    return false;
+  }
+  if (!(('A' > char_left || char_left > 'Z') &&
+        ('a' > char_left || char_left > 'z') &&
+        ('A' > char_right || char_right > 'Z') &&
+        ('a' > char_right || char_right > 'z'))) {
+    return false;
+  }
+  if (char_count > 0) {
+    if (FXSYS_IsDecimalDigit(char_left) &&
+        FXSYS_IsDecimalDigit(csPageText[startPos])) {
+      return false;
+    }
+    if (FXSYS_IsDecimalDigit(char_right) &&
+        FXSYS_IsDecimalDigit(csPageText[endPos])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 CPDF_TextPageFind::CPDF_TextPageFind(
     const CPDF_TextPage* pTextPage,
     const std::vector<WideString>& findwhat_array,
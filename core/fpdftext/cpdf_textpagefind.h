@@ -32,6 +32,12 @@ class CPDF_TextPageFind {
       const Options& options,
       Optional<size_t> startPos);
 
+  // Returns whether the characters of |csPageText| from |startPos| to |endPos|
+  // inclusive are not part of a longer word.
+  static bool IsMatchWholeWord(const WideString& csPageText,
+                               size_t startPos,
+                               size_t endPos);
+
   ~CPDF_TextPageFind();
 
   bool FindNext();
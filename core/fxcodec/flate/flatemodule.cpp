@@ -864,4 +864,43 @@ bool FlateModule::Encode(const uint8_t* src_buf,
   return true;
 }
 
+void FlateStreamDecoder::ContextDeleter::operator()(
+    z_stream_s* context) const {
+  FlateEnd(context);
+}
+
+FlateStreamDecoder::FlateStreamDecoder() : m_pContext(FlateInit()) {}
+
+FlateStreamDecoder::~FlateStreamDecoder() = default;
+
+bool FlateStreamDecoder::NeedsInput() const {
+  return m_pContext->avail_in == 0;
+}
+
+void FlateStreamDecoder::SetInput(pdfium::span<const uint8_t> src_span) {
+  DCHECK(NeedsInput());
+  FlateInput(m_pContext.get(), src_span);
+}
+
+size_t FlateStreamDecoder::Decode(pdfium::span<uint8_t> dest_span) {
+  if (m_bDone || dest_span.empty())
+    return 0;
+
+  uint32_t total_out = FlateGetPossiblyTruncatedTotalOut(m_pContext.get());
+  uint32_t dest_size = std::min<size_t>(dest_span.size(),
+                                        kMaxTotalOutSize - total_out);
+  m_pContext->next_out = dest_span.data();
+  m_pContext->avail_out = dest_size;
+  // Even with all input consumed, inflate() may still hold decoded data.
+  int ret = inflate(m_pContext.get(), Z_SYNC_FLUSH);
+  size_t written = dest_size - m_pContext->avail_out;
+
+  // Like FlateUncompress(), keep whatever was decoded before an error.
+  if ((ret != Z_OK && ret != Z_BUF_ERROR) ||
+      FlateGetPossiblyTruncatedTotalOut(m_pContext.get()) >= kMaxTotalOutSize) {
+    m_bDone = true;
+  }
+  return written;
+}
+
 }  // namespace fxcodec
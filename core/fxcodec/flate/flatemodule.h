@@ -13,6 +13,8 @@
 #include "core/fxcrt/fx_system.h"
 #include "third_party/base/span.h"
 
+struct z_stream_s;
+
 namespace fxcodec {
 
 class ScanlineDecoder;
@@ -52,8 +54,42 @@ class FlateModule {
   FlateModule& operator=(const FlateModule&) = delete;
 };
 
+// Inflates FlateDecode data that arrives in pieces, so that neither the whole
+// compressed nor the whole decompressed data needs to be in memory at once.
+// Predictors are not applied.
+class FlateStreamDecoder {
+ public:
+  FlateStreamDecoder();
+  FlateStreamDecoder(const FlateStreamDecoder&) = delete;
+  FlateStreamDecoder& operator=(const FlateStreamDecoder&) = delete;
+  ~FlateStreamDecoder();
+
+  // Returns true once all input passed to SetInput() has been consumed.
+  bool NeedsInput() const;
+
+  // |src_span| must outlive the Decode() calls that consume it.
+  void SetInput(pdfium::span<const uint8_t> src_span);
+
+  // Writes up to |dest_span|.size() bytes and returns how many were written.
+  // Returns 0 once all input is decoded and more is needed, or when the data
+  // has ended. Decoded data may still be pending when NeedsInput() is true.
+  size_t Decode(pdfium::span<uint8_t> dest_span);
+
+  // True once the end of the compressed data, or corrupt data, is reached.
+  bool IsDone() const { return m_bDone; }
+
+ private:
+  struct ContextDeleter {
+    void operator()(z_stream_s* context) const;
+  };
+
+  std::unique_ptr<z_stream_s, ContextDeleter> const m_pContext;
+  bool m_bDone = false;
+};
+
 }  // namespace fxcodec
 
 using FlateModule = fxcodec::FlateModule;
+using FlateStreamDecoder = fxcodec::FlateStreamDecoder;
 
 #endif  // CORE_FXCODEC_FLATE_FLATEMODULE_H_
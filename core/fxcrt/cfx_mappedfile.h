@@ -0,0 +1,34 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_CFX_MAPPEDFILE_H_
+#define CORE_FXCRT_CFX_MAPPEDFILE_H_
+
+#include <stdint.h>
+
+#include "core/fxcrt/observed_ptr.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "third_party/base/span.h"
+
+// The whole contents of a file, mapped read-only into memory. The operating
+// system shares the pages between every mapping of the file, and can drop
+// them under memory pressure since they are backed by the file.
+class CFX_MappedFile final : public Retainable, public Observable {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // Returns nullptr if the file cannot be opened or is empty.
+  static RetainPtr<CFX_MappedFile> Open(const char* path);
+
+  ~CFX_MappedFile() override;
+
+  pdfium::span<const uint8_t> GetSpan() const { return m_Span; }
+
+ private:
+  explicit CFX_MappedFile(pdfium::span<const uint8_t> span);
+
+  const pdfium::span<const uint8_t> m_Span;
+};
+
+#endif  // CORE_FXCRT_CFX_MAPPEDFILE_H_
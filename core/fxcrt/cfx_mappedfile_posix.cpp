@@ -0,0 +1,43 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_mappedfile.h"
+
+#include "build/build_config.h"
+
+#if defined(OS_WIN)
+#error "built on wrong platform"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// static
+RetainPtr<CFX_MappedFile> CFX_MappedFile::Open(const char* path) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat info;
+  void* data = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && info.st_size > 0)
+    data = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+  // The mapping stays valid after the file is closed.
+  close(fd);
+  if (data == MAP_FAILED)
+    return nullptr;
+
+  return pdfium::MakeRetain<CFX_MappedFile>(pdfium::make_span(
+      static_cast<const uint8_t*>(data), static_cast<size_t>(info.st_size)));
+}
+
+CFX_MappedFile::CFX_MappedFile(pdfium::span<const uint8_t> span)
+    : m_Span(span) {}
+
+CFX_MappedFile::~CFX_MappedFile() {
+  munmap(const_cast<uint8_t*>(m_Span.data()), m_Span.size());
+}
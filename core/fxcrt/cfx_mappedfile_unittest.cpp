@@ -0,0 +1,40 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_mappedfile.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/path_service.h"
+
+TEST(CFX_MappedFile, Open) {
+  std::string file_path;
+  ASSERT_TRUE(PathService::GetTestFilePath("hello_world.pdf", &file_path));
+
+  FILE* file = fopen(file_path.c_str(), "rb");
+  ASSERT_TRUE(file);
+  fseek(file, 0, SEEK_END);
+  std::vector<uint8_t> contents(ftell(file));
+  fseek(file, 0, SEEK_SET);
+  ASSERT_EQ(1u, fread(contents.data(), contents.size(), 1, file));
+  fclose(file);
+
+  RetainPtr<CFX_MappedFile> mapped_file =
+      CFX_MappedFile::Open(file_path.c_str());
+  ASSERT_TRUE(mapped_file);
+  pdfium::span<const uint8_t> span = mapped_file->GetSpan();
+  ASSERT_EQ(contents.size(), span.size());
+  EXPECT_EQ(0, memcmp(contents.data(), span.data(), span.size()));
+}
+
+TEST(CFX_MappedFile, OpenNonexistent) {
+  std::string file_path;
+  ASSERT_TRUE(PathService::GetTestFilePath("nonexistent.pdf", &file_path));
+  EXPECT_FALSE(CFX_MappedFile::Open(file_path.c_str()));
+}
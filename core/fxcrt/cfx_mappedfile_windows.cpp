@@ -0,0 +1,48 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_mappedfile.h"
+
+#include "build/build_config.h"
+#include "core/fxcrt/fx_system.h"
+
+#if !defined(OS_WIN)
+#error "built on wrong platform"
+#endif
+
+// static
+RetainPtr<CFX_MappedFile> CFX_MappedFile::Open(const char* path) {
+  HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return nullptr;
+
+  LARGE_INTEGER size;
+  HANDLE mapping = nullptr;
+  if (::GetFileSizeEx(file, &size) && size.QuadPart > 0 &&
+      static_cast<uint64_t>(size.QuadPart) <= SIZE_MAX) {
+    mapping =
+        ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  }
+  ::CloseHandle(file);
+  if (!mapping)
+    return nullptr;
+
+  // The view stays valid after both handles are closed.
+  void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  ::CloseHandle(mapping);
+  if (!data)
+    return nullptr;
+
+  return pdfium::MakeRetain<CFX_MappedFile>(
+      pdfium::make_span(static_cast<const uint8_t*>(data),
+                        static_cast<size_t>(size.QuadPart)));
+}
+
+CFX_MappedFile::CFX_MappedFile(pdfium::span<const uint8_t> span)
+    : m_Span(span) {}
+
+CFX_MappedFile::~CFX_MappedFile() {
+  ::UnmapViewOfFile(m_Span.data());
+}
@@ -0,0 +1,271 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/agg/cfx_agg_coveragecache.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "third_party/base/check.h"
+#include "third_party/base/check_op.h"
+
+namespace pdfium {
+
+namespace {
+
+// Translations this large put the path far outside any device.
+constexpr float kMaxOffset = 1 << 20;
+
+// Bounds |m_SeenHashes|; clearing it only delays recording.
+constexpr size_t kMaxSeenHashes = 4096;
+
+size_t HashBytes(size_t hash, const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i)
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  return hash;
+}
+
+template <typename T>
+size_t HashValue(size_t hash, T value) {
+  return HashBytes(hash, &value, sizeof(value));
+}
+
+bool GraphStatesEqual(const CFX_GraphStateData& a,
+                      const CFX_GraphStateData& b) {
+  return a.m_LineCap == b.m_LineCap && a.m_LineJoin == b.m_LineJoin &&
+         a.m_DashPhase == b.m_DashPhase && a.m_MiterLimit == b.m_MiterLimit &&
+         a.m_LineWidth == b.m_LineWidth && a.m_DashArray == b.m_DashArray;
+}
+
+// Splits |value| into a whole-pixel offset and a sub-pixel fraction.
+void SplitTranslation(float value, int* offset, int* frac) {
+  float whole = floorf(value);
+  *offset = static_cast<int>(whole);
+  *frac = static_cast<int>(lroundf((value - whole) * 256));
+  if (*frac == 256) {
+    ++*offset;
+    *frac = 0;
+  }
+}
+
+}  // namespace
+
+struct CFX_AggCoverageCache::Entry {
+  size_t hash;
+  size_t bytes;
+  std::vector<CFX_Path::Point> points;
+  CFX_GraphStateData graph_state;
+  float matrix[4];
+  int frac_x;
+  int frac_y;
+  uint32_t flags;
+  Mask mask;
+  ClipLayer layer;
+};
+
+CFX_AggCoverageCache::Key::Key(const CFX_Path* path,
+                               const CFX_Matrix* object_to_device,
+                               const CFX_GraphStateData* graph_state,
+                               const CFX_FillRenderOptions& fill_options,
+                               Mode mode)
+    : m_Points(path->GetPoints()),
+      m_pGraphState(mode == Mode::kFill || mode == Mode::kClip ? nullptr
+                                                                : graph_state) {
+  if (m_Points.size() < kMinPointCount)
+    return;
+
+  CFX_Matrix matrix = object_to_device ? *object_to_device : CFX_Matrix();
+  if (!(fabsf(matrix.e) < kMaxOffset && fabsf(matrix.f) < kMaxOffset))
+    return;
+
+  m_Matrix[0] = matrix.a;
+  m_Matrix[1] = matrix.b;
+  m_Matrix[2] = matrix.c;
+  m_Matrix[3] = matrix.d;
+  SplitTranslation(matrix.e, &m_OffsetX, &m_FracX);
+  SplitTranslation(matrix.f, &m_OffsetY, &m_FracY);
+  m_Flags = static_cast<uint32_t>(mode) |
+            static_cast<uint32_t>(fill_options.fill_type) << 2 |
+            static_cast<uint32_t>(fill_options.aliased_path) << 4 |
+            static_cast<uint32_t>(fill_options.stroke_text_mode) << 5;
+
+  size_t hash = 14695981039346656037ull;
+  for (const CFX_Path::Point& point : m_Points) {
+    hash = HashValue(hash, point.m_Point.x);
+    hash = HashValue(hash, point.m_Point.y);
+    hash = HashValue(hash, point.m_Type);
+    hash = HashValue(hash, point.m_CloseFigure);
+  }
+  hash = HashBytes(hash, m_Matrix, sizeof(m_Matrix));
+  hash = HashValue(hash, m_FracX);
+  hash = HashValue(hash, m_FracY);
+  hash = HashValue(hash, m_Flags);
+  if (m_pGraphState)
+    hash = HashValue(hash, m_pGraphState->m_LineWidth);
+  m_Hash = hash;
+  m_bCacheable = true;
+}
+
+CFX_AggCoverageCache::Key::~Key() = default;
+
+CFX_AggCoverageCache::Mask::Mask() = default;
+
+CFX_AggCoverageCache::Mask::Mask(Mask&& that) noexcept = default;
+
+CFX_AggCoverageCache::Mask::~Mask() = default;
+
+CFX_AggCoverageCache::Mask& CFX_AggCoverageCache::Mask::operator=(
+    Mask&& that) noexcept = default;
+
+void CFX_AggCoverageCache::Mask::AddSpan(int y,
+                                         int x,
+                                         pdfium::span<const uint8_t> covers) {
+  DCHECK(!covers.empty());
+  int len = static_cast<int>(covers.size());
+  if (m_Rows.empty()) {
+    m_BBox = FX_RECT(x, y, x + len, y + 1);
+  } else {
+    DCHECK_GE(y, m_Rows.back().y);
+    m_BBox.left = std::min(m_BBox.left, x);
+    m_BBox.right = std::max(m_BBox.right, x + len);
+    m_BBox.bottom = y + 1;
+  }
+  if (m_Rows.empty() || m_Rows.back().y != y)
+    m_Rows.push_back({y, m_Spans.size(), m_Spans.size()});
+  m_Spans.push_back({x, len, m_Covers.size()});
+  m_Rows.back().span_end = m_Spans.size();
+  m_Covers.insert(m_Covers.end(), covers.begin(), covers.end());
+}
+
+size_t CFX_AggCoverageCache::Mask::GetBytes() const {
+  return m_Rows.size() * sizeof(Row) + m_Spans.size() * sizeof(Span) +
+         m_Covers.size();
+}
+
+CFX_AggCoverageCache::ClipLayer::ClipLayer() = default;
+
+CFX_AggCoverageCache::ClipLayer::ClipLayer(int left,
+                                           int top,
+                                           RetainPtr<CFX_DIBitmap> bitmap)
+    : left(left), top(top), bitmap(std::move(bitmap)) {}
+
+CFX_AggCoverageCache::ClipLayer::ClipLayer(const ClipLayer& that) = default;
+
+CFX_AggCoverageCache::ClipLayer::~ClipLayer() = default;
+
+CFX_AggCoverageCache::ClipLayer& CFX_AggCoverageCache::ClipLayer::operator=(
+    const ClipLayer& that) = default;
+
+CFX_AggCoverageCache::CFX_AggCoverageCache(size_t max_bytes)
+    : m_MaxBytes(max_bytes) {}
+
+CFX_AggCoverageCache::~CFX_AggCoverageCache() = default;
+
+const CFX_AggCoverageCache::Mask* CFX_AggCoverageCache::Lookup(
+    const Key& key) {
+  Entry* entry = FindEntry(key);
+  return entry ? &entry->mask : nullptr;
+}
+
+const CFX_AggCoverageCache::ClipLayer* CFX_AggCoverageCache::LookupClipLayer(
+    const Key& key) {
+  Entry* entry = FindEntry(key);
+  return entry && entry->layer.bitmap ? &entry->layer : nullptr;
+}
+
+bool CFX_AggCoverageCache::ShouldRecord(const Key& key) {
+  DCHECK(key.IsCacheable());
+  if (m_SeenHashes.size() >= kMaxSeenHashes)
+    m_SeenHashes.clear();
+  return !m_SeenHashes.insert(key.hash()).second;
+}
+
+void CFX_AggCoverageCache::Add(const Key& key, Mask mask) {
+  DCHECK(key.IsCacheable());
+  if (mask.IsEmpty())
+    return;
+
+  Entry* entry = AddEntry(key, mask.GetBytes());
+  if (entry)
+    entry->mask = std::move(mask);
+}
+
+void CFX_AggCoverageCache::AddClipLayer(const Key& key,
+                                        const ClipLayer& layer) {
+  DCHECK(key.IsCacheable());
+  DCHECK(layer.bitmap);
+  size_t layer_bytes =
+      static_cast<size_t>(layer.bitmap->GetPitch()) * layer.bitmap->GetHeight();
+  Entry* entry = AddEntry(key, layer_bytes);
+  if (entry)
+    entry->layer = layer;
+}
+
+CFX_AggCoverageCache::Entry* CFX_AggCoverageCache::FindEntry(const Key& key) {
+  DCHECK(key.IsCacheable());
+  auto it = m_EntryMap.find(key.hash());
+  if (it == m_EntryMap.end() || !Matches(*it->second, key))
+    return nullptr;
+
+  m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+  return &*it->second;
+}
+
+CFX_AggCoverageCache::Entry* CFX_AggCoverageCache::AddEntry(
+    const Key& key,
+    size_t data_bytes) {
+  size_t bytes = data_bytes +
+                 key.m_Points.size() * sizeof(CFX_Path::Point) + sizeof(Entry);
+  if (bytes > m_MaxBytes / 4)
+    return nullptr;
+
+  auto map_it = m_EntryMap.find(key.hash());
+  if (map_it != m_EntryMap.end()) {
+    m_CachedBytes -= map_it->second->bytes;
+    m_Entries.erase(map_it->second);
+    m_EntryMap.erase(map_it);
+  }
+  while (!m_Entries.empty() && m_CachedBytes + bytes > m_MaxBytes) {
+    const Entry& victim = m_Entries.back();
+    m_CachedBytes -= victim.bytes;
+    m_EntryMap.erase(victim.hash);
+    m_Entries.pop_back();
+  }
+
+  m_Entries.emplace_front();
+  Entry& entry = m_Entries.front();
+  entry.hash = key.hash();
+  entry.bytes = bytes;
+  entry.points.assign(key.m_Points.begin(), key.m_Points.end());
+  if (key.m_pGraphState)
+    entry.graph_state = *key.m_pGraphState;
+  memcpy(entry.matrix, key.m_Matrix, sizeof(entry.matrix));
+  entry.frac_x = key.m_FracX;
+  entry.frac_y = key.m_FracY;
+  entry.flags = key.m_Flags;
+  m_EntryMap[entry.hash] = m_Entries.begin();
+  m_CachedBytes += bytes;
+  return &entry;
+}
+
+// static
+bool CFX_AggCoverageCache::Matches(const Entry& entry, const Key& key) {
+  if (entry.flags != key.m_Flags || entry.frac_x != key.m_FracX ||
+      entry.frac_y != key.m_FracY ||
+      memcmp(entry.matrix, key.m_Matrix, sizeof(entry.matrix)) != 0 ||
+      entry.points.size() != key.m_Points.size() ||
+      !std::equal(entry.points.begin(), entry.points.end(),
+                  key.m_Points.begin())) {
+    return false;
+  }
+  return !key.m_pGraphState ||
+         GraphStatesEqual(entry.graph_state, *key.m_pGraphState);
+}
+
+}  // namespace pdfium
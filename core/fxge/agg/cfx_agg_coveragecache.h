@@ -0,0 +1,172 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_AGG_CFX_AGG_COVERAGECACHE_H_
+#define CORE_FXGE_AGG_CFX_AGG_COVERAGECACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/cfx_fillrenderoptions.h"
+#include "core/fxge/cfx_graphstatedata.h"
+#include "core/fxge/cfx_path.h"
+#include "third_party/base/span.h"
+
+class CFX_DIBitmap;
+
+namespace pdfium {
+
+// Remembers the anti-aliased coverage that the AGG rasterizer produced for a
+// path, so that drawing the same path again at a device matrix that differs
+// only by a whole-pixel translation can skip path building and rasterization.
+// Masks are stored relative to the integer part of the matrix translation.
+// Clip paths are kept as the 8-bit layers that get intersected with the clip
+// region instead, so that they can be shared by the clip regions using them.
+class CFX_AggCoverageCache {
+ public:
+  // kClip is a fill that is rendered into a clip mask rather than the device.
+  enum class Mode : uint8_t { kFill, kStroke, kZeroAreaStroke, kClip };
+
+  // Describes one rasterization. Does not own anything it points to.
+  class Key {
+   public:
+    Key(const CFX_Path* path,
+        const CFX_Matrix* object_to_device,
+        const CFX_GraphStateData* graph_state,
+        const CFX_FillRenderOptions& fill_options,
+        Mode mode);
+    ~Key();
+
+    // False for paths too small to be worth caching, or translations too
+    // large to split into whole and sub-pixel parts.
+    bool IsCacheable() const { return m_bCacheable; }
+    int offset_x() const { return m_OffsetX; }
+    int offset_y() const { return m_OffsetY; }
+    size_t hash() const { return m_Hash; }
+
+   private:
+    friend class CFX_AggCoverageCache;
+
+    pdfium::span<const CFX_Path::Point> m_Points;
+    const CFX_GraphStateData* const m_pGraphState;
+    // Matrix with the translation reduced to its sub-pixel part, in 1/256ths
+    // of a pixel to match the precision of the rasterizer.
+    float m_Matrix[4] = {};
+    int m_FracX = 0;
+    int m_FracY = 0;
+    int m_OffsetX = 0;
+    int m_OffsetY = 0;
+    uint32_t m_Flags = 0;
+    size_t m_Hash = 0;
+    bool m_bCacheable = false;
+  };
+
+  // Coverage rows of one rasterized path.
+  class Mask {
+   public:
+    struct Span {
+      int x;
+      int len;
+      size_t cover_offset;
+    };
+    struct Row {
+      int y;
+      size_t span_begin;
+      size_t span_end;
+    };
+
+    Mask();
+    Mask(Mask&& that) noexcept;
+    ~Mask();
+
+    Mask& operator=(Mask&& that) noexcept;
+
+    // Rows must be added in increasing |y| order, and spans within a row in
+    // increasing |x| order.
+    void AddSpan(int y, int x, pdfium::span<const uint8_t> covers);
+
+    bool IsEmpty() const { return m_Rows.empty(); }
+    const FX_RECT& bbox() const { return m_BBox; }
+    const std::vector<Row>& rows() const { return m_Rows; }
+    const std::vector<Span>& spans() const { return m_Spans; }
+    const uint8_t* GetCovers(const Span& span) const {
+      return m_Covers.data() + span.cover_offset;
+    }
+    size_t GetBytes() const;
+
+   private:
+    FX_RECT m_BBox;
+    std::vector<Row> m_Rows;
+    std::vector<Span> m_Spans;
+    std::vector<uint8_t> m_Covers;
+  };
+
+  // A rendered clip path. |left| and |top| are relative to the integer offset
+  // of the key it was added with. |bitmap| must not be modified.
+  struct ClipLayer {
+    ClipLayer();
+    ClipLayer(int left, int top, RetainPtr<CFX_DIBitmap> bitmap);
+    ClipLayer(const ClipLayer& that);
+    ~ClipLayer();
+
+    ClipLayer& operator=(const ClipLayer& that);
+
+    int left = 0;
+    int top = 0;
+    RetainPtr<CFX_DIBitmap> bitmap;
+  };
+
+  // Paths with fewer points are cheaper to rasterize than to look up.
+  static constexpr size_t kMinPointCount = 8;
+  static constexpr size_t kDefaultMaxBytes = 4 * 1024 * 1024;
+
+  explicit CFX_AggCoverageCache(size_t max_bytes);
+  ~CFX_AggCoverageCache();
+
+  // Returns the mask previously added for |key|, or nullptr.
+  const Mask* Lookup(const Key& key);
+
+  // Returns true when |key| has been seen before, so that the mask about to be
+  // rasterized is worth keeping. Paths drawn only once are never stored.
+  bool ShouldRecord(const Key& key);
+
+  // Stores |mask|, which was rasterized at |key|'s integer offset, evicting
+  // the least recently used masks as needed to stay within the byte budget.
+  void Add(const Key& key, Mask mask);
+
+  // Same as Lookup() and Add(), for keys using Mode::kClip.
+  const ClipLayer* LookupClipLayer(const Key& key);
+  void AddClipLayer(const Key& key, const ClipLayer& layer);
+
+  size_t GetCachedBytes() const { return m_CachedBytes; }
+  size_t GetMaskCount() const { return m_Entries.size(); }
+
+ private:
+  struct Entry;
+
+  static bool Matches(const Entry& entry, const Key& key);
+
+  Entry* FindEntry(const Key& key);
+  // Makes room for and inserts an entry for |key| whose data takes
+  // |data_bytes|. Returns nullptr if that is too large to cache.
+  Entry* AddEntry(const Key& key, size_t data_bytes);
+
+  const size_t m_MaxBytes;
+  size_t m_CachedBytes = 0;
+  // Most recently used first.
+  std::list<Entry> m_Entries;
+  std::map<size_t, std::list<Entry>::iterator> m_EntryMap;
+  std::set<size_t> m_SeenHashes;
+};
+
+}  // namespace pdfium
+
+#endif  // CORE_FXGE_AGG_CFX_AGG_COVERAGECACHE_H_
@@ -0,0 +1,191 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/agg/cfx_agg_coveragecache.h"
+
+#include <vector>
+
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace pdfium {
+
+namespace {
+
+CFX_Path MakeTwoRectPath() {
+  CFX_Path path;
+  path.AppendRect(0, 0, 10, 10);
+  path.AppendRect(20, 0, 30, 10);
+  return path;
+}
+
+CFX_AggCoverageCache::Mask MakeMask(int width) {
+  CFX_AggCoverageCache::Mask mask;
+  std::vector<uint8_t> covers(width, 0xff);
+  mask.AddSpan(0, 0, covers);
+  mask.AddSpan(1, 0, covers);
+  return mask;
+}
+
+}  // namespace
+
+TEST(CFX_AggCoverageCache, Key) {
+  CFX_Path path = MakeTwoRectPath();
+  CFX_FillRenderOptions options = CFX_FillRenderOptions::WindingOptions();
+  const CFX_Matrix matrix(2, 0, 0, 2, 100.25f, -50.5f);
+  CFX_AggCoverageCache::Key key(&path, &matrix, nullptr, options,
+                                CFX_AggCoverageCache::Mode::kFill);
+  ASSERT_TRUE(key.IsCacheable());
+  EXPECT_EQ(100, key.offset_x());
+  EXPECT_EQ(-51, key.offset_y());
+
+  const CFX_Matrix moved(2, 0, 0, 2, 7.25f, 3.5f);
+  CFX_AggCoverageCache::Key moved_key(&path, &moved, nullptr, options,
+                                      CFX_AggCoverageCache::Mode::kFill);
+  ASSERT_TRUE(moved_key.IsCacheable());
+  EXPECT_EQ(key.hash(), moved_key.hash());
+
+  const CFX_Matrix subpixel(2, 0, 0, 2, 100.75f, -50.5f);
+  CFX_AggCoverageCache::Key subpixel_key(&path, &subpixel, nullptr, options,
+                                         CFX_AggCoverageCache::Mode::kFill);
+  EXPECT_NE(key.hash(), subpixel_key.hash());
+
+  CFX_Path small_path;
+  small_path.AppendRect(0, 0, 10, 10);
+  CFX_AggCoverageCache::Key small_key(&small_path, &matrix, nullptr, options,
+                                      CFX_AggCoverageCache::Mode::kFill);
+  EXPECT_FALSE(small_key.IsCacheable());
+
+  const CFX_Matrix far_away(1, 0, 0, 1, 1e9f, 0);
+  CFX_AggCoverageCache::Key far_key(&path, &far_away, nullptr, options,
+                                    CFX_AggCoverageCache::Mode::kFill);
+  EXPECT_FALSE(far_key.IsCacheable());
+}
+
+TEST(CFX_AggCoverageCache, Mask) {
+  CFX_AggCoverageCache::Mask mask;
+  EXPECT_TRUE(mask.IsEmpty());
+
+  const uint8_t kCovers1[] = {10, 20, 30};
+  const uint8_t kCovers2[] = {40};
+  const uint8_t kCovers3[] = {50, 60};
+  mask.AddSpan(5, 2, kCovers1);
+  mask.AddSpan(5, 8, kCovers2);
+  mask.AddSpan(7, 1, kCovers3);
+  EXPECT_FALSE(mask.IsEmpty());
+  EXPECT_EQ(FX_RECT(1, 5, 9, 8), mask.bbox());
+
+  ASSERT_EQ(2u, mask.rows().size());
+  const CFX_AggCoverageCache::Mask::Row& row = mask.rows()[0];
+  EXPECT_EQ(5, row.y);
+  ASSERT_EQ(2u, row.span_end - row.span_begin);
+  const CFX_AggCoverageCache::Mask::Span& span = mask.spans()[row.span_begin];
+  EXPECT_EQ(2, span.x);
+  EXPECT_EQ(3, span.len);
+  EXPECT_EQ(20, mask.GetCovers(span)[1]);
+  EXPECT_EQ(7, mask.rows()[1].y);
+  EXPECT_EQ(60, mask.GetCovers(mask.spans()[mask.rows()[1].span_begin])[1]);
+}
+
+TEST(CFX_AggCoverageCache, RecordOnSecondUse) {
+  CFX_Path path = MakeTwoRectPath();
+  CFX_AggCoverageCache::Key key(&path, nullptr, nullptr,
+                                CFX_FillRenderOptions::EvenOddOptions(),
+                                CFX_AggCoverageCache::Mode::kFill);
+  ASSERT_TRUE(key.IsCacheable());
+
+  CFX_AggCoverageCache cache(CFX_AggCoverageCache::kDefaultMaxBytes);
+  EXPECT_FALSE(cache.Lookup(key));
+  EXPECT_FALSE(cache.ShouldRecord(key));
+  EXPECT_TRUE(cache.ShouldRecord(key));
+
+  cache.Add(key, MakeMask(30));
+  EXPECT_EQ(1u, cache.GetMaskCount());
+  const CFX_AggCoverageCache::Mask* mask = cache.Lookup(key);
+  ASSERT_TRUE(mask);
+  EXPECT_EQ(FX_RECT(0, 0, 30, 2), mask->bbox());
+
+  // Same points, but stroked.
+  CFX_GraphStateData graph_state;
+  CFX_AggCoverageCache::Key stroke_key(&path, nullptr, &graph_state,
+                                       CFX_FillRenderOptions(),
+                                       CFX_AggCoverageCache::Mode::kStroke);
+  EXPECT_FALSE(cache.Lookup(stroke_key));
+
+  // Empty masks are not worth keeping.
+  cache.Add(stroke_key, CFX_AggCoverageCache::Mask());
+  EXPECT_EQ(1u, cache.GetMaskCount());
+}
+
+TEST(CFX_AggCoverageCache, Budget) {
+  std::vector<CFX_Path> paths(6);
+  for (size_t i = 0; i < paths.size(); ++i) {
+    paths[i].AppendRect(0, 0, 10, 10);
+    paths[i].AppendRect(20, 0, 30 + i, 10);
+  }
+
+  CFX_AggCoverageCache cache(16384);
+  auto make_key = [&paths](size_t index) {
+    return CFX_AggCoverageCache::Key(&paths[index], nullptr, nullptr,
+                                     CFX_FillRenderOptions::WindingOptions(),
+                                     CFX_AggCoverageCache::Mode::kFill);
+  };
+
+  // Each mask takes a little less than a quarter of the budget.
+  for (size_t i = 0; i < 5; ++i)
+    cache.Add(make_key(i), MakeMask(1500));
+  EXPECT_EQ(4u, cache.GetMaskCount());
+  EXPECT_LE(cache.GetCachedBytes(), 16384u);
+  EXPECT_FALSE(cache.Lookup(make_key(0)));
+  EXPECT_TRUE(cache.Lookup(make_key(1)));
+
+  // Key 1 is now more recently used than key 2.
+  cache.Add(make_key(5), MakeMask(1500));
+  EXPECT_EQ(4u, cache.GetMaskCount());
+  EXPECT_TRUE(cache.Lookup(make_key(1)));
+  EXPECT_FALSE(cache.Lookup(make_key(2)));
+  EXPECT_TRUE(cache.Lookup(make_key(5)));
+
+  // Masks larger than a quarter of the budget are never stored.
+  cache.Add(make_key(0), MakeMask(3000));
+  EXPECT_FALSE(cache.Lookup(make_key(0)));
+}
+
+TEST(CFX_AggCoverageCache, ClipLayer) {
+  CFX_Path path = MakeTwoRectPath();
+  const CFX_Matrix matrix(1, 0, 0, 1, 40, 50);
+  CFX_AggCoverageCache::Key clip_key(&path, &matrix, nullptr,
+                                     CFX_FillRenderOptions::WindingOptions(),
+                                     CFX_AggCoverageCache::Mode::kClip);
+  ASSERT_TRUE(clip_key.IsCacheable());
+
+  CFX_AggCoverageCache cache(CFX_AggCoverageCache::kDefaultMaxBytes);
+  EXPECT_FALSE(cache.LookupClipLayer(clip_key));
+
+  auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  ASSERT_TRUE(bitmap->Create(30, 10, FXDIB_Format::k8bppMask));
+  cache.AddClipLayer(clip_key, CFX_AggCoverageCache::ClipLayer(-1, 2, bitmap));
+  const CFX_AggCoverageCache::ClipLayer* layer =
+      cache.LookupClipLayer(clip_key);
+  ASSERT_TRUE(layer);
+  EXPECT_EQ(-1, layer->left);
+  EXPECT_EQ(2, layer->top);
+  EXPECT_EQ(bitmap, layer->bitmap);
+  EXPECT_GE(cache.GetCachedBytes(), 300u);
+
+  // Layers are found at other whole-pixel offsets too.
+  const CFX_Matrix moved(1, 0, 0, 1, 140, 60);
+  CFX_AggCoverageCache::Key moved_key(&path, &moved, nullptr,
+                                      CFX_FillRenderOptions::WindingOptions(),
+                                      CFX_AggCoverageCache::Mode::kClip);
+  EXPECT_EQ(layer, cache.LookupClipLayer(moved_key));
+
+  // A fill of the same path is a different entry.
+  CFX_AggCoverageCache::Key fill_key(&path, &matrix, nullptr,
+                                     CFX_FillRenderOptions::WindingOptions(),
+                                     CFX_AggCoverageCache::Mode::kFill);
+  EXPECT_FALSE(cache.Lookup(fill_key));
+}
+
+}  // namespace pdfium
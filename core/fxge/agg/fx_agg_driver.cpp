@@ -6,8 +6,11 @@
 
 #include "core/fxge/agg/fx_agg_driver.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "build/build_config.h"
 #include "core/fxge/cfx_cliprgn.h"
@@ -924,6 +927,96 @@ void CFX_Renderer::CompositeSpan1bppHelper(uint8_t* dest_scan,
   }
 }
 
+// Passes scanlines through to a CFX_Renderer while copying their coverage
+// into a CFX_AggCoverageCache::Mask, relative to the given offset.
+class CoverageRecorder {
+ public:
+  CoverageRecorder(CFX_Renderer* renderer,
+                   int offset_x,
+                   int offset_y,
+                   CFX_AggCoverageCache::Mask* mask)
+      : m_pRenderer(renderer),
+        m_OffsetX(offset_x),
+        m_OffsetY(offset_y),
+        m_pMask(mask) {}
+
+  // Needed for agg caller
+  void prepare(unsigned) {}
+
+  template <class Scanline>
+  void render(const Scanline& sl) {
+    unsigned num_spans = sl.num_spans();
+    typename Scanline::const_iterator span = sl.begin();
+    while (1) {
+      if (span->len <= 0)
+        break;
+
+      m_pMask->AddSpan(sl.y() - m_OffsetY, span->x - m_OffsetX,
+                       {span->covers, static_cast<size_t>(span->len)});
+      if (--num_spans == 0)
+        break;
+
+      ++span;
+    }
+    m_pRenderer->render(sl);
+  }
+
+ private:
+  CFX_Renderer* const m_pRenderer;
+  const int m_OffsetX;
+  const int m_OffsetY;
+  CFX_AggCoverageCache::Mask* const m_pMask;
+};
+
+// Presents one row of a cached mask, moved by an offset, as a scanline that
+// CFX_Renderer can render.
+class CoverageScanline {
+ public:
+  struct span {
+    agg::int16 x;
+    agg::int16 len;
+    uint8_t* covers;
+  };
+  typedef const span* const_iterator;
+
+  void Reset(const CFX_AggCoverageCache::Mask& mask,
+             const CFX_AggCoverageCache::Mask::Row& row,
+             int offset_x,
+             int offset_y) {
+    m_Y = row.y + offset_y;
+    size_t cover_count = 0;
+    for (size_t i = row.span_begin; i < row.span_end; ++i)
+      cover_count += mask.spans()[i].len;
+    m_Covers.resize(cover_count);
+    m_Spans.clear();
+    uint8_t* covers = m_Covers.data();
+    for (size_t i = row.span_begin; i < row.span_end; ++i) {
+      const CFX_AggCoverageCache::Mask::Span& mask_span = mask.spans()[i];
+      memcpy(covers, mask.GetCovers(mask_span), mask_span.len);
+      m_Spans.push_back({static_cast<agg::int16>(mask_span.x + offset_x),
+                         static_cast<agg::int16>(mask_span.len), covers});
+      covers += mask_span.len;
+    }
+  }
+
+  int y() const { return m_Y; }
+  unsigned num_spans() const { return m_Spans.size(); }
+  const_iterator begin() const { return m_Spans.data(); }
+
+ private:
+  int m_Y = 0;
+  std::vector<span> m_Spans;
+  std::vector<uint8_t> m_Covers;
+};
+
+bool IsRectInsideDevice(const FX_RECT& rect,
+                        const RetainPtr<CFX_DIBitmap>& device,
+                        int margin) {
+  return rect.left >= margin && rect.top >= margin &&
+         rect.right <= device->GetWidth() - margin &&
+         rect.bottom <= device->GetHeight() - margin;
+}
+
 template <class BaseRenderer>
 class RendererScanLineAaOffset {
  public:
@@ -962,6 +1055,18 @@ class RendererScanLineAaOffset {
   unsigned m_top;
 };
 
+// Returns true if filling |pPath| cannot cover any pixel inside |box|.
+bool IsPathOutsideBox(const CFX_Path* pPath,
+                      const CFX_Matrix* pObject2Device,
+                      const FX_RECT& box) {
+  CFX_FloatRect rect = pPath->GetBoundingBox();
+  if (pObject2Device)
+    rect = pObject2Device->TransformRect(rect);
+  // Allow a pixel for anti-aliasing.
+  return rect.right < box.left - 1 || rect.left > box.right + 1 ||
+         rect.top < box.top - 1 || rect.bottom > box.bottom + 1;
+}
+
 // Note: BuildAggPath() has to take |agg_path| as an out-parameter. If it
 // returns the agg::path_storage instead, tests will fail with MSVC builds.
 void BuildAggPath(const CFX_Path* pPath,
@@ -1019,7 +1124,8 @@ CFX_AggDeviceDriver::CFX_AggDeviceDriver(
     : m_pBitmap(pBitmap),
       m_bRgbByteOrder(bRgbByteOrder),
       m_bGroupKnockout(bGroupKnockout),
-      m_pBackdropBitmap(pBackdropBitmap) {
+      m_pBackdropBitmap(pBackdropBitmap),
+      m_CoverageCache(CFX_AggCoverageCache::kDefaultMaxBytes) {
   DCHECK(m_pBitmap);
   InitPlatform();
 }
@@ -1100,10 +1206,23 @@ void CFX_AggDeviceDriver::RestoreState(bool bKeepSaved) {
   }
 }
 
-void CFX_AggDeviceDriver::SetClipMask(agg::rasterizer_scanline_aa& rasterizer) {
+void CFX_AggDeviceDriver::SetClipMask(
+    agg::rasterizer_scanline_aa& rasterizer,
+    const CFX_AggCoverageCache::Key* pCacheKey) {
   FX_RECT path_rect(rasterizer.min_x(), rasterizer.min_y(),
                     rasterizer.max_x() + 1, rasterizer.max_y() + 1);
-  path_rect.Intersect(m_pClipRgn->GetBox());
+  // A layer that covers the whole path can be kept and reused by later clip
+  // regions, as long as the device edges did not cut it off.
+  bool bRecord = pCacheKey && pCacheKey->IsCacheable() &&
+                 IsRectInsideDevice(path_rect, m_pBitmap, 1) &&
+                 m_CoverageCache.ShouldRecord(*pCacheKey);
+  if (!bRecord)
+    path_rect.Intersect(m_pClipRgn->GetBox());
+  if (path_rect.IsEmpty()) {
+    m_pClipRgn->IntersectRect(FX_RECT());
+    return;
+  }
+
   auto pThisLayer = pdfium::MakeRetain<CFX_DIBitmap>();
   pThisLayer->Create(path_rect.Width(), path_rect.Height(),
                      FXDIB_Format::k8bppMask);
@@ -1120,6 +1239,32 @@ void CFX_AggDeviceDriver::SetClipMask(agg::rasterizer_scanline_aa& rasterizer) {
   agg::render_scanlines(rasterizer, scanline, final_render,
                         m_FillOptions.aliased_path);
   m_pClipRgn->IntersectMaskF(path_rect.left, path_rect.top, pThisLayer);
+  if (bRecord) {
+    m_CoverageCache.AddClipLayer(
+        *pCacheKey, CFX_AggCoverageCache::ClipLayer(
+                        path_rect.left - pCacheKey->offset_x(),
+                        path_rect.top - pCacheKey->offset_y(), pThisLayer));
+  }
+}
+
+bool CFX_AggDeviceDriver::SetCachedClipMask(
+    const CFX_AggCoverageCache::Key& key) {
+  if (!key.IsCacheable())
+    return false;
+
+  const CFX_AggCoverageCache::ClipLayer* layer =
+      m_CoverageCache.LookupClipLayer(key);
+  if (!layer)
+    return false;
+
+  FX_RECT layer_rect(0, 0, layer->bitmap->GetWidth(),
+                     layer->bitmap->GetHeight());
+  layer_rect.Offset(layer->left + key.offset_x(), layer->top + key.offset_y());
+  if (!IsRectInsideDevice(layer_rect, m_pBitmap, 0))
+    return false;
+
+  m_pClipRgn->IntersectMaskF(layer_rect.left, layer_rect.top, layer->bitmap);
+  return true;
 }
 
 bool CFX_AggDeviceDriver::SetClip_PathFill(
@@ -1143,6 +1288,15 @@ bool CFX_AggDeviceDriver::SetClip_PathFill(
     m_pClipRgn->IntersectRect(rect);
     return true;
   }
+  if (IsPathOutsideBox(pPath, pObject2Device, m_pClipRgn->GetBox())) {
+    m_pClipRgn->IntersectRect(FX_RECT());
+    return true;
+  }
+  CFX_AggCoverageCache::Key key(pPath, pObject2Device, nullptr, fill_options,
+                                CFX_AggCoverageCache::Mode::kClip);
+  if (SetCachedClipMask(key))
+    return true;
+
   agg::path_storage path_data;
   BuildAggPath(pPath, pObject2Device, path_data);
   path_data.end_poly();
@@ -1152,7 +1306,7 @@ bool CFX_AggDeviceDriver::SetClip_PathFill(
                       static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
   rasterizer.add_path(path_data);
   rasterizer.filling_rule(GetAlternateOrWindingFillType(fill_options));
-  SetClipMask(rasterizer);
+  SetClipMask(rasterizer, &key);
   return true;
 }
 
@@ -1173,7 +1327,7 @@ bool CFX_AggDeviceDriver::SetClip_PathStroke(
   RasterizeStroke(&rasterizer, &path_data, pObject2Device, pGraphState, 1.0f,
                   false);
   rasterizer.filling_rule(agg::fill_non_zero);
-  SetClipMask(rasterizer);
+  SetClipMask(rasterizer, nullptr);
   return true;
 }
 
@@ -1185,13 +1339,59 @@ void CFX_AggDeviceDriver::RenderRasterizer(
     agg::rasterizer_scanline_aa& rasterizer,
     uint32_t color,
     bool bFullCover,
-    bool bGroupKnockout) {
+    bool bGroupKnockout,
+    const CFX_AggCoverageCache::Key* pCacheKey) {
   RetainPtr<CFX_DIBitmap> pt = bGroupKnockout ? m_pBackdropBitmap : nullptr;
   CFX_Renderer render(m_pBitmap, pt, m_pClipRgn.get(), color, bFullCover,
                       m_bRgbByteOrder);
   agg::scanline_u8 scanline;
-  agg::render_scanlines(rasterizer, scanline, render,
+  if (!pCacheKey || !pCacheKey->IsCacheable() ||
+      !m_CoverageCache.ShouldRecord(*pCacheKey)) {
+    agg::render_scanlines(rasterizer, scanline, render,
+                          m_FillOptions.aliased_path);
+    return;
+  }
+
+  CFX_AggCoverageCache::Mask mask;
+  CoverageRecorder recorder(&render, pCacheKey->offset_x(),
+                            pCacheKey->offset_y(), &mask);
+  agg::render_scanlines(rasterizer, scanline, recorder,
                         m_FillOptions.aliased_path);
+
+  // Coverage that touches the device edges may have been clipped by the
+  // rasterizer, and would not be valid at other offsets.
+  FX_RECT bbox = mask.bbox();
+  bbox.Offset(pCacheKey->offset_x(), pCacheKey->offset_y());
+  if (!mask.IsEmpty() && IsRectInsideDevice(bbox, m_pBitmap, 1))
+    m_CoverageCache.Add(*pCacheKey, std::move(mask));
+}
+
+bool CFX_AggDeviceDriver::RenderCachedCoverage(
+    const CFX_AggCoverageCache::Key& key,
+    uint32_t color,
+    bool bFullCover,
+    bool bGroupKnockout) {
+  if (!key.IsCacheable())
+    return false;
+
+  const CFX_AggCoverageCache::Mask* mask = m_CoverageCache.Lookup(key);
+  if (!mask)
+    return false;
+
+  FX_RECT bbox = mask->bbox();
+  bbox.Offset(key.offset_x(), key.offset_y());
+  if (!IsRectInsideDevice(bbox, m_pBitmap, 0))
+    return false;
+
+  RetainPtr<CFX_DIBitmap> pt = bGroupKnockout ? m_pBackdropBitmap : nullptr;
+  CFX_Renderer render(m_pBitmap, pt, m_pClipRgn.get(), color, bFullCover,
+                      m_bRgbByteOrder);
+  CoverageScanline scanline;
+  for (const auto& row : mask->rows()) {
+    scanline.Reset(*mask, row, key.offset_x(), key.offset_y());
+    render.render(scanline);
+  }
+  return true;
 }
 
 bool CFX_AggDeviceDriver::DrawPath(const CFX_Path* pPath,
@@ -1210,21 +1410,35 @@ bool CFX_AggDeviceDriver::DrawPath(const CFX_Path* pPath,
   m_FillOptions = fill_options;
   if (fill_options.fill_type != CFX_FillRenderOptions::FillType::kNoFill &&
       fill_color) {
-    agg::path_storage path_data;
-    BuildAggPath(pPath, pObject2Device, path_data);
-    agg::rasterizer_scanline_aa rasterizer;
-    rasterizer.clip_box(0.0f, 0.0f,
-                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
-                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
-    rasterizer.add_path(path_data);
-    rasterizer.filling_rule(GetAlternateOrWindingFillType(fill_options));
-    RenderRasterizer(rasterizer, fill_color, fill_options.full_cover,
-                     /*bGroupKnockout=*/false);
+    CFX_AggCoverageCache::Key key(pPath, pObject2Device, nullptr, fill_options,
+                                  CFX_AggCoverageCache::Mode::kFill);
+    if (!RenderCachedCoverage(key, fill_color, fill_options.full_cover,
+                              /*bGroupKnockout=*/false)) {
+      agg::path_storage path_data;
+      BuildAggPath(pPath, pObject2Device, path_data);
+      agg::rasterizer_scanline_aa rasterizer;
+      rasterizer.clip_box(
+          0.0f, 0.0f, static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
+          static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
+      rasterizer.add_path(path_data);
+      rasterizer.filling_rule(GetAlternateOrWindingFillType(fill_options));
+      RenderRasterizer(rasterizer, fill_color, fill_options.full_cover,
+                       /*bGroupKnockout=*/false, &key);
+    }
   }
   int stroke_alpha = FXARGB_A(stroke_color);
   if (!pGraphState || !stroke_alpha)
     return true;
 
+  CFX_AggCoverageCache::Key key(
+      pPath, pObject2Device, pGraphState, fill_options,
+      fill_options.zero_area ? CFX_AggCoverageCache::Mode::kZeroAreaStroke
+                             : CFX_AggCoverageCache::Mode::kStroke);
+  if (RenderCachedCoverage(key, stroke_color, fill_options.full_cover,
+                           m_bGroupKnockout)) {
+    return true;
+  }
+
   if (fill_options.zero_area) {
     agg::path_storage path_data;
     BuildAggPath(pPath, pObject2Device, path_data);
@@ -1235,7 +1449,7 @@ bool CFX_AggDeviceDriver::DrawPath(const CFX_Path* pPath,
     RasterizeStroke(&rasterizer, &path_data, nullptr, pGraphState, 1,
                     fill_options.stroke_text_mode);
     RenderRasterizer(rasterizer, stroke_color, fill_options.full_cover,
-                     m_bGroupKnockout);
+                     m_bGroupKnockout, &key);
     return true;
   }
   CFX_Matrix matrix1;
@@ -1259,7 +1473,7 @@ bool CFX_AggDeviceDriver::DrawPath(const CFX_Path* pPath,
   RasterizeStroke(&rasterizer, &path_data, &matrix2, pGraphState, matrix1.a,
                   fill_options.stroke_text_mode);
   RenderRasterizer(rasterizer, stroke_color, fill_options.full_cover,
-                   m_bGroupKnockout);
+                   m_bGroupKnockout, &key);
   return true;
 }
 
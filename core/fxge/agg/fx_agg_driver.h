@@ -12,6 +12,7 @@
 
 #include "build/build_config.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/agg/cfx_agg_coveragecache.h"
 #include "core/fxge/cfx_fillrenderoptions.h"
 #include "core/fxge/renderdevicedriver_iface.h"
 
@@ -100,9 +101,24 @@ class CFX_AggDeviceDriver final : public RenderDeviceDriverIface {
   void RenderRasterizer(pdfium::agg::rasterizer_scanline_aa& rasterizer,
                         uint32_t color,
                         bool bFullCover,
-                        bool bGroupKnockout);
+                        bool bGroupKnockout,
+                        const CFX_AggCoverageCache::Key* pCacheKey);
 
-  void SetClipMask(pdfium::agg::rasterizer_scanline_aa& rasterizer);
+  // Renders the cached coverage for |key|, if there is any and it fits on the
+  // device. Returns false if the path still needs to be rasterized.
+  bool RenderCachedCoverage(const CFX_AggCoverageCache::Key& key,
+                            uint32_t color,
+                            bool bFullCover,
+                            bool bGroupKnockout);
+
+  // Intersects the clip region with the coverage of |rasterizer|, recording
+  // it under |pCacheKey| when that is worthwhile.
+  void SetClipMask(pdfium::agg::rasterizer_scanline_aa& rasterizer,
+                   const CFX_AggCoverageCache::Key* pCacheKey);
+
+  // Intersects the clip region with the cached coverage for |key|. Returns
+  // false if the path still needs to be rasterized.
+  bool SetCachedClipMask(const CFX_AggCoverageCache::Key& key);
 
   RetainPtr<CFX_DIBitmap> const m_pBitmap;
   std::unique_ptr<CFX_ClipRgn> m_pClipRgn;
@@ -114,6 +130,7 @@ class CFX_AggDeviceDriver final : public RenderDeviceDriverIface {
   const bool m_bRgbByteOrder;
   const bool m_bGroupKnockout;
   RetainPtr<CFX_DIBitmap> m_pBackdropBitmap;
+  CFX_AggCoverageCache m_CoverageCache;
 };
 
 }  // namespace pdfium
@@ -144,6 +144,9 @@ CApplePlatform::CreateDefaultSystemFontInfo() {
     pInfo->AddPath("/Library/Fonts");
     pInfo->AddPath("/System/Library/Fonts");
   }
+  const char* catalog_path = CFX_GEModule::Get()->GetFontCatalogPath();
+  if (catalog_path)
+    pInfo->SetCatalogPath(catalog_path);
   return std::move(pInfo);
 }
 
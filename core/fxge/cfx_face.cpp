@@ -31,8 +31,17 @@ RetainPtr<CFX_Face> CFX_Face::Open(FT_Library library,
 }
 
 CFX_Face::CFX_Face(FXFT_FaceRec* rec, const RetainPtr<Retainable>& pDesc)
-    : m_pRec(rec), m_pDesc(pDesc) {
+    : m_pRec(rec), m_pDesc(pDesc), m_pInitialCharmap(rec->charmap) {
   DCHECK(m_pRec);
 }
 
 CFX_Face::~CFX_Face() = default;
+
+void CFX_Face::ResetCharmap() {
+  if (m_pInitialCharmap) {
+    FT_Set_Charmap(m_pRec.get(), m_pInitialCharmap);
+    return;
+  }
+  // FT_Set_Charmap() cannot undo a selection.
+  m_pRec->charmap = nullptr;
+}
@@ -25,11 +25,16 @@ class CFX_Face : public Retainable, public Observable {
 
   FXFT_FaceRec* GetRec() { return m_pRec.get(); }
 
+  // Selects the charmap FreeType picked when opening the face, undoing the
+  // choices of fonts that used the face before.
+  void ResetCharmap();
+
  private:
   CFX_Face(FXFT_FaceRec* pRec, const RetainPtr<Retainable>& pDesc);
 
   ScopedFXFTFaceRec const m_pRec;
   RetainPtr<Retainable> const m_pDesc;
+  FT_CharMap const m_pInitialCharmap;
 };
 
 #endif  // CORE_FXGE_CFX_FACE_H_
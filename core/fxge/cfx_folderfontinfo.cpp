@@ -6,10 +6,16 @@
 
 #include "core/fxge/cfx_folderfontinfo.h"
 
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
 #include <limits>
+#include <tuple>
 #include <utility>
 
 #include "build/build_config.h"
+#include "core/fxcrt/cfx_binarybuf.h"
 #include "core/fxcrt/fx_codepage.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_folder.h"
@@ -21,6 +27,12 @@
 #include "third_party/base/containers/contains.h"
 #include "third_party/base/cxx17_backports.h"
 
+#if defined(OS_WIN)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
 namespace {
 
 const struct {
@@ -120,6 +132,92 @@ uint32_t GetCharset(int charset) {
   return 0;
 }
 
+// Bounds the memory used by FindFont() results for long-lived processes.
+constexpr size_t kMaxFindFontCacheSize = 1024;
+
+// Bump the version whenever the layout written by WriteCatalog() changes.
+constexpr char kCatalogSignature[] = "PDFium font catalog 2";
+
+// Returns false if |path| does not exist.
+bool GetFileStamp(const ByteString& path,
+                  int64_t* size,
+                  int64_t* modified_time) {
+#if defined(OS_WIN)
+  struct _stat64 info;
+  if (_stat64(path.c_str(), &info) != 0)
+    return false;
+#else
+  struct stat info;
+  if (stat(path.c_str(), &info) != 0)
+    return false;
+#endif
+  *size = info.st_size;
+  *modified_time = info.st_mtime;
+  return true;
+}
+
+// Returns a path next to |path| that no other writer uses, so that
+// processes scanning at the same time never write into the same file.
+ByteString GetTempPath(const ByteString& path) {
+  static uint32_t s_Counter = 0;
+#if defined(OS_WIN)
+  const unsigned long pid = _getpid();
+#else
+  const unsigned long pid = getpid();
+#endif
+  return path + ByteString::Format(".%lu.%u.tmp", pid, ++s_Counter);
+}
+
+int64_t GetModifiedTime(const ByteString& path) {
+  int64_t size;
+  int64_t modified_time;
+  return GetFileStamp(path, &size, &modified_time) ? modified_time : -1;
+}
+
+// The catalog only ever gets read back on the machine that wrote it, so
+// integers are stored in native byte order.
+class CatalogWriter {
+ public:
+  void WriteUint32(uint32_t value) { m_Buffer.AppendBlock(&value, 4); }
+  void WriteInt64(int64_t value) { m_Buffer.AppendBlock(&value, 8); }
+  void WriteString(const ByteString& str) {
+    WriteUint32(str.GetLength());
+    m_Buffer.AppendString(str);
+  }
+  pdfium::span<const uint8_t> GetSpan() const { return m_Buffer.GetSpan(); }
+
+ private:
+  CFX_BinaryBuf m_Buffer;
+};
+
+class CatalogReader {
+ public:
+  explicit CatalogReader(pdfium::span<const uint8_t> data) : m_Data(data) {}
+
+  bool ReadUint32(uint32_t* value) { return ReadBlock(value, 4); }
+  bool ReadInt64(int64_t* value) { return ReadBlock(value, 8); }
+  bool ReadString(ByteString* str) {
+    uint32_t size;
+    if (!ReadUint32(&size) || size > m_Data.size())
+      return false;
+    *str = ByteString(m_Data.data(), size);
+    m_Data = m_Data.subspan(size);
+    return true;
+  }
+  bool IsAtEnd() const { return m_Data.empty(); }
+
+ private:
+  bool ReadBlock(void* value, size_t size) {
+    if (m_Data.size() < size)
+      return false;
+    memcpy(value, m_Data.data(), size);
+    m_Data = m_Data.subspan(size);
+    return true;
+  }
+
+  pdfium::span<const uint8_t> m_Data;
+};
+
 int32_t GetSimilarValue(int weight,
                         bool bItalic,
                         int pitch_family,
@@ -153,14 +251,188 @@ void CFX_FolderFontInfo::AddPath(const ByteString& path) {
   m_PathList.push_back(path);
 }
 
+void CFX_FolderFontInfo::SetCatalogPath(const ByteString& path) {
+  m_CatalogPath = path;
+}
+
 bool CFX_FolderFontInfo::EnumFontList(CFX_FontMapper* pMapper) {
   m_pMapper = pMapper;
+  if (!m_CatalogPath.IsEmpty()) {
+    std::vector<std::unique_ptr<FontFaceInfo>> faces;
+    if (ReadCatalog(&faces)) {
+      for (auto& pInfo : faces)
+        AddFace(std::move(pInfo));
+      return true;
+    }
+  }
+
   for (const auto& path : m_PathList)
     ScanPath(path);
+  if (!m_CatalogPath.IsEmpty())
+    WriteCatalog();
+  return true;
+}
+
+bool CFX_FolderFontInfo::ReadCatalog(
+    std::vector<std::unique_ptr<FontFaceInfo>>* faces) const {
+  std::unique_ptr<FILE, FxFileCloser> pFile(fopen(m_CatalogPath.c_str(), "rb"));
+  if (!pFile || fseek(pFile.get(), 0, SEEK_END) < 0)
+    return false;
+
+  long filesize = ftell(pFile.get());
+  if (filesize <= 0 || fseek(pFile.get(), 0, SEEK_SET) < 0)
+    return false;
+
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> data(filesize);
+  if (fread(data.data(), data.size(), 1, pFile.get()) != 1)
+    return false;
+
+  CatalogReader reader(data);
+  ByteString signature;
+  if (!reader.ReadString(&signature) || signature != kCatalogSignature)
+    return false;
+
+  uint32_t count;
+  if (!reader.ReadUint32(&count) || count != m_PathList.size())
+    return false;
+  for (const ByteString& path : m_PathList) {
+    ByteString cached_path;
+    if (!reader.ReadString(&cached_path) || cached_path != path)
+      return false;
+  }
+
+  // Adding or removing a font file updates the modification time of the
+  // directory containing it.
+  if (!reader.ReadUint32(&count))
+    return false;
+  for (uint32_t i = 0; i < count; ++i) {
+    ByteString path;
+    int64_t modified_time;
+    if (!reader.ReadString(&path) || !reader.ReadInt64(&modified_time) ||
+        GetModifiedTime(path) != modified_time) {
+      return false;
+    }
+  }
+
+  // Replacing a font file in place does not, so check the files as well.
+  if (!reader.ReadUint32(&count))
+    return false;
+  for (uint32_t i = 0; i < count; ++i) {
+    ByteString path;
+    int64_t size;
+    int64_t modified_time;
+    if (!reader.ReadString(&path) || !reader.ReadInt64(&size) ||
+        !reader.ReadInt64(&modified_time)) {
+      return false;
+    }
+    int64_t current_size;
+    int64_t current_modified_time;
+    if (!GetFileStamp(path, &current_size, &current_modified_time) ||
+        current_size != size || current_modified_time != modified_time) {
+      return false;
+    }
+  }
+
+  if (!reader.ReadUint32(&count))
+    return false;
+  std::vector<std::unique_ptr<FontFaceInfo>> result;
+  for (uint32_t i = 0; i < count; ++i) {
+    ByteString file_path;
+    ByteString face_name;
+    ByteString tables;
+    uint32_t offset;
+    uint32_t file_size;
+    uint32_t styles;
+    uint32_t charsets;
+    if (!reader.ReadString(&file_path) || !reader.ReadString(&face_name) ||
+        !reader.ReadString(&tables) || !reader.ReadUint32(&offset) ||
+        !reader.ReadUint32(&file_size) || !reader.ReadUint32(&styles) ||
+        !reader.ReadUint32(&charsets)) {
+      return false;
+    }
+    auto pInfo = std::make_unique<FontFaceInfo>(file_path, face_name, tables,
+                                                offset, file_size);
+    pInfo->m_Styles = styles;
+    pInfo->m_Charsets = charsets;
+    result.push_back(std::move(pInfo));
+  }
+  if (!reader.IsAtEnd())
+    return false;
+
+  *faces = std::move(result);
   return true;
 }
 
+void CFX_FolderFontInfo::WriteCatalog() const {
+  // A directory or file modified within the same second as it was scanned
+  // could change again without its modification time changing, so do not
+  // trust the scan enough to save it.
+  const int64_t now = time(nullptr);
+  for (const ScannedDirectory& dir : m_ScannedDirs) {
+    if (dir.m_ModifiedTime >= now - 1)
+      return;
+  }
+  for (const ScannedFile& file : m_ScannedFiles) {
+    if (file.m_ModifiedTime >= now - 1)
+      return;
+  }
+
+  CatalogWriter writer;
+  writer.WriteString(kCatalogSignature);
+  writer.WriteUint32(m_PathList.size());
+  for (const ByteString& path : m_PathList)
+    writer.WriteString(path);
+  writer.WriteUint32(m_ScannedDirs.size());
+  for (const ScannedDirectory& dir : m_ScannedDirs) {
+    writer.WriteString(dir.m_Path);
+    writer.WriteInt64(dir.m_ModifiedTime);
+  }
+  writer.WriteUint32(m_ScannedFiles.size());
+  for (const ScannedFile& file : m_ScannedFiles) {
+    writer.WriteString(file.m_Path);
+    writer.WriteInt64(file.m_Size);
+    writer.WriteInt64(file.m_ModifiedTime);
+  }
+  writer.WriteUint32(m_FaceOrder.size());
+  for (const ByteString& name : m_FaceOrder) {
+    const FontFaceInfo* pInfo = m_FontList.at(name).get();
+    writer.WriteString(pInfo->m_FilePath);
+    writer.WriteString(pInfo->m_FaceName);
+    writer.WriteString(pInfo->m_FontTables);
+    writer.WriteUint32(pInfo->m_FontOffset);
+    writer.WriteUint32(pInfo->m_FileSize);
+    writer.WriteUint32(pInfo->m_Styles);
+    writer.WriteUint32(pInfo->m_Charsets);
+  }
+
+  // Write to a temporary file of this writer's own first, so that other
+  // processes never see a partially written catalog, nor a mix of two
+  // concurrent writes.
+  ByteString temp_path = GetTempPath(m_CatalogPath);
+  {
+    std::unique_ptr<FILE, FxFileCloser> pFile(fopen(temp_path.c_str(), "wb"));
+    if (!pFile)
+      return;
+
+    pdfium::span<const uint8_t> data = writer.GetSpan();
+    if (fwrite(data.data(), data.size(), 1, pFile.get()) != 1) {
+      pFile.reset();
+      remove(temp_path.c_str());
+      return;
+    }
+  }
+#if defined(OS_WIN)
+  // Unlike POSIX rename(), this does not replace an existing file.
+  remove(m_CatalogPath.c_str());
+#endif
+  if (rename(temp_path.c_str(), m_CatalogPath.c_str()) != 0)
+    remove(temp_path.c_str());
+}
+
 void CFX_FolderFontInfo::ScanPath(const ByteString& path) {
+  if (!m_CatalogPath.IsEmpty())
+    m_ScannedDirs.push_back({path, GetModifiedTime(path)});
+
   std::unique_ptr<FX_FolderHandle, FxFolderHandleCloser> handle(
       FX_OpenFolder(path.c_str()));
   if (!handle)
@@ -192,6 +464,16 @@ void CFX_FolderFontInfo::ScanPath(const ByteString& path) {
 }
 
 void CFX_FolderFontInfo::ScanFile(const ByteString& path) {
+  if (!m_CatalogPath.IsEmpty()) {
+    // Recorded even if the file turns out not to be a font, so that fixing
+    // it invalidates the catalog.
+    ScannedFile file;
+    file.m_Path = path;
+    if (!GetFileStamp(path, &file.m_Size, &file.m_ModifiedTime))
+      return;
+    m_ScannedFiles.push_back(file);
+  }
+
   std::unique_ptr<FILE, FxFileCloser> pFile(fopen(path.c_str(), "rb"));
   if (!pFile)
     return;
@@ -267,28 +549,17 @@ void CFX_FolderFontInfo::ReportFace(const ByteString& path,
   if (os2.GetLength() >= 86) {
     const uint8_t* p = os2.raw_str() + 78;
     uint32_t codepages = FXSYS_UINT32_GET_MSBFIRST(p);
-    if (codepages & (1U << 17)) {
-      m_pMapper->AddInstalledFont(facename, FX_CHARSET_ShiftJIS);
+    if (codepages & (1U << 17))
       pInfo->m_Charsets |= CHARSET_FLAG_SHIFTJIS;
-    }
-    if (codepages & (1U << 18)) {
-      m_pMapper->AddInstalledFont(facename, FX_CHARSET_ChineseSimplified);
+    if (codepages & (1U << 18))
       pInfo->m_Charsets |= CHARSET_FLAG_GB;
-    }
-    if (codepages & (1U << 20)) {
-      m_pMapper->AddInstalledFont(facename, FX_CHARSET_ChineseTraditional);
+    if (codepages & (1U << 20))
       pInfo->m_Charsets |= CHARSET_FLAG_BIG5;
-    }
-    if ((codepages & (1U << 19)) || (codepages & (1U << 21))) {
-      m_pMapper->AddInstalledFont(facename, FX_CHARSET_Hangul);
+    if ((codepages & (1U << 19)) || (codepages & (1U << 21)))
       pInfo->m_Charsets |= CHARSET_FLAG_KOREAN;
-    }
-    if (codepages & (1U << 31)) {
-      m_pMapper->AddInstalledFont(facename, FX_CHARSET_Symbol);
+    if (codepages & (1U << 31))
       pInfo->m_Charsets |= CHARSET_FLAG_SYMBOL;
-    }
   }
-  m_pMapper->AddInstalledFont(facename, FX_CHARSET_ANSI);
   pInfo->m_Charsets |= CHARSET_FLAG_ANSI;
   pInfo->m_Styles = 0;
   if (style.Contains("Bold"))
@@ -298,6 +569,29 @@ void CFX_FolderFontInfo::ReportFace(const ByteString& path,
   if (facename.Contains("Serif"))
     pInfo->m_Styles |= FXFONT_SERIF;
 
+  AddFace(std::move(pInfo));
+}
+
+void CFX_FolderFontInfo::AddFace(std::unique_ptr<FontFaceInfo> pInfo) {
+  const ByteString facename = pInfo->m_FaceName;
+  if (pdfium::Contains(m_FontList, facename))
+    return;
+
+  const uint32_t charsets = pInfo->m_Charsets;
+  if (charsets & CHARSET_FLAG_SHIFTJIS)
+    m_pMapper->AddInstalledFont(facename, FX_CHARSET_ShiftJIS);
+  if (charsets & CHARSET_FLAG_GB)
+    m_pMapper->AddInstalledFont(facename, FX_CHARSET_ChineseSimplified);
+  if (charsets & CHARSET_FLAG_BIG5)
+    m_pMapper->AddInstalledFont(facename, FX_CHARSET_ChineseTraditional);
+  if (charsets & CHARSET_FLAG_KOREAN)
+    m_pMapper->AddInstalledFont(facename, FX_CHARSET_Hangul);
+  if (charsets & CHARSET_FLAG_SYMBOL)
+    m_pMapper->AddInstalledFont(facename, FX_CHARSET_Symbol);
+  if (charsets & CHARSET_FLAG_ANSI)
+    m_pMapper->AddInstalledFont(facename, FX_CHARSET_ANSI);
+
+  m_FaceOrder.push_back(facename);
   m_FontList[facename] = std::move(pInfo);
 }
 
@@ -316,21 +610,27 @@ void* CFX_FolderFontInfo::FindFont(int weight,
                                    int pitch_family,
                                    const char* family,
                                    bool bMatchName) {
-  FontFaceInfo* pFind = nullptr;
   if (charset == FX_CHARSET_ANSI && FontFamilyIsFixedPitch(pitch_family))
     return GetFont("Courier New");
 
+  // |m_FontList| only ever grows, so its size tells whether the index and the
+  // cached results are still current.
+  if (m_CharsetIndexFontCount != m_FontList.size())
+    UpdateCharsetIndex();
+
+  FindFontKey key = {family,  weight,       bItalic,
+                     charset, pitch_family, bMatchName};
+  auto cached = m_FindFontCache.find(key);
+  if (cached != m_FindFontCache.end())
+    return cached->second;
+
+  FontFaceInfo* pFind = nullptr;
   ByteStringView bsFamily(family);
-  uint32_t charset_flag = GetCharset(charset);
   int32_t iBestSimilar = 0;
-  for (const auto& it : m_FontList) {
-    const ByteString& bsName = it.first;
-    FontFaceInfo* pFont = it.second.get();
-    if (!(pFont->m_Charsets & charset_flag) && charset != FX_CHARSET_Default)
-      continue;
-
+  auto check_font = [&](FontFaceInfo* pFont) {
+    const ByteString& bsName = pFont->m_FaceName;
     if (bMatchName && !FindFamilyNameMatch(bsFamily, bsName))
-      continue;
+      return;
 
     int32_t iSimilarValue =
         GetSimilarValue(weight, bItalic, pitch_family, pFont->m_Styles,
@@ -339,10 +639,38 @@ void* CFX_FolderFontInfo::FindFont(int weight,
       iBestSimilar = iSimilarValue;
       pFind = pFont;
     }
+  };
+  if (charset == FX_CHARSET_Default) {
+    for (const auto& it : m_FontList)
+      check_font(it.second.get());
+  } else {
+    auto fonts = m_CharsetIndex.find(GetCharset(charset));
+    if (fonts != m_CharsetIndex.end()) {
+      for (const auto& pFont : fonts->second)
+        check_font(pFont.Get());
+    }
   }
+
+  if (m_FindFontCache.size() >= kMaxFindFontCacheSize)
+    m_FindFontCache.clear();
+  m_FindFontCache[key] = pFind;
   return pFind;
 }
 
+void CFX_FolderFontInfo::UpdateCharsetIndex() {
+  m_CharsetIndex.clear();
+  m_FindFontCache.clear();
+  for (const auto& it : m_FontList) {
+    FontFaceInfo* pFont = it.second.get();
+    for (uint32_t flag = CHARSET_FLAG_ANSI; flag <= CHARSET_FLAG_KOREAN;
+         flag <<= 1) {
+      if (pFont->m_Charsets & flag)
+        m_CharsetIndex[flag].emplace_back(pFont);
+    }
+  }
+  m_CharsetIndexFontCount = m_FontList.size();
+}
+
 void* CFX_FolderFontInfo::MapFont(int weight,
                                   bool bItalic,
                                   int charset,
@@ -383,6 +711,17 @@ uint32_t CFX_FolderFontInfo::GetFontData(void* hFont,
   if (!datasize || buffer.size() < datasize)
     return datasize;
 
+  // Avoid reopening the file if it is already mapped.
+  auto it = m_MappedFiles.find(pFont->m_FilePath);
+  if (it != m_MappedFiles.end() && it->second) {
+    pdfium::span<const uint8_t> data = it->second->GetSpan();
+    if (offset > data.size() || datasize > data.size() - offset)
+      return 0;
+
+    memcpy(buffer.data(), &data[offset], datasize);
+    return datasize;
+  }
+
   std::unique_ptr<FILE, FxFileCloser> pFile(
       fopen(pFont->m_FilePath.c_str(), "rb"));
   if (!pFile)
@@ -395,6 +734,24 @@ uint32_t CFX_FolderFontInfo::GetFontData(void* hFont,
   return datasize;
 }
 
+RetainPtr<CFX_MappedFile> CFX_FolderFontInfo::MapFontFile(void* hFont) {
+  if (!hFont)
+    return nullptr;
+
+  const FontFaceInfo* pFont = static_cast<FontFaceInfo*>(hFont);
+  auto it = m_MappedFiles.find(pFont->m_FilePath);
+  if (it != m_MappedFiles.end() && it->second)
+    return pdfium::WrapRetain(it->second.Get());
+
+  RetainPtr<CFX_MappedFile> pFile =
+      CFX_MappedFile::Open(pFont->m_FilePath.c_str());
+  if (!pFile || pFile->GetSpan().size() != pFont->m_FileSize)
+    return nullptr;
+
+  m_MappedFiles[pFont->m_FilePath].Reset(pFile.Get());
+  return pFile;
+}
+
 void CFX_FolderFontInfo::DeleteFont(void* hFont) {}
 
 bool CFX_FolderFontInfo::GetFaceName(void* hFont, ByteString* name) {
@@ -408,6 +765,14 @@ bool CFX_FolderFontInfo::GetFontCharset(void* hFont, int* charset) {
   return false;
 }
 
+bool CFX_FolderFontInfo::FindFontKey::operator<(
+    const FindFontKey& other) const {
+  return std::tie(m_Family, m_Weight, m_bItalic, m_Charset, m_PitchFamily,
+                  m_bMatchName) <
+         std::tie(other.m_Family, other.m_Weight, other.m_bItalic,
+                  other.m_Charset, other.m_PitchFamily, other.m_bMatchName);
+}
+
 CFX_FolderFontInfo::FontFaceInfo::FontFaceInfo(ByteString filePath,
                                                ByteString faceName,
                                                ByteString fontTables,
@@ -7,10 +7,13 @@
 #ifndef CORE_FXGE_CFX_FOLDERFONTINFO_H_
 #define CORE_FXGE_CFX_FOLDERFONTINFO_H_
 
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <vector>
 
+#include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/cfx_fontmapper.h"
 #include "core/fxge/systemfontinfo_iface.h"
@@ -29,6 +32,12 @@ class CFX_FolderFontInfo : public SystemFontInfoIface {
 
   void AddPath(const ByteString& path);
 
+  // Sets a file in which to keep the list of fonts found by scanning the
+  // paths, so that later instances can skip the scan. The file is reused as
+  // long as the same paths are given and none of the scanned directories has
+  // been modified since the file was written.
+  void SetCatalogPath(const ByteString& path);
+
   // IFX_SytemFontInfo:
   bool EnumFontList(CFX_FontMapper* pMapper) override;
   void* MapFont(int weight,
@@ -40,6 +49,7 @@ class CFX_FolderFontInfo : public SystemFontInfoIface {
   uint32_t GetFontData(void* hFont,
                        uint32_t table,
                        pdfium::span<uint8_t> buffer) override;
+  RetainPtr<CFX_MappedFile> MapFontFile(void* hFont) override;
   void DeleteFont(void* hFont) override;
   bool GetFaceName(void* hFont, ByteString* name) override;
   bool GetFontCharset(void* hFont, int* charset) override;
@@ -64,12 +74,41 @@ class CFX_FolderFontInfo : public SystemFontInfoIface {
     uint32_t m_Charsets = 0;
   };
 
+  struct ScannedDirectory {
+    ByteString m_Path;
+    // In seconds, or -1 if the directory did not exist.
+    int64_t m_ModifiedTime;
+  };
+
+  struct ScannedFile {
+    ByteString m_Path;
+    int64_t m_Size;
+    // In seconds.
+    int64_t m_ModifiedTime;
+  };
+
+  // Returns false if the catalog is missing, malformed or out of date.
+  bool ReadCatalog(std::vector<std::unique_ptr<FontFaceInfo>>* faces) const;
+  void WriteCatalog() const;
   void ScanPath(const ByteString& path);
   void ScanFile(const ByteString& path);
   void ReportFace(const ByteString& path,
                   FILE* pFile,
                   uint32_t filesize,
                   uint32_t offset);
+  void AddFace(std::unique_ptr<FontFaceInfo> pInfo);
+  struct FindFontKey {
+    bool operator<(const FindFontKey& other) const;
+
+    ByteString m_Family;
+    int m_Weight;
+    bool m_bItalic;
+    int m_Charset;
+    int m_PitchFamily;
+    bool m_bMatchName;
+  };
+
+  void UpdateCharsetIndex();
   void* GetSubstFont(const ByteString& face);
   void* FindFont(int weight,
                  bool bItalic,
@@ -79,7 +118,21 @@ class CFX_FolderFontInfo : public SystemFontInfoIface {
                  bool bMatchName);
 
   std::map<ByteString, std::unique_ptr<FontFaceInfo>> m_FontList;
+  // Keys of |m_FontList| in the order they were found. CFX_FontMapper is
+  // sensitive to this order, so the catalog preserves it.
+  std::vector<ByteString> m_FaceOrder;
   std::vector<ByteString> m_PathList;
+  std::vector<ScannedDirectory> m_ScannedDirs;
+  std::vector<ScannedFile> m_ScannedFiles;
+  ByteString m_CatalogPath;
+  // Faces of |m_FontList| in the same order, keyed by each CHARSET_FLAG_*
+  // they support. Rebuilt by FindFont() after |m_FontList| changes.
+  std::map<uint32_t, std::vector<UnownedPtr<FontFaceInfo>>> m_CharsetIndex;
+  size_t m_CharsetIndexFontCount = 0;
+  // Results of FindFont(), kept for as long as |m_FontList| is unchanged.
+  std::map<FindFontKey, void*> m_FindFontCache;
+  // Mappings handed out by MapFontFile() that are still in use, by file path.
+  std::map<ByteString, ObservedPtr<CFX_MappedFile>> m_MappedFiles;
   UnownedPtr<CFX_FontMapper> m_pMapper;
 };
 
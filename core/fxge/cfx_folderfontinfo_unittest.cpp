@@ -4,11 +4,29 @@
 
 #include "core/fxge/cfx_folderfontinfo.h"
 
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#if defined(OS_WIN)
+#include <direct.h>
+#include <sys/utime.h>
+#else
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "core/fxcrt/fx_codepage.h"
+#include "core/fxge/cfx_fontmapper.h"
 #include "core/fxge/fx_font.h"
+#include "core/fxge/systemfontinfo_iface.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/path_service.h"
 
 namespace {
 
@@ -27,6 +45,34 @@ constexpr char kOxygenSansSansBold[] = "Oxygen-Sans Sans-Bold";
 constexpr char kOxygenSans[] = "Oxygen-Sans";
 constexpr char kOxygen[] = "Oxygen";
 
+bool CopyTestFile(const ByteString& from, const ByteString& to) {
+  FILE* in = fopen(from.c_str(), "rb");
+  if (!in)
+    return false;
+  FILE* out = fopen(to.c_str(), "wb");
+  if (!out) {
+    fclose(in);
+    return false;
+  }
+  char buffer[4096];
+  size_t size;
+  bool success = true;
+  while ((size = fread(buffer, 1, sizeof(buffer), in)) > 0)
+    success &= fwrite(buffer, size, 1, out) == 1;
+  fclose(in);
+  return fclose(out) == 0 && success;
+}
+
+bool SetModifiedTime(const ByteString& path, time_t modified_time) {
+#if defined(OS_WIN)
+  struct _utimbuf times = {modified_time, modified_time};
+  return _utime(path.c_str(), &times) == 0;
+#else
+  struct utimbuf times = {modified_time, modified_time};
+  return utime(path.c_str(), &times) == 0;
+#endif
+}
+
 }  // namespace
 
 class CFX_FolderFontInfoTest : public ::testing::Test {
@@ -55,7 +101,18 @@ class CFX_FolderFontInfoTest : public ::testing::Test {
     return static_cast<CFX_FolderFontInfo::FontFaceInfo*>(font)->m_FaceName;
   }
 
- private:
+  bool ReadCatalog(const CFX_FolderFontInfo& font_info,
+                   std::vector<ByteString>* face_names) {
+    std::vector<std::unique_ptr<CFX_FolderFontInfo::FontFaceInfo>> faces;
+    if (!font_info.ReadCatalog(&faces))
+      return false;
+
+    face_names->clear();
+    for (const auto& face : faces)
+      face_names->push_back(face->m_FaceName);
+    return true;
+  }
+
   void AddDummyFont(const char* font_name, uint32_t charsets) {
     auto info = std::make_unique<CFX_FolderFontInfo::FontFaceInfo>(
         /*filePath=*/"", font_name, /*fontTables=*/"",
@@ -64,6 +121,7 @@ class CFX_FolderFontInfoTest : public ::testing::Test {
     font_info_.m_FontList[font_name] = std::move(info);
   }
 
+ private:
   CFX_FolderFontInfo font_info_;
 };
 
@@ -124,3 +182,180 @@ TEST_F(CFX_FolderFontInfoTest, TestFindFont) {
   ASSERT_TRUE(font);
   EXPECT_EQ(GetFaceName(font), kBookshelfSymbol7);
 }
+
+TEST_F(CFX_FolderFontInfoTest, TestFindFontAfterAddingFonts) {
+  EXPECT_FALSE(FindFont(/*weight=*/0, /*bItalic=*/false, FX_CHARSET_ANSI,
+                        FXFONT_FF_ROMAN, kCalibri, /*bMatchName=*/true));
+
+  // Results of earlier searches must not hide newly added fonts.
+  AddDummyFont(kCalibri, CHARSET_FLAG_ANSI);
+  void* font = FindFont(/*weight=*/0, /*bItalic=*/false, FX_CHARSET_ANSI,
+                        FXFONT_FF_ROMAN, kCalibri, /*bMatchName=*/true);
+  ASSERT_TRUE(font);
+  EXPECT_EQ(GetFaceName(font), kCalibri);
+
+  // "Calibri" does not support the symbol charset, but any charset will do
+  // for FX_CHARSET_Default.
+  EXPECT_FALSE(FindFont(/*weight=*/0, /*bItalic=*/false, FX_CHARSET_Symbol,
+                        FXFONT_FF_ROMAN, kCalibri, /*bMatchName=*/true));
+  font = FindFont(/*weight=*/0, /*bItalic=*/false, FX_CHARSET_Default,
+                  FXFONT_FF_ROMAN, kCalibri, /*bMatchName=*/true);
+  ASSERT_TRUE(font);
+  EXPECT_EQ(GetFaceName(font), kCalibri);
+}
+
+TEST_F(CFX_FolderFontInfoTest, MapFontFile) {
+  std::string test_data_dir;
+  ASSERT_TRUE(PathService::GetTestDataDir(&test_data_dir));
+
+  CFX_FontMapper font_mapper(nullptr);
+  CFX_FolderFontInfo font_info;
+  font_info.AddPath((test_data_dir + PATH_SEPARATOR + "font_tests").c_str());
+  ASSERT_TRUE(font_info.EnumFontList(&font_mapper));
+  void* font = font_info.GetFont("Test");
+  ASSERT_TRUE(font);
+
+  uint32_t font_size = font_info.GetFontData(font, 0, {});
+  ASSERT_NE(0u, font_size);
+  std::vector<uint8_t> font_data(font_size);
+  ASSERT_EQ(font_size, font_info.GetFontData(font, 0, font_data));
+
+  RetainPtr<CFX_MappedFile> mapped_file = font_info.MapFontFile(font);
+  ASSERT_TRUE(mapped_file);
+  pdfium::span<const uint8_t> span = mapped_file->GetSpan();
+  ASSERT_EQ(font_size, span.size());
+  EXPECT_EQ(0, memcmp(font_data.data(), span.data(), span.size()));
+
+  // The mapping is shared while it is in use.
+  EXPECT_EQ(mapped_file, font_info.MapFontFile(font));
+
+  // Tables are read from the mapping, and match what is read from the file.
+  uint32_t name_size = font_info.GetFontData(font, kTableNAME, {});
+  ASSERT_NE(0u, name_size);
+  std::vector<uint8_t> name_table(name_size);
+  EXPECT_EQ(name_size, font_info.GetFontData(font, kTableNAME, name_table));
+  mapped_file.Reset();
+  std::vector<uint8_t> name_table_from_file(name_size);
+  EXPECT_EQ(name_size,
+            font_info.GetFontData(font, kTableNAME, name_table_from_file));
+  EXPECT_EQ(name_table, name_table_from_file);
+}
+
+TEST_F(CFX_FolderFontInfoTest, Catalog) {
+  std::string test_data_dir;
+  std::string exe_dir;
+  ASSERT_TRUE(PathService::GetTestDataDir(&test_data_dir));
+  ASSERT_TRUE(PathService::GetExecutableDir(&exe_dir));
+  const ByteString font_dir =
+      (test_data_dir + PATH_SEPARATOR + "font_tests").c_str();
+  const ByteString catalog_path =
+      (exe_dir + PATH_SEPARATOR + "cfx_folderfontinfo_catalog.tmp").c_str();
+  remove(catalog_path.c_str());
+
+  CFX_FontMapper font_mapper(nullptr);
+  std::vector<ByteString> face_names;
+  {
+    // Scans |font_dir| and writes the catalog.
+    CFX_FolderFontInfo font_info;
+    font_info.AddPath(font_dir);
+    font_info.SetCatalogPath(catalog_path);
+    EXPECT_FALSE(ReadCatalog(font_info, &face_names));
+    ASSERT_TRUE(font_info.EnumFontList(&font_mapper));
+    ASSERT_TRUE(ReadCatalog(font_info, &face_names));
+    ASSERT_EQ(1u, face_names.size());
+    EXPECT_EQ("Test", face_names[0]);
+  }
+  {
+    // Loads the fonts from the catalog.
+    CFX_FolderFontInfo font_info;
+    font_info.AddPath(font_dir);
+    font_info.SetCatalogPath(catalog_path);
+    ASSERT_TRUE(font_info.EnumFontList(&font_mapper));
+    void* font = font_info.GetFont("Test");
+    ASSERT_TRUE(font);
+    EXPECT_EQ("Test", GetFaceName(font));
+    EXPECT_NE(0u, font_info.GetFontData(font, 0, {}));
+  }
+  {
+    // The catalog does not apply to a different set of paths.
+    CFX_FolderFontInfo font_info;
+    font_info.AddPath(font_dir);
+    font_info.AddPath(font_dir + PATH_SEPARATOR + "nonexistent");
+    font_info.SetCatalogPath(catalog_path);
+    EXPECT_FALSE(ReadCatalog(font_info, &face_names));
+  }
+  {
+    // A truncated catalog is rejected.
+    FILE* file = fopen(catalog_path.c_str(), "wb");
+    ASSERT_TRUE(file);
+    fputs("PDFium", file);
+    fclose(file);
+
+    CFX_FolderFontInfo font_info;
+    font_info.AddPath(font_dir);
+    font_info.SetCatalogPath(catalog_path);
+    EXPECT_FALSE(ReadCatalog(font_info, &face_names));
+  }
+  remove(catalog_path.c_str());
+}
+
+TEST_F(CFX_FolderFontInfoTest, CatalogChecksFiles) {
+  std::string test_data_dir;
+  std::string exe_dir;
+  ASSERT_TRUE(PathService::GetTestDataDir(&test_data_dir));
+  ASSERT_TRUE(PathService::GetExecutableDir(&exe_dir));
+  const ByteString font_dir =
+      (exe_dir + PATH_SEPARATOR + "cfx_folderfontinfo_fonts.tmp").c_str();
+  const ByteString font_path = font_dir + PATH_SEPARATOR + "test.ttf";
+  const ByteString catalog_path =
+      (exe_dir + PATH_SEPARATOR + "cfx_folderfontinfo_catalog2.tmp").c_str();
+  remove(catalog_path.c_str());
+  remove(font_path.c_str());
+#if defined(OS_WIN)
+  _mkdir(font_dir.c_str());
+#else
+  mkdir(font_dir.c_str(), 0755);
+#endif
+  ASSERT_TRUE(CopyTestFile((test_data_dir + PATH_SEPARATOR + "font_tests" +
+                        PATH_SEPARATOR + "name_windows.ttf")
+                           .c_str(),
+                       font_path));
+
+  // The catalog is only written for files and directories that have not
+  // changed recently.
+  const time_t old_time = time(nullptr) - 100;
+  ASSERT_TRUE(SetModifiedTime(font_path, old_time));
+  ASSERT_TRUE(SetModifiedTime(font_dir, old_time));
+
+  CFX_FontMapper font_mapper(nullptr);
+  CFX_FolderFontInfo font_info;
+  font_info.AddPath(font_dir);
+  font_info.SetCatalogPath(catalog_path);
+  ASSERT_TRUE(font_info.EnumFontList(&font_mapper));
+  std::vector<ByteString> face_names;
+  ASSERT_TRUE(ReadCatalog(font_info, &face_names));
+
+  // A file touched in place invalidates the catalog, even though the
+  // directory containing it did not change.
+  ASSERT_TRUE(SetModifiedTime(font_path, old_time + 50));
+  EXPECT_FALSE(ReadCatalog(font_info, &face_names));
+  ASSERT_TRUE(SetModifiedTime(font_path, old_time));
+  EXPECT_TRUE(ReadCatalog(font_info, &face_names));
+
+  // So does a file rewritten with the same modification time.
+  FILE* file = fopen(font_path.c_str(), "ab");
+  ASSERT_TRUE(file);
+  fputs("padding", file);
+  fclose(file);
+  ASSERT_TRUE(SetModifiedTime(font_path, old_time));
+  ASSERT_TRUE(SetModifiedTime(font_dir, old_time));
+  EXPECT_FALSE(ReadCatalog(font_info, &face_names));
+
+  remove(catalog_path.c_str());
+  remove(font_path.c_str());
+#if defined(OS_WIN)
+  _rmdir(font_dir.c_str());
+#else
+  rmdir(font_dir.c_str());
+#endif
+}
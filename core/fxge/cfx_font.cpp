@@ -325,6 +325,7 @@ bool CFX_Font::LoadFile(RetainPtr<IFX_SeekableReadStream> pFile,
 void CFX_Font::SetFace(RetainPtr<CFX_Face> face) {
   ClearGlyphCache();
   m_Face = face;
+  m_ContentDigest.clear();
 }
 
 void CFX_Font::SetSubstFont(std::unique_ptr<CFX_SubstFont> subst) {
@@ -351,6 +352,7 @@ void CFX_Font::LoadSubst(const ByteString& face_name,
                          bool bVertical) {
   m_bEmbedded = false;
   m_bVertical = bVertical;
+  m_ContentDigest.clear();
   m_pSubstFont = std::make_unique<CFX_SubstFont>();
   m_Face = CFX_GEModule::Get()->GetFontMgr()->FindSubstFont(
       face_name, bTrueType, flags, weight, italic_angle, CharsetCP,
@@ -380,14 +382,35 @@ int CFX_Font::GetGlyphWidth(uint32_t glyph_index) {
 }
 
 bool CFX_Font::LoadEmbedded(pdfium::span<const uint8_t> src_span,
-                            bool bForceAsVertical) {
+                            bool bForceAsVertical,
+                            const ByteString& content_digest) {
   if (bForceAsVertical)
     m_bVertical = true;
+  m_bEmbedded = true;
+  m_ContentDigest.clear();
+  if (!content_digest.IsEmpty()) {
+    CFX_FontMgr* pFontMgr = CFX_GEModule::Get()->GetFontMgr();
+    m_Face = pFontMgr->GetCachedEmbeddedFace(content_digest, src_span);
+    if (m_Face) {
+      // Load as if the face were new. Fonts that read glyph indices through
+      // the charmap after loading select their own charmap each time.
+      m_Face->ResetCharmap();
+    } else {
+      m_Face = pFontMgr->AddCachedEmbeddedFace(content_digest, src_span);
+    }
+    if (!m_Face)
+      return false;
+
+    m_ContentDigest = content_digest;
+    m_FontData = {FXFT_Get_Face_Stream_Base(m_Face->GetRec()),
+                  FXFT_Get_Face_Stream_Size(m_Face->GetRec())};
+    return true;
+  }
+
   m_FontDataAllocation = std::vector<uint8_t, FxAllocAllocator<uint8_t>>(
       src_span.begin(), src_span.end());
   m_Face = CFX_GEModule::Get()->GetFontMgr()->NewFixedFace(
       nullptr, m_FontDataAllocation, 0);
-  m_bEmbedded = true;
   m_FontData = m_FontDataAllocation;
   return !!m_Face;
 }
@@ -70,8 +70,12 @@ class CFX_Font {
                  int CharsetCP,
                  bool bVertical);
 
+  // |content_digest| identifies the font program, so that fonts loaded from
+  // identical data can share one face and its cached glyphs, even across
+  // documents. It may be empty.
   bool LoadEmbedded(pdfium::span<const uint8_t> src_span,
-                    bool bForceAsVertical);
+                    bool bForceAsVertical,
+                    const ByteString& content_digest);
   RetainPtr<CFX_Face> GetFace() const { return m_Face; }
   FXFT_FaceRec* GetFaceRec() const {
     return m_Face ? m_Face->GetRec() : nullptr;
@@ -112,6 +116,7 @@ class CFX_Font {
   bool IsTTFont() const;
   Optional<FX_RECT> GetBBox();
   bool IsEmbedded() const { return m_bEmbedded; }
+  const ByteString& GetContentDigest() const { return m_ContentDigest; }
   uint8_t* GetSubData() const { return m_pGsubData.get(); }
   void SetSubData(uint8_t* data) { m_pGsubData.reset(data); }
   pdfium::span<uint8_t> GetFontSpan() const { return m_FontData; }
@@ -149,6 +154,7 @@ class CFX_Font {
   std::unique_ptr<uint8_t, FxFreeDeleter> m_pGsubData;
   std::vector<uint8_t, FxAllocAllocator<uint8_t>> m_FontDataAllocation;
   pdfium::span<uint8_t> m_FontData;
+  ByteString m_ContentDigest;
   bool m_bEmbedded = false;
   bool m_bVertical = false;
 #if defined(OS_APPLE)
@@ -6,17 +6,40 @@
 
 #include "core/fxge/cfx_fontcache.h"
 
+#include <algorithm>
+
 #include "core/fxge/cfx_font.h"
 #include "core/fxge/cfx_glyphcache.h"
 #include "core/fxge/fx_font.h"
 #include "core/fxge/fx_freetype.h"
 
-CFX_FontCache::CFX_FontCache() = default;
+namespace {
+
+constexpr size_t kMinSharedGlyphCachePruneSize = 64;
+constexpr size_t kMaxRecentSharedGlyphCacheBytes = 16 * 1024 * 1024;
+
+}  // namespace
 
-CFX_FontCache::~CFX_FontCache() = default;
+CFX_FontCache::CFX_FontCache()
+    : m_SharedGlyphCachePruneSize(kMinSharedGlyphCachePruneSize) {}
+
+CFX_FontCache::~CFX_FontCache() {
+  // Documents may keep shared caches alive past this point.
+  for (auto& it : m_SharedGlyphCacheMap) {
+    if (it.second)
+      it.second->SetFontCache(nullptr);
+  }
+}
 
 RetainPtr<CFX_GlyphCache> CFX_FontCache::GetGlyphCache(const CFX_Font* pFont) {
   RetainPtr<CFX_Face> face = pFont->GetFace();
+  // Only the digest of a loaded embedded font says which glyphs it has.
+  const ByteString& digest = pFont->GetContentDigest();
+  if (face && !digest.IsEmpty() && pFont->IsEmbedded() &&
+      !pFont->GetSubstFont()) {
+    return GetSharedGlyphCache(digest);
+  }
+
   const bool bExternal = !face;
   auto& map = bExternal ? m_ExtGlyphCacheMap : m_GlyphCacheMap;
   auto it = map.find(face.Get());
@@ -28,6 +51,80 @@ RetainPtr<CFX_GlyphCache> CFX_FontCache::GetGlyphCache(const CFX_Font* pFont) {
   return new_cache;
 }
 
+RetainPtr<CFX_GlyphCache> CFX_FontCache::GetSharedGlyphCache(
+    const ByteString& digest) {
+  auto it = m_SharedGlyphCacheMap.find(digest);
+  if (it != m_SharedGlyphCacheMap.end() && it->second) {
+    RetainPtr<CFX_GlyphCache> cache = pdfium::WrapRetain(it->second.Get());
+    MarkSharedGlyphCacheUsed(cache);
+    return cache;
+  }
+
+  if (m_SharedGlyphCacheMap.size() >= m_SharedGlyphCachePruneSize) {
+    for (auto prune_it = m_SharedGlyphCacheMap.begin();
+         prune_it != m_SharedGlyphCacheMap.end();) {
+      if (prune_it->second)
+        ++prune_it;
+      else
+        prune_it = m_SharedGlyphCacheMap.erase(prune_it);
+    }
+    m_SharedGlyphCachePruneSize = std::max(kMinSharedGlyphCachePruneSize,
+                                           m_SharedGlyphCacheMap.size() * 2);
+  }
+
+  // Shared caches do not hold on to a face, since the face belongs to one
+  // font and may go away before the cache does.
+  auto new_cache = pdfium::MakeRetain<CFX_GlyphCache>(nullptr);
+  new_cache->SetFontCache(this);
+  m_SharedGlyphCacheMap[digest].Reset(new_cache.Get());
+  MarkSharedGlyphCacheUsed(new_cache);
+  return new_cache;
+}
+
+void CFX_FontCache::MarkSharedGlyphCacheUsed(
+    const RetainPtr<CFX_GlyphCache>& cache) {
+  auto it = m_RecentSharedGlyphCacheMap.find(cache.Get());
+  if (it != m_RecentSharedGlyphCacheMap.end()) {
+    m_RecentSharedGlyphCaches.splice(m_RecentSharedGlyphCaches.begin(),
+                                     m_RecentSharedGlyphCaches, it->second);
+    m_RecentSharedGlyphCacheBytes -= it->second->bytes;
+  } else {
+    m_RecentSharedGlyphCaches.push_front({cache, 0});
+    m_RecentSharedGlyphCacheMap[cache.Get()] =
+        m_RecentSharedGlyphCaches.begin();
+  }
+
+  // Growth is charged as glyphs are added, but only while the cache is in
+  // the list. A cache handed out again after being trimmed may have grown
+  // in the meantime, so its size is taken afresh.
+  RecentSharedGlyphCache& entry = m_RecentSharedGlyphCaches.front();
+  entry.bytes = cache->GetGlyphBitmapBytes();
+  m_RecentSharedGlyphCacheBytes += entry.bytes;
+  TrimRecentSharedGlyphCaches();
+}
+
+void CFX_FontCache::OnGlyphBitmapBytesAdded(const CFX_GlyphCache* cache,
+                                            size_t bytes) {
+  auto it = m_RecentSharedGlyphCacheMap.find(cache);
+  if (it == m_RecentSharedGlyphCacheMap.end())
+    return;
+
+  m_RecentSharedGlyphCaches.splice(m_RecentSharedGlyphCaches.begin(),
+                                   m_RecentSharedGlyphCaches, it->second);
+  it->second->bytes += bytes;
+  m_RecentSharedGlyphCacheBytes += bytes;
+  TrimRecentSharedGlyphCaches();
+}
+
+void CFX_FontCache::TrimRecentSharedGlyphCaches() {
+  while (m_RecentSharedGlyphCacheBytes > kMaxRecentSharedGlyphCacheBytes) {
+    const RecentSharedGlyphCache& last = m_RecentSharedGlyphCaches.back();
+    m_RecentSharedGlyphCacheBytes -= last.bytes;
+    m_RecentSharedGlyphCacheMap.erase(last.cache.Get());
+    m_RecentSharedGlyphCaches.pop_back();
+  }
+}
+
 #if defined(_SKIA_SUPPORT_)
 CFX_TypeFace* CFX_FontCache::GetDeviceCache(const CFX_Font* pFont) {
   return GetGlyphCache(pFont)->GetDeviceCache(pFont);
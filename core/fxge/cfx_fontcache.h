@@ -7,9 +7,11 @@
 #ifndef CORE_FXGE_CFX_FONTCACHE_H_
 #define CORE_FXGE_CFX_FONTCACHE_H_
 
+#include <list>
 #include <map>
 #include <memory>
 
+#include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxge/cfx_glyphcache.h"
@@ -27,9 +29,35 @@ class CFX_FontCache {
   CFX_TypeFace* GetDeviceCache(const CFX_Font* pFont);
 #endif
 
+  // Called by shared caches as they add glyph bitmaps, which keeps the
+  // glyphs of recently used caches within budget while they are in use.
+  void OnGlyphBitmapBytesAdded(const CFX_GlyphCache* cache, size_t bytes);
+
  private:
+  struct RecentSharedGlyphCache {
+    RetainPtr<CFX_GlyphCache> cache;
+    // Size of the glyphs in |cache| when it was last used.
+    size_t bytes;
+  };
+
+  RetainPtr<CFX_GlyphCache> GetSharedGlyphCache(const ByteString& digest);
+  void MarkSharedGlyphCacheUsed(const RetainPtr<CFX_GlyphCache>& cache);
+  void TrimRecentSharedGlyphCaches();
+
   std::map<CFX_Face*, ObservedPtr<CFX_GlyphCache>> m_GlyphCacheMap;
   std::map<CFX_Face*, ObservedPtr<CFX_GlyphCache>> m_ExtGlyphCacheMap;
+  // Caches for fonts with a content digest, shared across faces and
+  // documents. Entries for destroyed caches are pruned when the map reaches
+  // |m_SharedGlyphCachePruneSize|.
+  std::map<ByteString, ObservedPtr<CFX_GlyphCache>> m_SharedGlyphCacheMap;
+  size_t m_SharedGlyphCachePruneSize;
+  // Most recently used shared caches first. Keeps caches alive after the
+  // documents using them close, as long as their glyphs fit in
+  // |kMaxRecentSharedGlyphCacheBytes|.
+  std::list<RecentSharedGlyphCache> m_RecentSharedGlyphCaches;
+  std::map<const CFX_GlyphCache*, std::list<RecentSharedGlyphCache>::iterator>
+      m_RecentSharedGlyphCacheMap;
+  size_t m_RecentSharedGlyphCacheBytes = 0;
 };
 
 #endif  // CORE_FXGE_CFX_FONTCACHE_H_
@@ -0,0 +1,170 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_fontcache.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_glyphbitmap.h"
+#include "core/fxge/cfx_glyphcache.h"
+#include "core/fxge/cfx_textrenderoptions.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/fx_freetype.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/file_util.h"
+#include "testing/utils/path_service.h"
+
+namespace {
+
+std::vector<uint8_t> ReadTestFont() {
+  std::string path;
+  if (!PathService::GetTestFilePath("fonts/Ahem.ttf", &path))
+    return {};
+
+  size_t size;
+  std::unique_ptr<char, pdfium::FreeDeleter> contents =
+      GetFileContents(path.c_str(), &size);
+  if (!contents)
+    return {};
+
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(contents.get());
+  return std::vector<uint8_t>(data, data + size);
+}
+
+}  // namespace
+
+TEST(CFX_FontCacheTest, SharedGlyphCacheForSameContent) {
+  std::vector<uint8_t> data = ReadTestFont();
+  ASSERT_FALSE(data.empty());
+
+  CFX_Font font1;
+  CFX_Font font2;
+  CFX_Font font3;
+  CFX_Font font4;
+  ASSERT_TRUE(font1.LoadEmbedded(data, false, "digest"));
+  ASSERT_TRUE(font2.LoadEmbedded(data, false, "digest"));
+  ASSERT_TRUE(font3.LoadEmbedded(data, false, "other digest"));
+  ASSERT_TRUE(font4.LoadEmbedded(data, false, ByteString()));
+  EXPECT_EQ(font1.GetFace(), font2.GetFace());
+  EXPECT_NE(font1.GetFace(), font4.GetFace());
+
+  CFX_FontCache font_cache;
+  RetainPtr<CFX_GlyphCache> glyph_cache = font_cache.GetGlyphCache(&font1);
+  ASSERT_TRUE(glyph_cache);
+  EXPECT_EQ(glyph_cache, font_cache.GetGlyphCache(&font2));
+  EXPECT_NE(glyph_cache, font_cache.GetGlyphCache(&font3));
+  EXPECT_NE(glyph_cache, font_cache.GetGlyphCache(&font4));
+}
+
+TEST(CFX_FontCacheTest, NoSharedGlyphCacheForSubstitutes) {
+  // Both fonts have an empty font program, so they fall back to different
+  // substitutes.
+  CFX_Font font1;
+  CFX_Font font2;
+  ASSERT_FALSE(font1.LoadEmbedded({}, false, "digest"));
+  ASSERT_FALSE(font2.LoadEmbedded({}, false, "digest"));
+  EXPECT_TRUE(font1.GetContentDigest().IsEmpty());
+  font1.LoadSubst("Courier", true, 0, 400, 0, 0, false);
+  font2.LoadSubst("Times-Roman", true, 0, 400, 0, 0, false);
+  ASSERT_TRUE(font1.GetFace());
+  ASSERT_TRUE(font2.GetFace());
+  EXPECT_NE(font1.GetFace(), font2.GetFace());
+  EXPECT_TRUE(font1.GetContentDigest().IsEmpty());
+
+  CFX_FontCache font_cache;
+  RetainPtr<CFX_GlyphCache> glyph_cache = font_cache.GetGlyphCache(&font1);
+  ASSERT_TRUE(glyph_cache);
+  EXPECT_NE(glyph_cache, font_cache.GetGlyphCache(&font2));
+}
+
+TEST(CFX_FontCacheTest, SharedGlyphCacheOutlivesFont) {
+  std::vector<uint8_t> data = ReadTestFont();
+  ASSERT_FALSE(data.empty());
+
+  CFX_FontCache font_cache;
+  CFX_TextRenderOptions options;
+  const CFX_Matrix matrix(16, 0, 0, 16, 0, 0);
+  auto font1 = std::make_unique<CFX_Font>();
+  ASSERT_TRUE(font1->LoadEmbedded(data, false, "digest"));
+  uint32_t glyph_index = FT_Get_Char_Index(font1->GetFaceRec(), 'X');
+  ASSERT_NE(0u, glyph_index);
+
+  RetainPtr<CFX_GlyphCache> glyph_cache = font_cache.GetGlyphCache(font1.get());
+  const CFX_GlyphBitmap* bitmap =
+      glyph_cache->LoadGlyphBitmap(font1.get(), glyph_index, false, matrix, 0,
+                                   FT_RENDER_MODE_NORMAL, &options);
+  ASSERT_TRUE(bitmap);
+  ASSERT_TRUE(bitmap->GetBitmap());
+  EXPECT_EQ(16, bitmap->GetBitmap()->GetWidth());
+  font1.reset();
+
+  auto font2 = std::make_unique<CFX_Font>();
+  ASSERT_TRUE(font2->LoadEmbedded(data, false, "digest"));
+  EXPECT_EQ(glyph_cache, font_cache.GetGlyphCache(font2.get()));
+  EXPECT_EQ(bitmap, glyph_cache->LoadGlyphBitmap(
+                        font2.get(), glyph_index, false, matrix, 0,
+                        FT_RENDER_MODE_NORMAL, &options));
+
+  // Glyphs not rendered yet are rendered with the new font's face.
+  uint32_t other_index = FT_Get_Char_Index(font2->GetFaceRec(), 'p');
+  ASSERT_NE(0u, other_index);
+  EXPECT_TRUE(glyph_cache->LoadGlyphBitmap(font2.get(), other_index, false,
+                                           matrix, 0, FT_RENDER_MODE_NORMAL,
+                                           &options));
+}
+
+TEST(CFX_FontCacheTest, RecentSharedGlyphCachesStayAlive) {
+  std::vector<uint8_t> data = ReadTestFont();
+  ASSERT_FALSE(data.empty());
+
+  CFX_FontCache font_cache;
+  ObservedPtr<CFX_GlyphCache> observed_cache;
+  {
+    CFX_Font font;
+    ASSERT_TRUE(font.LoadEmbedded(data, false, "digest"));
+    observed_cache.Reset(font_cache.GetGlyphCache(&font).Get());
+  }
+  ASSERT_TRUE(observed_cache);
+
+  CFX_Font font;
+  ASSERT_TRUE(font.LoadEmbedded(data, false, "digest"));
+  EXPECT_EQ(observed_cache.Get(), font_cache.GetGlyphCache(&font).Get());
+}
+
+TEST(CFX_FontCacheTest, SharedGlyphCacheGrowthCountsAgainstBudget) {
+  std::vector<uint8_t> data = ReadTestFont();
+  ASSERT_FALSE(data.empty());
+
+  CFX_FontCache font_cache;
+  ObservedPtr<CFX_GlyphCache> observed_cache;
+  {
+    CFX_Font font;
+    ASSERT_TRUE(font.LoadEmbedded(data, false, "old digest"));
+    observed_cache.Reset(font_cache.GetGlyphCache(&font).Get());
+  }
+  ASSERT_TRUE(observed_cache);
+
+  // Glyphs rendered after the cache was handed out still count, so the older
+  // cache gets dropped once they exceed the budget.
+  CFX_Font font;
+  ASSERT_TRUE(font.LoadEmbedded(data, false, "new digest"));
+  uint32_t glyph_index = FT_Get_Char_Index(font.GetFaceRec(), 'X');
+  ASSERT_NE(0u, glyph_index);
+  RetainPtr<CFX_GlyphCache> glyph_cache = font_cache.GetGlyphCache(&font);
+  CFX_TextRenderOptions options;
+  constexpr size_t kBudget = 16 * 1024 * 1024;
+  for (int size = 1000; glyph_cache->GetGlyphBitmapBytes() <= kBudget;
+       ++size) {
+    ASSERT_TRUE(observed_cache);
+    const CFX_Matrix matrix(size, 0, 0, size, 0, 0);
+    ASSERT_TRUE(glyph_cache->LoadGlyphBitmap(&font, glyph_index, false,
+                                             matrix, 0, FT_RENDER_MODE_NORMAL,
+                                             &options));
+  }
+  EXPECT_FALSE(observed_cache);
+}
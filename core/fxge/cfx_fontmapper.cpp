@@ -335,11 +335,15 @@ void CFX_FontMapper::AddInstalledFont(const ByteString& name, int charset) {
     }
 
     ByteString new_name = GetPSNameFromTT(hFont);
-    if (!new_name.IsEmpty())
-      m_LocalizedTTFonts.push_back(std::make_pair(new_name, name));
+    if (!new_name.IsEmpty()) {
+      m_LocalizedTTFonts.emplace(
+          new_name, std::make_pair(m_LocalizedTTFonts.size(), name));
+      m_NormalizedLocalizedFonts[TT_NormalizeName(new_name.c_str())] = name;
+    }
     m_pFontInfo->DeleteFont(hFont);
   }
-  m_InstalledTTFonts.push_back(name);
+  m_InstalledTTFonts.emplace(name, m_InstalledTTFonts.size());
+  m_NormalizedInstalledFonts[TT_NormalizeName(name.c_str())] = name;
   m_LastFamily = name;
 }
 
@@ -353,17 +357,14 @@ void CFX_FontMapper::LoadInstalledFonts() {
 
 ByteString CFX_FontMapper::MatchInstalledFonts(const ByteString& norm_name) {
   LoadInstalledFonts();
-  int i;
-  for (i = fxcrt::CollectionSize<int>(m_InstalledTTFonts) - 1; i >= 0; i--) {
-    ByteString norm1 = TT_NormalizeName(m_InstalledTTFonts[i].c_str());
-    if (norm1 == norm_name)
-      return m_InstalledTTFonts[i];
-  }
-  for (i = fxcrt::CollectionSize<int>(m_LocalizedTTFonts) - 1; i >= 0; i--) {
-    ByteString norm1 = TT_NormalizeName(m_LocalizedTTFonts[i].first.c_str());
-    if (norm1 == norm_name)
-      return m_LocalizedTTFonts[i].second;
-  }
+  auto it = m_NormalizedInstalledFonts.find(norm_name);
+  if (it != m_NormalizedInstalledFonts.end())
+    return it->second;
+
+  it = m_NormalizedLocalizedFonts.find(norm_name);
+  if (it != m_NormalizedLocalizedFonts.end())
+    return it->second;
+
   return ByteString();
 }
 
@@ -690,38 +691,46 @@ int CFX_FontMapper::GetFaceSize() const {
 }
 
 bool CFX_FontMapper::HasInstalledFont(ByteStringView name) const {
-  for (const auto& font : m_InstalledTTFonts) {
-    if (font == name)
-      return true;
-  }
-  return false;
+  return pdfium::Contains(m_InstalledTTFonts, ByteString(name));
 }
 
 bool CFX_FontMapper::HasLocalizedFont(ByteStringView name) const {
-  for (const auto& fontPair : m_LocalizedTTFonts) {
-    if (fontPair.first == name)
-      return true;
-  }
-  return false;
+  return pdfium::Contains(m_LocalizedTTFonts, ByteString(name));
 }
 
 #if defined(OS_WIN)
 Optional<ByteString> CFX_FontMapper::InstalledFontNameStartingWith(
     const ByteString& name) const {
-  for (const auto& thisname : m_InstalledTTFonts) {
-    if (thisname.First(name.GetLength()) == name)
-      return thisname;
+  // Names starting with |name| are contiguous in the map. Of those, return
+  // the one that was added first.
+  Optional<ByteString> result;
+  size_t result_order = 0;
+  for (auto it = m_InstalledTTFonts.lower_bound(name);
+       it != m_InstalledTTFonts.end() &&
+       it->first.First(name.GetLength()) == name;
+       ++it) {
+    if (!result.has_value() || it->second < result_order) {
+      result = it->first;
+      result_order = it->second;
+    }
   }
-  return pdfium::nullopt;
+  return result;
 }
 
 Optional<ByteString> CFX_FontMapper::LocalizedFontNameStartingWith(
     const ByteString& name) const {
-  for (const auto& thispair : m_LocalizedTTFonts) {
-    if (thispair.first.First(name.GetLength()) == name)
-      return thispair.second;
+  Optional<ByteString> result;
+  size_t result_order = 0;
+  for (auto it = m_LocalizedTTFonts.lower_bound(name);
+       it != m_LocalizedTTFonts.end() &&
+       it->first.First(name.GetLength()) == name;
+       ++it) {
+    if (!result.has_value() || it->second.first < result_order) {
+      result = it->second.second;
+      result_order = it->second.first;
+    }
   }
-  return pdfium::nullopt;
+  return result;
 }
 #endif  // defined(OS_WIN)
 
@@ -768,11 +777,17 @@ RetainPtr<CFX_Face> CFX_FontMapper::GetCachedTTCFace(void* hFont,
   RetainPtr<CFX_FontMgr::FontDesc> pFontDesc =
       m_pFontMgr->GetCachedTTCFontDesc(ttc_size, checksum);
   if (!pFontDesc) {
-    std::unique_ptr<uint8_t, FxFreeDeleter> pFontData(
-        FX_Alloc(uint8_t, ttc_size));
-    m_pFontInfo->GetFontData(hFont, kTableTTCF, {pFontData.get(), ttc_size});
-    pFontDesc = m_pFontMgr->AddCachedTTCFontDesc(
-        ttc_size, checksum, std::move(pFontData), ttc_size);
+    RetainPtr<CFX_MappedFile> pFile = m_pFontInfo->MapFontFile(hFont);
+    if (pFile && pFile->GetSpan().size() == ttc_size) {
+      pFontDesc = m_pFontMgr->AddCachedTTCFontDesc(ttc_size, checksum,
+                                                   std::move(pFile));
+    } else {
+      std::unique_ptr<uint8_t, FxFreeDeleter> pFontData(
+          FX_Alloc(uint8_t, ttc_size));
+      m_pFontInfo->GetFontData(hFont, kTableTTCF, {pFontData.get(), ttc_size});
+      pFontDesc = m_pFontMgr->AddCachedTTCFontDesc(
+          ttc_size, checksum, std::move(pFontData), ttc_size);
+    }
   }
   DCHECK(ttc_size >= font_size);
   uint32_t font_offset = ttc_size - font_size;
@@ -799,11 +814,17 @@ RetainPtr<CFX_Face> CFX_FontMapper::GetCachedFace(void* hFont,
   RetainPtr<CFX_FontMgr::FontDesc> pFontDesc =
       m_pFontMgr->GetCachedFontDesc(SubstName, weight, bItalic);
   if (!pFontDesc) {
-    std::unique_ptr<uint8_t, FxFreeDeleter> pFontData(
-        FX_Alloc(uint8_t, font_size));
-    m_pFontInfo->GetFontData(hFont, 0, {pFontData.get(), font_size});
-    pFontDesc = m_pFontMgr->AddCachedFontDesc(SubstName, weight, bItalic,
-                                              std::move(pFontData), font_size);
+    RetainPtr<CFX_MappedFile> pFile = m_pFontInfo->MapFontFile(hFont);
+    if (pFile && pFile->GetSpan().size() == font_size) {
+      pFontDesc = m_pFontMgr->AddCachedFontDesc(SubstName, weight, bItalic,
+                                                std::move(pFile));
+    } else {
+      std::unique_ptr<uint8_t, FxFreeDeleter> pFontData(
+          FX_Alloc(uint8_t, font_size));
+      m_pFontInfo->GetFontData(hFont, 0, {pFontData.get(), font_size});
+      pFontDesc = m_pFontMgr->AddCachedFontDesc(
+          SubstName, weight, bItalic, std::move(pFontData), font_size);
+    }
   }
   RetainPtr<CFX_Face> pFace(pFontDesc->GetFace(0));
   if (pFace)
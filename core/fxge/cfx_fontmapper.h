@@ -7,6 +7,7 @@
 #ifndef CORE_FXGE_CFX_FONTMAPPER_H_
 #define CORE_FXGE_CFX_FONTMAPPER_H_
 
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -117,8 +118,16 @@ class CFX_FontMapper {
   std::vector<FaceData> m_FaceArray;
   std::unique_ptr<SystemFontInfoIface> m_pFontInfo;
   UnownedPtr<CFX_FontMgr> const m_pFontMgr;
-  std::vector<ByteString> m_InstalledTTFonts;
-  std::vector<std::pair<ByteString, ByteString>> m_LocalizedTTFonts;
+  // Names of installed fonts, each mapped to the order in which it was first
+  // added.
+  std::map<ByteString, size_t> m_InstalledTTFonts;
+  // PostScript names of installed fonts with localized names, each mapped to
+  // the order in which it was first added and the localized name.
+  std::map<ByteString, std::pair<size_t, ByteString>> m_LocalizedTTFonts;
+  // Normalized names of installed fonts, and of the PostScript names of fonts
+  // with localized names, each mapped to the most recently added font.
+  std::map<ByteString, ByteString> m_NormalizedInstalledFonts;
+  std::map<ByteString, ByteString> m_NormalizedLocalizedFonts;
   RetainPtr<CFX_Face> m_MMFaces[MM_FACE_COUNT];
   RetainPtr<CFX_Face> m_FoxitFaces[FOXIT_FACE_COUNT];
 };
@@ -4,6 +4,11 @@
 
 #include "core/fxge/cfx_fontmapper.h"
 
+#include <memory>
+
+#include "build/build_config.h"
+#include "core/fxcrt/fx_codepage.h"
+#include "core/fxge/cfx_folderfontinfo.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 // Deliberately give this global variable external linkage.
@@ -40,3 +45,29 @@ TEST(CFX_FontMapper, MakeTag) {
   EXPECT_EQ(0xffffffffu,
             CFX_FontMapper::MakeTag(g_maybe_changes, '\xff', '\xff', '\xff'));
 }
+
+TEST(CFX_FontMapper, AddInstalledFont) {
+  CFX_FontMapper font_mapper(nullptr);
+  font_mapper.SetSystemFontInfo(std::make_unique<CFX_FolderFontInfo>());
+  font_mapper.AddInstalledFont("Arial Bold", FX_CHARSET_ANSI);
+  font_mapper.AddInstalledFont("Arial", FX_CHARSET_ANSI);
+  font_mapper.AddInstalledFont("Arial", FX_CHARSET_Symbol);
+  font_mapper.AddInstalledFont("Times New Roman", FX_CHARSET_ANSI);
+
+  EXPECT_EQ(4, font_mapper.GetFaceSize());
+  EXPECT_EQ("Arial", font_mapper.GetFaceName(2));
+  EXPECT_TRUE(font_mapper.HasInstalledFont("Arial"));
+  EXPECT_TRUE(font_mapper.HasInstalledFont("Arial Bold"));
+  EXPECT_FALSE(font_mapper.HasInstalledFont("Arial Italic"));
+  EXPECT_FALSE(font_mapper.HasInstalledFont("Ari"));
+  EXPECT_FALSE(font_mapper.HasLocalizedFont("Arial"));
+
+#if defined(OS_WIN)
+  // Returns the first added font with a matching name.
+  EXPECT_EQ("Arial Bold",
+            font_mapper.InstalledFontNameStartingWith("Arial").value());
+  EXPECT_EQ("Times New Roman",
+            font_mapper.InstalledFontNameStartingWith("Times").value());
+  EXPECT_FALSE(font_mapper.InstalledFontNameStartingWith("Courier"));
+#endif  // defined(OS_WIN)
+}
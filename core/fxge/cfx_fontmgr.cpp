@@ -6,9 +6,13 @@
 
 #include "core/fxge/cfx_fontmgr.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <memory>
 #include <utility>
 
+#include "core/fxcrt/fx_memory.h"
 #include "core/fxge/cfx_face.h"
 #include "core/fxge/cfx_fontmapper.h"
 #include "core/fxge/cfx_substfont.h"
@@ -61,6 +65,13 @@ ByteString KeyNameFromSize(int ttc_size, uint32_t checksum) {
   return ByteString::Format("%d:%d", ttc_size, checksum);
 }
 
+constexpr size_t kMinEmbeddedFaceMapPruneSize = 64;
+constexpr size_t kMaxRecentEmbeddedFaceBytes = 16 * 1024 * 1024;
+
+size_t GetFaceDataSize(const RetainPtr<CFX_Face>& face) {
+  return FXFT_Get_Face_Stream_Size(face->GetRec());
+}
+
 FXFT_LibraryRec* FTLibraryInitHelper() {
   FXFT_LibraryRec* pLibrary = nullptr;
   FT_Init_FreeType(&pLibrary);
@@ -71,7 +82,11 @@ FXFT_LibraryRec* FTLibraryInitHelper() {
 
 CFX_FontMgr::FontDesc::FontDesc(std::unique_ptr<uint8_t, FxFreeDeleter> pData,
                                 size_t size)
-    : m_Size(size), m_pFontData(std::move(pData)) {}
+    : m_pFontData(std::move(pData)), m_FontData(m_pFontData.get(), size) {}
+
+CFX_FontMgr::FontDesc::FontDesc(RetainPtr<CFX_MappedFile> pMappedFile)
+    : m_pMappedFile(std::move(pMappedFile)),
+      m_FontData(m_pMappedFile->GetSpan()) {}
 
 CFX_FontMgr::FontDesc::~FontDesc() = default;
 
@@ -88,6 +103,7 @@ CFX_Face* CFX_FontMgr::FontDesc::GetFace(size_t index) const {
 CFX_FontMgr::CFX_FontMgr()
     : m_FTLibrary(FTLibraryInitHelper()),
       m_pBuiltinMapper(std::make_unique<CFX_FontMapper>(this)),
+      m_EmbeddedFaceMapPruneSize(kMinEmbeddedFaceMapPruneSize),
       m_FTLibrarySupportsHinting(SetLcdFilterMode() ||
                                  FreeTypeVersionSupportsHinting()) {}
 
@@ -128,6 +144,16 @@ RetainPtr<CFX_FontMgr::FontDesc> CFX_FontMgr::AddCachedFontDesc(
   return pFontDesc;
 }
 
+RetainPtr<CFX_FontMgr::FontDesc> CFX_FontMgr::AddCachedFontDesc(
+    const ByteString& face_name,
+    int weight,
+    bool bItalic,
+    RetainPtr<CFX_MappedFile> pFile) {
+  auto pFontDesc = pdfium::MakeRetain<FontDesc>(std::move(pFile));
+  m_FaceMap[KeyNameFromFace(face_name, weight, bItalic)].Reset(pFontDesc.Get());
+  return pFontDesc;
+}
+
 RetainPtr<CFX_FontMgr::FontDesc> CFX_FontMgr::GetCachedTTCFontDesc(
     int ttc_size,
     uint32_t checksum) {
@@ -145,6 +171,82 @@ RetainPtr<CFX_FontMgr::FontDesc> CFX_FontMgr::AddCachedTTCFontDesc(
   return pNewDesc;
 }
 
+RetainPtr<CFX_FontMgr::FontDesc> CFX_FontMgr::AddCachedTTCFontDesc(
+    int ttc_size,
+    uint32_t checksum,
+    RetainPtr<CFX_MappedFile> pFile) {
+  auto pNewDesc = pdfium::MakeRetain<FontDesc>(std::move(pFile));
+  m_FaceMap[KeyNameFromSize(ttc_size, checksum)].Reset(pNewDesc.Get());
+  return pNewDesc;
+}
+
+RetainPtr<CFX_Face> CFX_FontMgr::GetCachedEmbeddedFace(
+    const ByteString& digest,
+    pdfium::span<const uint8_t> span) {
+  auto it = m_EmbeddedFaceMap.find(digest);
+  if (it == m_EmbeddedFaceMap.end() || !it->second)
+    return nullptr;
+
+  RetainPtr<CFX_Face> face = pdfium::WrapRetain(it->second.Get());
+  FXFT_FaceRec* rec = face->GetRec();
+  if (span.size() != FXFT_Get_Face_Stream_Size(rec) ||
+      memcmp(span.data(), FXFT_Get_Face_Stream_Base(rec), span.size()) != 0) {
+    return nullptr;
+  }
+
+  MarkEmbeddedFaceUsed(face);
+  return face;
+}
+
+RetainPtr<CFX_Face> CFX_FontMgr::AddCachedEmbeddedFace(
+    const ByteString& digest,
+    pdfium::span<const uint8_t> span) {
+  if (span.empty())
+    return nullptr;
+
+  std::unique_ptr<uint8_t, FxFreeDeleter> pData(
+      FX_AllocUninit(uint8_t, span.size()));
+  memcpy(pData.get(), span.data(), span.size());
+  auto pFontDesc = pdfium::MakeRetain<FontDesc>(std::move(pData), span.size());
+  RetainPtr<CFX_Face> face = NewFixedFace(pFontDesc, pFontDesc->FontData(), 0);
+  if (!face)
+    return nullptr;
+
+  pFontDesc->SetFace(0, face.Get());
+  if (m_EmbeddedFaceMap.size() >= m_EmbeddedFaceMapPruneSize) {
+    for (auto it = m_EmbeddedFaceMap.begin(); it != m_EmbeddedFaceMap.end();) {
+      if (it->second)
+        ++it;
+      else
+        it = m_EmbeddedFaceMap.erase(it);
+    }
+    m_EmbeddedFaceMapPruneSize = std::max(kMinEmbeddedFaceMapPruneSize,
+                                          m_EmbeddedFaceMap.size() * 2);
+  }
+  m_EmbeddedFaceMap[digest].Reset(face.Get());
+  MarkEmbeddedFaceUsed(face);
+  return face;
+}
+
+void CFX_FontMgr::MarkEmbeddedFaceUsed(const RetainPtr<CFX_Face>& face) {
+  auto it = m_RecentEmbeddedFaceMap.find(face.Get());
+  if (it != m_RecentEmbeddedFaceMap.end()) {
+    m_RecentEmbeddedFaces.splice(m_RecentEmbeddedFaces.begin(),
+                                 m_RecentEmbeddedFaces, it->second);
+    return;
+  }
+
+  m_RecentEmbeddedFaces.push_front(face);
+  m_RecentEmbeddedFaceMap[face.Get()] = m_RecentEmbeddedFaces.begin();
+  m_RecentEmbeddedFaceBytes += GetFaceDataSize(face);
+  while (m_RecentEmbeddedFaceBytes > kMaxRecentEmbeddedFaceBytes) {
+    const RetainPtr<CFX_Face>& last = m_RecentEmbeddedFaces.back();
+    m_RecentEmbeddedFaceBytes -= GetFaceDataSize(last);
+    m_RecentEmbeddedFaceMap.erase(last.Get());
+    m_RecentEmbeddedFaces.pop_back();
+  }
+}
+
 RetainPtr<CFX_Face> CFX_FontMgr::NewFixedFace(const RetainPtr<FontDesc>& pDesc,
                                               pdfium::span<const uint8_t> span,
                                               int face_index) {
@@ -7,9 +7,11 @@
 #ifndef CORE_FXGE_CFX_FONTMGR_H_
 #define CORE_FXGE_CFX_FONTMGR_H_
 
+#include <list>
 #include <map>
 #include <memory>
 
+#include "core/fxcrt/cfx_mappedfile.h"
 #include "core/fxcrt/fx_memory_wrappers.h"
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/observed_ptr.h"
@@ -30,17 +32,18 @@ class CFX_FontMgr {
     CONSTRUCT_VIA_MAKE_RETAIN;
     ~FontDesc() override;
 
-    pdfium::span<uint8_t> FontData() const {
-      return {m_pFontData.get(), m_Size};
-    }
+    pdfium::span<const uint8_t> FontData() const { return m_FontData; }
     void SetFace(size_t index, CFX_Face* face);
     CFX_Face* GetFace(size_t index) const;
 
    private:
     FontDesc(std::unique_ptr<uint8_t, FxFreeDeleter> pData, size_t size);
+    explicit FontDesc(RetainPtr<CFX_MappedFile> pMappedFile);
 
-    const size_t m_Size;
+    // Exactly one of these holds the data.
     std::unique_ptr<uint8_t, FxFreeDeleter> const m_pFontData;
+    RetainPtr<CFX_MappedFile> const m_pMappedFile;
+    const pdfium::span<const uint8_t> m_FontData;
     ObservedPtr<CFX_Face> m_TTCFaces[16];
   };
 
@@ -58,6 +61,10 @@ class CFX_FontMgr {
       bool bItalic,
       std::unique_ptr<uint8_t, FxFreeDeleter> pData,
       uint32_t size);
+  RetainPtr<FontDesc> AddCachedFontDesc(const ByteString& face_name,
+                                        int weight,
+                                        bool bItalic,
+                                        RetainPtr<CFX_MappedFile> pFile);
 
   RetainPtr<FontDesc> GetCachedTTCFontDesc(int ttc_size, uint32_t checksum);
   RetainPtr<FontDesc> AddCachedTTCFontDesc(
@@ -65,6 +72,17 @@ class CFX_FontMgr {
       uint32_t checksum,
       std::unique_ptr<uint8_t, FxFreeDeleter> pData,
       uint32_t size);
+  RetainPtr<FontDesc> AddCachedTTCFontDesc(int ttc_size,
+                                           uint32_t checksum,
+                                           RetainPtr<CFX_MappedFile> pFile);
+
+  // Faces for embedded font programs, shared by all fonts loaded from the
+  // same data, even across documents. |digest| identifies |span|, but a face
+  // is only returned if its data matches |span| exactly.
+  RetainPtr<CFX_Face> GetCachedEmbeddedFace(const ByteString& digest,
+                                            pdfium::span<const uint8_t> span);
+  RetainPtr<CFX_Face> AddCachedEmbeddedFace(const ByteString& digest,
+                                            pdfium::span<const uint8_t> span);
 
   RetainPtr<CFX_Face> NewFixedFace(const RetainPtr<FontDesc>& pDesc,
                                    pdfium::span<const uint8_t> span,
@@ -88,11 +106,21 @@ class CFX_FontMgr {
  private:
   bool FreeTypeVersionSupportsHinting() const;
   bool SetLcdFilterMode() const;
+  void MarkEmbeddedFaceUsed(const RetainPtr<CFX_Face>& face);
 
   // Must come before |m_pBuiltinMapper| and |m_FaceMap|.
   ScopedFXFTLibraryRec const m_FTLibrary;
   std::unique_ptr<CFX_FontMapper> m_pBuiltinMapper;
   std::map<ByteString, ObservedPtr<FontDesc>> m_FaceMap;
+  std::map<ByteString, ObservedPtr<CFX_Face>> m_EmbeddedFaceMap;
+  size_t m_EmbeddedFaceMapPruneSize;
+  // Most recently used embedded faces first. Keeps faces alive after the
+  // documents using them close, so the next document can reuse them, as
+  // long as their data fits in |kMaxRecentEmbeddedFaceBytes|.
+  std::list<RetainPtr<CFX_Face>> m_RecentEmbeddedFaces;
+  std::map<const CFX_Face*, std::list<RetainPtr<CFX_Face>>::iterator>
+      m_RecentEmbeddedFaceMap;
+  size_t m_RecentEmbeddedFaceBytes = 0;
   const bool m_FTLibrarySupportsHinting;
 };
 
@@ -0,0 +1,67 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_fontmgr.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/fxcrt/observed_ptr.h"
+#include "core/fxge/cfx_face.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/file_util.h"
+#include "testing/utils/path_service.h"
+
+namespace {
+
+std::vector<uint8_t> ReadTestFont() {
+  std::string path;
+  if (!PathService::GetTestFilePath("fonts/Ahem.ttf", &path))
+    return {};
+
+  size_t size;
+  std::unique_ptr<char, pdfium::FreeDeleter> contents =
+      GetFileContents(path.c_str(), &size);
+  if (!contents)
+    return {};
+
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(contents.get());
+  return std::vector<uint8_t>(data, data + size);
+}
+
+}  // namespace
+
+TEST(CFX_FontMgrTest, EmbeddedFaces) {
+  std::vector<uint8_t> data = ReadTestFont();
+  ASSERT_FALSE(data.empty());
+
+  CFX_FontMgr font_mgr;
+  EXPECT_FALSE(font_mgr.GetCachedEmbeddedFace("digest", data));
+
+  RetainPtr<CFX_Face> face = font_mgr.AddCachedEmbeddedFace("digest", data);
+  ASSERT_TRUE(face);
+  EXPECT_EQ(face, font_mgr.GetCachedEmbeddedFace("digest", data));
+  EXPECT_FALSE(font_mgr.GetCachedEmbeddedFace("other digest", data));
+
+  // The digest alone is not trusted.
+  std::vector<uint8_t> modified_data = data;
+  modified_data.back() ^= 1;
+  EXPECT_FALSE(font_mgr.GetCachedEmbeddedFace("digest", modified_data));
+
+  // Recently used faces stay alive for later documents.
+  ObservedPtr<CFX_Face> observed_face(face.Get());
+  face.Reset();
+  EXPECT_TRUE(observed_face);
+  EXPECT_EQ(observed_face.Get(),
+            font_mgr.GetCachedEmbeddedFace("digest", data).Get());
+}
+
+TEST(CFX_FontMgrTest, EmbeddedFacesInvalidData) {
+  CFX_FontMgr font_mgr;
+  const std::vector<uint8_t> data(100, 'x');
+  EXPECT_FALSE(font_mgr.AddCachedEmbeddedFace("digest", data));
+  EXPECT_FALSE(font_mgr.AddCachedEmbeddedFace("digest", {}));
+  EXPECT_FALSE(font_mgr.GetCachedEmbeddedFace("digest", data));
+}
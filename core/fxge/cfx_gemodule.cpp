@@ -17,18 +17,21 @@ CFX_GEModule* g_pGEModule = nullptr;
 
 }  // namespace
 
-CFX_GEModule::CFX_GEModule(const char** pUserFontPaths)
+CFX_GEModule::CFX_GEModule(const char** pUserFontPaths,
+                           const char* pFontCatalogPath)
     : m_pPlatform(PlatformIface::Create()),
       m_pFontMgr(std::make_unique<CFX_FontMgr>()),
       m_pFontCache(std::make_unique<CFX_FontCache>()),
-      m_pUserFontPaths(pUserFontPaths) {}
+      m_pUserFontPaths(pUserFontPaths),
+      m_pFontCatalogPath(pFontCatalogPath) {}
 
 CFX_GEModule::~CFX_GEModule() = default;
 
 // static
-void CFX_GEModule::Create(const char** pUserFontPaths) {
+void CFX_GEModule::Create(const char** pUserFontPaths,
+                          const char* pFontCatalogPath) {
   DCHECK(!g_pGEModule);
-  g_pGEModule = new CFX_GEModule(pUserFontPaths);
+  g_pGEModule = new CFX_GEModule(pUserFontPaths, pFontCatalogPath);
   g_pGEModule->m_pPlatform->Init();
   g_pGEModule->GetFontMgr()->SetSystemFontInfo(
       g_pGEModule->m_pPlatform->CreateDefaultSystemFontInfo());
@@ -36,7 +36,8 @@ class CFX_GEModule {
 #endif
   };
 
-  static void Create(const char** pUserFontPaths);
+  static void Create(const char** pUserFontPaths,
+                     const char* pFontCatalogPath);
   static void Destroy();
   static CFX_GEModule* Get();
 
@@ -44,15 +45,17 @@ class CFX_GEModule {
   CFX_FontMgr* GetFontMgr() const { return m_pFontMgr.get(); }
   PlatformIface* GetPlatform() const { return m_pPlatform.get(); }
   const char** GetUserFontPaths() const { return m_pUserFontPaths; }
+  const char* GetFontCatalogPath() const { return m_pFontCatalogPath; }
 
  private:
-  explicit CFX_GEModule(const char** pUserFontPaths);
+  CFX_GEModule(const char** pUserFontPaths, const char* pFontCatalogPath);
   ~CFX_GEModule();
 
   std::unique_ptr<PlatformIface> const m_pPlatform;
   std::unique_ptr<CFX_FontMgr> const m_pFontMgr;
   std::unique_ptr<CFX_FontCache> const m_pFontCache;
   const char** const m_pUserFontPaths;
+  const char* const m_pFontCatalogPath;
 };
 
 #endif  // CORE_FXGE_CFX_GEMODULE_H_
@@ -0,0 +1,58 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_glyphatlas.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/fxcrt/fx_memory.h"
+#include "core/fxcrt/fx_safe_types.h"
+
+CFX_GlyphAtlas::CFX_GlyphAtlas() = default;
+
+CFX_GlyphAtlas::~CFX_GlyphAtlas() = default;
+
+uint8_t* CFX_GlyphAtlas::Allocate(size_t size) {
+  FX_SAFE_SIZE_T safe_size = size;
+  safe_size += kAlignment - 1;
+  if (!safe_size.IsValid())
+    return nullptr;
+
+  size = safe_size.ValueOrDie();
+  size &= ~(kAlignment - 1);
+  if (size == 0)
+    size = kAlignment;
+
+  // Large glyphs get a page of their own, so they do not waste the rest of
+  // the current page.
+  if (size > kMaxPageSize / 4)
+    return AllocatePage(size);
+
+  if (size > m_RemainingBytes) {
+    uint8_t* page = AllocatePage(m_NextPageSize);
+    if (!page)
+      return nullptr;
+
+    m_pNextFree = page;
+    m_RemainingBytes = m_NextPageSize;
+    m_NextPageSize = std::min(m_NextPageSize * 2, kMaxPageSize);
+  }
+
+  uint8_t* result = m_pNextFree;
+  m_pNextFree += size;
+  m_RemainingBytes -= size;
+  return result;
+}
+
+uint8_t* CFX_GlyphAtlas::AllocatePage(size_t size) {
+  // FX_TryAlloc() returns zeroed memory aligned for any fundamental type.
+  std::unique_ptr<uint8_t, FxFreeDeleter> page(FX_TryAlloc(uint8_t, size));
+  if (!page)
+    return nullptr;
+
+  m_ReservedBytes += size;
+  m_Pages.push_back(std::move(page));
+  return m_Pages.back().get();
+}
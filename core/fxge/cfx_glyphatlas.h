@@ -0,0 +1,49 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_CFX_GLYPHATLAS_H_
+#define CORE_FXGE_CFX_GLYPHATLAS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/fxcrt/fx_memory_wrappers.h"
+
+// Packs the pixels of glyph bitmaps rendered at one size into a few large
+// pages of memory, instead of making one heap allocation per glyph. Memory is
+// only released when the atlas is destroyed, which suits glyph caches since
+// they never evict individual glyphs.
+class CFX_GlyphAtlas {
+ public:
+  static constexpr size_t kAlignment = 16;
+  static constexpr size_t kMinPageSize = 4 * 1024;
+  static constexpr size_t kMaxPageSize = 64 * 1024;
+
+  CFX_GlyphAtlas();
+  ~CFX_GlyphAtlas();
+
+  CFX_GlyphAtlas(const CFX_GlyphAtlas&) = delete;
+  CFX_GlyphAtlas& operator=(const CFX_GlyphAtlas&) = delete;
+
+  // Returns a zero-filled, |kAlignment|-aligned buffer of |size| bytes that
+  // stays valid for the lifetime of the atlas, or nullptr on failure.
+  uint8_t* Allocate(size_t size);
+
+  size_t GetPageCount() const { return m_Pages.size(); }
+  size_t GetReservedBytes() const { return m_ReservedBytes; }
+
+ private:
+  uint8_t* AllocatePage(size_t size);
+
+  std::vector<std::unique_ptr<uint8_t, FxFreeDeleter>> m_Pages;
+  uint8_t* m_pNextFree = nullptr;
+  size_t m_RemainingBytes = 0;
+  size_t m_NextPageSize = kMinPageSize;
+  size_t m_ReservedBytes = 0;
+};
+
+#endif  // CORE_FXGE_CFX_GLYPHATLAS_H_
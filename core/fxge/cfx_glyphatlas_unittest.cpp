@@ -0,0 +1,79 @@
+// Copyright 2026 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_glyphatlas.h"
+
+#include <stdint.h>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+bool IsAligned(const uint8_t* ptr) {
+  return reinterpret_cast<uintptr_t>(ptr) % CFX_GlyphAtlas::kAlignment == 0;
+}
+
+}  // namespace
+
+TEST(CFX_GlyphAtlasTest, PacksSmallAllocations) {
+  CFX_GlyphAtlas atlas;
+  EXPECT_EQ(0u, atlas.GetPageCount());
+
+  uint8_t* first = atlas.Allocate(10);
+  ASSERT_TRUE(first);
+  EXPECT_TRUE(IsAligned(first));
+  for (size_t i = 0; i < 10; ++i)
+    EXPECT_EQ(0, first[i]);
+
+  uint8_t* second = atlas.Allocate(1);
+  ASSERT_TRUE(second);
+  EXPECT_EQ(first + CFX_GlyphAtlas::kAlignment, second);
+
+  uint8_t* third = atlas.Allocate(0);
+  ASSERT_TRUE(third);
+  EXPECT_EQ(second + CFX_GlyphAtlas::kAlignment, third);
+
+  EXPECT_EQ(1u, atlas.GetPageCount());
+  EXPECT_EQ(CFX_GlyphAtlas::kMinPageSize, atlas.GetReservedBytes());
+}
+
+TEST(CFX_GlyphAtlasTest, PagesGrow) {
+  CFX_GlyphAtlas atlas;
+  constexpr size_t kSize = 1024;
+  for (size_t i = 0; i < CFX_GlyphAtlas::kMinPageSize / kSize; ++i)
+    ASSERT_TRUE(atlas.Allocate(kSize));
+  EXPECT_EQ(1u, atlas.GetPageCount());
+
+  uint8_t* next = atlas.Allocate(kSize);
+  ASSERT_TRUE(next);
+  EXPECT_TRUE(IsAligned(next));
+  EXPECT_EQ(2u, atlas.GetPageCount());
+  EXPECT_EQ(3 * CFX_GlyphAtlas::kMinPageSize, atlas.GetReservedBytes());
+
+  // Page sizes stop growing at |kMaxPageSize|.
+  while (atlas.GetPageCount() < 10)
+    ASSERT_TRUE(atlas.Allocate(kSize));
+  size_t reserved = atlas.GetReservedBytes();
+  size_t pages = atlas.GetPageCount();
+  while (atlas.GetPageCount() == pages)
+    ASSERT_TRUE(atlas.Allocate(kSize));
+  EXPECT_EQ(reserved + CFX_GlyphAtlas::kMaxPageSize, atlas.GetReservedBytes());
+}
+
+TEST(CFX_GlyphAtlasTest, LargeAllocationsGetOwnPage) {
+  CFX_GlyphAtlas atlas;
+  uint8_t* small = atlas.Allocate(16);
+  ASSERT_TRUE(small);
+
+  constexpr size_t kLargeSize = CFX_GlyphAtlas::kMaxPageSize + 1;
+  uint8_t* large = atlas.Allocate(kLargeSize);
+  ASSERT_TRUE(large);
+  EXPECT_TRUE(IsAligned(large));
+  EXPECT_EQ(0, large[kLargeSize - 1]);
+  EXPECT_EQ(2u, atlas.GetPageCount());
+
+  // The partially used page is still used for small allocations.
+  EXPECT_EQ(small + 16, atlas.Allocate(16));
+  EXPECT_EQ(2u, atlas.GetPageCount());
+}
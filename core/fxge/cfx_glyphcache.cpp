@@ -16,6 +16,7 @@
 #include "build/build_config.h"
 #include "core/fxcrt/fx_codepage.h"
 #include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_fontcache.h"
 #include "core/fxge/cfx_fontmgr.h"
 #include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_glyphbitmap.h"
@@ -98,20 +99,43 @@ void GenKey(UniqueKeyGen* pKeyGen,
   }
 }
 
+#if defined(_SKIA_SUPPORT_) || defined(_SKIA_SUPPORT_PATHS_)
+std::unique_ptr<SkMemoryStream> MakeFontDataStream(
+    pdfium::span<const uint8_t> span,
+    bool bCopyData) {
+  if (bCopyData)
+    return SkMemoryStream::MakeCopy(span.data(), span.size());
+  return std::make_unique<SkMemoryStream>(span.data(), span.size());
+}
+#endif
+
 }  // namespace
 
+CFX_GlyphCache::SizeGlyphCache::SizeGlyphCache() = default;
+
+CFX_GlyphCache::SizeGlyphCache::~SizeGlyphCache() = default;
+
 CFX_GlyphCache::CFX_GlyphCache(RetainPtr<CFX_Face> face) : m_Face(face) {}
 
 CFX_GlyphCache::~CFX_GlyphCache() = default;
 
+size_t CFX_GlyphCache::GetGlyphBitmapBytes() const {
+  size_t bytes = 0;
+  for (const auto& size_cache : m_SizeMap)
+    bytes += size_cache.second.atlas.GetReservedBytes();
+  return bytes;
+}
+
 std::unique_ptr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
     const CFX_Font* pFont,
     uint32_t glyph_index,
     bool bFontStyle,
     const CFX_Matrix& matrix,
     int dest_width,
-    int anti_alias) {
-  if (!GetFaceRec())
+    int anti_alias,
+    CFX_GlyphAtlas* atlas) {
+  FXFT_FaceRec* face_rec = pFont->GetFaceRec();
+  if (!face_rec)
     return nullptr;
 
   FT_Matrix ft_matrix;
@@ -141,11 +165,11 @@ std::unique_ptr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
     }
   }
 
-  ScopedFontTransform scoped_transform(GetFace(), &ft_matrix);
+  ScopedFontTransform scoped_transform(pFont->GetFace(), &ft_matrix);
   int load_flags = FT_LOAD_NO_BITMAP | FT_LOAD_PEDANTIC;
-  if (!(GetFaceRec()->face_flags & FT_FACE_FLAG_SFNT))
+  if (!(face_rec->face_flags & FT_FACE_FLAG_SFNT))
     load_flags |= FT_LOAD_NO_HINTING;
-  int error = FT_Load_Glyph(GetFaceRec(), glyph_index, load_flags);
+  int error = FT_Load_Glyph(face_rec, glyph_index, load_flags);
   if (error) {
     // if an error is returned, try to reload glyphs without hinting.
     if (load_flags & FT_LOAD_NO_HINTING)
@@ -153,7 +177,7 @@ std::unique_ptr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
 
     load_flags |= FT_LOAD_NO_HINTING;
     load_flags &= ~FT_LOAD_PEDANTIC;
-    error = FT_Load_Glyph(GetFaceRec(), glyph_index, load_flags);
+    error = FT_Load_Glyph(face_rec, glyph_index, load_flags);
     if (error)
       return nullptr;
   }
@@ -174,34 +198,48 @@ std::unique_ptr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
             (abs(static_cast<int>(ft_matrix.xx)) +
              abs(static_cast<int>(ft_matrix.xy))) /
             36655;
-    FT_Outline_Embolden(FXFT_Get_Glyph_Outline(GetFaceRec()),
+    FT_Outline_Embolden(FXFT_Get_Glyph_Outline(face_rec),
                         level.ValueOrDefault(0));
   }
   FT_Library_SetLcdFilter(CFX_GEModule::Get()->GetFontMgr()->GetFTLibrary(),
                           FT_LCD_FILTER_DEFAULT);
-  error = FXFT_Render_Glyph(GetFaceRec(), anti_alias);
+  error = FXFT_Render_Glyph(face_rec, anti_alias);
   if (error)
     return nullptr;
 
-  int bmwidth = FXFT_Get_Bitmap_Width(FXFT_Get_Glyph_Bitmap(GetFaceRec()));
-  int bmheight = FXFT_Get_Bitmap_Rows(FXFT_Get_Glyph_Bitmap(GetFaceRec()));
+  int bmwidth = FXFT_Get_Bitmap_Width(FXFT_Get_Glyph_Bitmap(face_rec));
+  int bmheight = FXFT_Get_Bitmap_Rows(FXFT_Get_Glyph_Bitmap(face_rec));
   if (bmwidth > kMaxGlyphDimension || bmheight > kMaxGlyphDimension)
     return nullptr;
   int dib_width = bmwidth;
+  const FXDIB_Format format = anti_alias == FT_RENDER_MODE_MONO
+                                  ? FXDIB_Format::k1bppMask
+                                  : FXDIB_Format::k8bppMask;
+  Optional<CFX_DIBitmap::PitchAndSize> pitch_size =
+      CFX_DIBitmap::CalculatePitchAndSize(dib_width, bmheight, format,
+                                          /*pitch=*/0);
+  if (!pitch_size.has_value())
+    return nullptr;
+
+  // Leave the same slack after the pixels as CFX_DIBitmap::Create() does.
+  uint8_t* pixels = atlas->Allocate(pitch_size.value().size + 4);
+  if (!pixels)
+    return nullptr;
+
   auto pGlyphBitmap =
-      std::make_unique<CFX_GlyphBitmap>(FXFT_Get_Glyph_BitmapLeft(GetFaceRec()),
-                                        FXFT_Get_Glyph_BitmapTop(GetFaceRec()));
-  pGlyphBitmap->GetBitmap()->Create(dib_width, bmheight,
-                                    anti_alias == FT_RENDER_MODE_MONO
-                                        ? FXDIB_Format::k1bppMask
-                                        : FXDIB_Format::k8bppMask);
+      std::make_unique<CFX_GlyphBitmap>(FXFT_Get_Glyph_BitmapLeft(face_rec),
+                                        FXFT_Get_Glyph_BitmapTop(face_rec));
+  if (!pGlyphBitmap->GetBitmap()->Create(dib_width, bmheight, format, pixels,
+                                         pitch_size.value().pitch)) {
+    return nullptr;
+  }
   int dest_pitch = pGlyphBitmap->GetBitmap()->GetPitch();
-  int src_pitch = FXFT_Get_Bitmap_Pitch(FXFT_Get_Glyph_Bitmap(GetFaceRec()));
+  int src_pitch = FXFT_Get_Bitmap_Pitch(FXFT_Get_Glyph_Bitmap(face_rec));
   uint8_t* pDestBuf = pGlyphBitmap->GetBitmap()->GetBuffer();
   uint8_t* pSrcBuf = static_cast<uint8_t*>(
-      FXFT_Get_Bitmap_Buffer(FXFT_Get_Glyph_Bitmap(GetFaceRec())));
+      FXFT_Get_Bitmap_Buffer(FXFT_Get_Glyph_Bitmap(face_rec)));
   if (anti_alias != FT_RENDER_MODE_MONO &&
-      FXFT_Get_Bitmap_PixelMode(FXFT_Get_Glyph_Bitmap(GetFaceRec())) ==
+      FXFT_Get_Bitmap_PixelMode(FXFT_Get_Glyph_Bitmap(face_rec)) ==
           FT_PIXEL_MODE_MONO) {
     int bytes = anti_alias == FT_RENDER_MODE_LCD ? 3 : 1;
     for (int i = 0; i < bmheight; i++) {
@@ -224,7 +262,7 @@ std::unique_ptr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
 const CFX_Path* CFX_GlyphCache::LoadGlyphPath(const CFX_Font* pFont,
                                               uint32_t glyph_index,
                                               int dest_width) {
-  if (!GetFaceRec() || glyph_index == kInvalidGlyphIndex)
+  if (!pFont->GetFaceRec() || glyph_index == kInvalidGlyphIndex)
     return nullptr;
 
   const auto* pSubstFont = pFont->GetSubstFont();
@@ -278,15 +316,15 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
   auto it = m_SizeMap.find(FaceGlyphsKey);
   if (it != m_SizeMap.end()) {
     SizeGlyphCache* pSizeCache = &(it->second);
-    auto it2 = pSizeCache->find(glyph_index);
-    if (it2 != pSizeCache->end())
+    auto it2 = pSizeCache->glyphs.find(glyph_index);
+    if (it2 != pSizeCache->glyphs.end())
       return it2->second.get();
 
     pGlyphBitmap = RenderGlyph_Nativetext(pFont, glyph_index, matrix,
                                           dest_width, anti_alias);
     if (pGlyphBitmap) {
       CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-      (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
+      pSizeCache->glyphs[glyph_index] = std::move(pGlyphBitmap);
       return pResult;
     }
   } else {
@@ -294,11 +332,7 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
                                           dest_width, anti_alias);
     if (pGlyphBitmap) {
       CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-
-      SizeGlyphCache cache;
-      cache[glyph_index] = std::move(pGlyphBitmap);
-
-      m_SizeMap[FaceGlyphsKey] = std::move(cache);
+      m_SizeMap[FaceGlyphsKey].glyphs[glyph_index] = std::move(pGlyphBitmap);
       return pResult;
     }
   }
@@ -312,17 +346,17 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
 
 #if defined(_SKIA_SUPPORT_) || defined(_SKIA_SUPPORT_PATHS_)
 CFX_TypeFace* CFX_GlyphCache::GetDeviceCache(const CFX_Font* pFont) {
+  // A shared cache may outlive |pFont|, so it needs its own copy of the data.
+  const bool bCopyData = !m_Face;
   if (!m_pTypeface) {
-    pdfium::span<const uint8_t> span = pFont->GetFontSpan();
     m_pTypeface = SkTypeface::MakeFromStream(
-        std::make_unique<SkMemoryStream>(span.data(), span.size()));
+        MakeFontDataStream(pFont->GetFontSpan(), bCopyData));
   }
 #if defined(OS_WIN)
   if (!m_pTypeface) {
     sk_sp<SkFontMgr> customMgr(SkFontMgr_New_Custom_Empty());
-    pdfium::span<const uint8_t> span = pFont->GetFontSpan();
     m_pTypeface = customMgr->makeFromStream(
-        std::make_unique<SkMemoryStream>(span.data(), span.size()));
+        MakeFontDataStream(pFont->GetFontSpan(), bCopyData));
   }
 #endif  // defined(OS_WIN)
   return m_pTypeface.get();
@@ -341,22 +375,23 @@ CFX_GlyphBitmap* CFX_GlyphCache::LookUpGlyphBitmap(
     bool bFontStyle,
     int dest_width,
     int anti_alias) {
-  SizeGlyphCache* pSizeCache;
-  auto it = m_SizeMap.find(FaceGlyphsKey);
-  if (it == m_SizeMap.end()) {
-    m_SizeMap[FaceGlyphsKey] = SizeGlyphCache();
-    pSizeCache = &(m_SizeMap[FaceGlyphsKey]);
-  } else {
-    pSizeCache = &(it->second);
-  }
-
-  auto it2 = pSizeCache->find(glyph_index);
-  if (it2 != pSizeCache->end())
-    return it2->second.get();
+  SizeGlyphCache* pSizeCache = &m_SizeMap[FaceGlyphsKey];
+  auto it = pSizeCache->glyphs.find(glyph_index);
+  if (it != pSizeCache->glyphs.end())
+    return it->second.get();
 
-  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap = RenderGlyph(
-      pFont, glyph_index, bFontStyle, matrix, dest_width, anti_alias);
+  const size_t reserved_bytes = pSizeCache->atlas.GetReservedBytes();
+  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap =
+      RenderGlyph(pFont, glyph_index, bFontStyle, matrix, dest_width,
+                  anti_alias, &pSizeCache->atlas);
   CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-  (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
+  pSizeCache->glyphs[glyph_index] = std::move(pGlyphBitmap);
+
+  // The caller holds a reference to this cache, so it survives even if the
+  // font cache drops its own to stay within budget.
+  const size_t added_bytes =
+      pSizeCache->atlas.GetReservedBytes() - reserved_bytes;
+  if (added_bytes && m_pFontCache)
+    m_pFontCache->OnGlyphBitmapBytesAdded(this, added_bytes);
   return pResult;
 }
@@ -14,7 +14,9 @@
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/cfx_face.h"
+#include "core/fxge/cfx_glyphatlas.h"
 
 #if defined(_SKIA_SUPPORT_) || defined(_SKIA_SUPPORT_PATHS_)
 #include "core/fxge/fx_font.h"
@@ -22,6 +24,7 @@
 #endif
 
 class CFX_Font;
+class CFX_FontCache;
 class CFX_GlyphBitmap;
 class CFX_Matrix;
 class CFX_Path;
@@ -43,6 +46,13 @@ class CFX_GlyphCache : public Retainable, public Observable {
                                 uint32_t glyph_index,
                                 int dest_width);
 
+  // Returns the memory reserved for the pixels of cached glyph bitmaps.
+  size_t GetGlyphBitmapBytes() const;
+
+  // Set for shared caches, so that |pFontCache| can charge the glyph bitmap
+  // memory they add against its budget as it gets added.
+  void SetFontCache(CFX_FontCache* pFontCache) { m_pFontCache = pFontCache; }
+
   RetainPtr<CFX_Face> GetFace() { return m_Face; }
   FXFT_FaceRec* GetFaceRec() { return m_Face ? m_Face->GetRec() : nullptr; }
 
@@ -53,7 +63,16 @@ class CFX_GlyphCache : public Retainable, public Observable {
  private:
   explicit CFX_GlyphCache(RetainPtr<CFX_Face> face);
 
-  using SizeGlyphCache = std::map<uint32_t, std::unique_ptr<CFX_GlyphBitmap>>;
+  // Glyphs rendered at one size and with one anti-aliasing mode.
+  struct SizeGlyphCache {
+    SizeGlyphCache();
+    ~SizeGlyphCache();
+
+    // Holds the pixels of the bitmaps in |glyphs|, so it must outlive them.
+    CFX_GlyphAtlas atlas;
+    std::map<uint32_t, std::unique_ptr<CFX_GlyphBitmap>> glyphs;
+  };
+
   // <glyph_index, width, weight, angle, vertical>
   using PathMapKey = std::tuple<uint32_t, int, int, int, bool>;
 
@@ -62,7 +81,8 @@ class CFX_GlyphCache : public Retainable, public Observable {
                                                bool bFontStyle,
                                                const CFX_Matrix& matrix,
                                                int dest_width,
-                                               int anti_alias);
+                                               int anti_alias,
+                                               CFX_GlyphAtlas* atlas);
   std::unique_ptr<CFX_GlyphBitmap> RenderGlyph_Nativetext(
       const CFX_Font* pFont,
       uint32_t glyph_index,
@@ -79,7 +99,10 @@ class CFX_GlyphCache : public Retainable, public Observable {
   void InitPlatform();
   void DestroyPlatform();
 
+  // Null for caches shared by all fonts with the same content digest. Glyphs
+  // are always rendered with the face of the CFX_Font passed in.
   RetainPtr<CFX_Face> const m_Face;
+  UnownedPtr<CFX_FontCache> m_pFontCache;
   std::map<ByteString, SizeGlyphCache> m_SizeMap;
   std::map<PathMapKey, std::unique_ptr<CFX_Path>> m_PathMap;
 #if defined(_SKIA_SUPPORT_) || defined(_SKIA_SUPPORT_PATHS_)
@@ -20,6 +20,11 @@ class CFX_GraphState {
 
   void Emplace();
 
+  bool operator==(const CFX_GraphState& that) const {
+    return m_Ref == that.m_Ref;
+  }
+  bool operator!=(const CFX_GraphState& that) const { return !(*this == that); }
+
   void SetLineDash(std::vector<float> dashes, float phase, float scale);
   void SetLineDashPhase(float phase);
   std::vector<float> GetLineDashArray() const;
@@ -286,6 +286,10 @@ void CFX_Path::Append(const CFX_Path& src, const CFX_Matrix* matrix) {
     m_Points[i].m_Point = matrix->Transform(m_Points[i].m_Point);
 }
 
+void CFX_Path::AppendPoints(pdfium::span<const Point> points) {
+  m_Points.insert(m_Points.end(), points.begin(), points.end());
+}
+
 void CFX_Path::AppendPoint(const CFX_PointF& point, Point::Type type) {
   m_Points.push_back(Point(point, type, /*close=*/false));
 }
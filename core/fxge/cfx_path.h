@@ -13,6 +13,7 @@
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "third_party/base/optional.h"
+#include "third_party/base/span.h"
 
 class CFX_Path {
  public:
@@ -29,6 +30,12 @@ class CFX_Path {
       return m_Type == type && !m_CloseFigure;
     }
 
+    bool operator==(const Point& other) const {
+      return m_Point == other.m_Point && m_Type == other.m_Type &&
+             m_CloseFigure == other.m_CloseFigure;
+    }
+    bool operator!=(const Point& other) const { return !(*this == other); }
+
     CFX_PointF m_Point;
     Type m_Type;
     bool m_CloseFigure;
@@ -59,6 +66,7 @@ class CFX_Path {
   Optional<CFX_FloatRect> GetRect(const CFX_Matrix* matrix) const;
 
   void Append(const CFX_Path& src, const CFX_Matrix* matrix);
+  void AppendPoints(pdfium::span<const Point> points);
   void AppendFloatRect(const CFX_FloatRect& rect);
   void AppendRect(float left, float bottom, float right, float top);
   void AppendLine(const CFX_PointF& pt1, const CFX_PointF& pt2);
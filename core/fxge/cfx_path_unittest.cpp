@@ -371,3 +371,16 @@ TEST(CFX_Path, Append) {
   EXPECT_EQ(CFX_PointF(65, 82), path.GetPoint(2));
   EXPECT_EQ(CFX_PointF(65, 82), path.GetPoint(3));
 }
+
+TEST(CFX_Path, AppendPoints) {
+  CFX_Path source;
+  source.AppendRect(1, 2, 3, 4);
+
+  CFX_Path path;
+  path.AppendPoint({0, 0}, CFX_Path::Point::Type::kMove);
+  path.AppendPoints(source.GetPoints());
+  ASSERT_EQ(6u, path.GetPoints().size());
+  EXPECT_EQ(CFX_Path::Point::Type::kMove, path.GetType(1));
+  EXPECT_EQ(CFX_PointF(1, 2), path.GetPoint(1));
+  EXPECT_TRUE(path.IsClosingFigure(5));
+}
@@ -209,20 +209,21 @@ void SetAlpha(bool has_alpha, uint8_t* alpha) {
     alpha[3] = 255;
 }
 
-void DrawNormalTextHelper(const RetainPtr<CFX_DIBitmap>& bitmap,
-                          const RetainPtr<CFX_DIBitmap>& pGlyph,
-                          int nrows,
-                          int left,
-                          int top,
-                          int start_col,
-                          int end_col,
-                          bool normalize,
-                          int x_subpixel,
-                          int a,
-                          int r,
-                          int g,
-                          int b) {
-  const bool has_alpha = bitmap->GetFormat() == FXDIB_Format::kArgb;
+// |normalize| and |has_alpha| are template parameters so that the checks on
+// them get hoisted out of the per-pixel loops.
+template <bool normalize, bool has_alpha>
+void DrawNormalTextHelperImpl(const RetainPtr<CFX_DIBitmap>& bitmap,
+                              const RetainPtr<CFX_DIBitmap>& pGlyph,
+                              int nrows,
+                              int left,
+                              int top,
+                              int start_col,
+                              int end_col,
+                              int x_subpixel,
+                              int a,
+                              int r,
+                              int g,
+                              int b) {
   uint8_t* src_buf = pGlyph->GetBuffer();
   int src_pitch = pGlyph->GetPitch();
   uint8_t* dest_buf = bitmap->GetBuffer();
@@ -299,6 +300,132 @@ void DrawNormalTextHelper(const RetainPtr<CFX_DIBitmap>& bitmap,
   }
 }
 
+void DrawNormalTextHelper(const RetainPtr<CFX_DIBitmap>& bitmap,
+                          const RetainPtr<CFX_DIBitmap>& pGlyph,
+                          int nrows,
+                          int left,
+                          int top,
+                          int start_col,
+                          int end_col,
+                          bool normalize,
+                          int x_subpixel,
+                          int a,
+                          int r,
+                          int g,
+                          int b) {
+  const bool has_alpha = bitmap->GetFormat() == FXDIB_Format::kArgb;
+  auto* helper = normalize
+                     ? (has_alpha ? &DrawNormalTextHelperImpl<true, true>
+                                  : &DrawNormalTextHelperImpl<true, false>)
+                     : (has_alpha ? &DrawNormalTextHelperImpl<false, true>
+                                  : &DrawNormalTextHelperImpl<false, false>);
+  helper(bitmap, pGlyph, nrows, left, top, start_col, end_col, x_subpixel, a,
+         r, g, b);
+}
+
+// The CompositeGlyphRowTo*() functions blend one row of an 8bpp glyph
+// coverage mask, producing the same results as CFX_ScanlineCompositor does
+// for BlendMode::kNormal without a clip mask.
+void CompositeGlyphRowToMask(const uint8_t* src_scan,
+                             int width,
+                             int mask_alpha,
+                             uint8_t* dest_scan) {
+  for (int col = 0; col < width; ++col) {
+    int src_alpha = mask_alpha * src_scan[col] / 255;
+    uint8_t back_alpha = dest_scan[col];
+    dest_scan[col] = back_alpha + src_alpha - back_alpha * src_alpha / 255;
+  }
+}
+
+void CompositeGlyphRowToRgb(const uint8_t* src_scan,
+                            int width,
+                            int mask_alpha,
+                            int r,
+                            int g,
+                            int b,
+                            int Bpp,
+                            uint8_t* dest_scan) {
+  for (int col = 0; col < width; ++col) {
+    int src_alpha = mask_alpha * src_scan[col] / 255;
+    ApplyAlpha(dest_scan, b, g, r, src_alpha);
+    dest_scan += Bpp;
+  }
+}
+
+void CompositeGlyphRowToArgb(const uint8_t* src_scan,
+                             int width,
+                             int mask_alpha,
+                             int r,
+                             int g,
+                             int b,
+                             uint8_t* dest_scan) {
+  for (int col = 0; col < width; ++col) {
+    int src_alpha = mask_alpha * src_scan[col] / 255;
+    uint8_t back_alpha = dest_scan[3];
+    if (back_alpha == 0)
+      FXARGB_SETDIB(dest_scan, ArgbEncode(src_alpha, r, g, b));
+    else if (src_alpha != 0)
+      ApplyDestAlpha(back_alpha, src_alpha, r, g, b, dest_scan);
+    dest_scan += 4;
+  }
+}
+
+// Blends |pGlyph| into |bitmap| in |fill_color|, with the glyph's top left
+// corner at (|left|, |top|). Same as CFX_DIBitmap::CompositeMask() with
+// BlendMode::kNormal, but without setting up a compositor for every glyph.
+// Returns false if either bitmap has a format this does not handle.
+bool CompositeGlyphMask(const RetainPtr<CFX_DIBitmap>& bitmap,
+                        const RetainPtr<CFX_DIBitmap>& pGlyph,
+                        int left,
+                        int top,
+                        uint32_t fill_color) {
+  const FXDIB_Format format = bitmap->GetFormat();
+  if (pGlyph->GetFormat() != FXDIB_Format::k8bppMask ||
+      (format != FXDIB_Format::k8bppMask && format != FXDIB_Format::kArgb &&
+       format != FXDIB_Format::kRgb && format != FXDIB_Format::kRgb32)) {
+    return false;
+  }
+
+  FX_SAFE_INT32 right = left;
+  right += pGlyph->GetWidth();
+  FX_SAFE_INT32 bottom = top;
+  bottom += pGlyph->GetHeight();
+  if (!right.IsValid() || !bottom.IsValid())
+    return true;
+
+  const int start_col = std::max(left, 0);
+  const int end_col = std::min<int>(right.ValueOrDie(), bitmap->GetWidth());
+  const int start_row = std::max(top, 0);
+  const int end_row = std::min<int>(bottom.ValueOrDie(), bitmap->GetHeight());
+  int a;
+  int r;
+  int g;
+  int b;
+  std::tie(a, r, g, b) = ArgbDecode(fill_color);
+  if (start_col >= end_col || start_row >= end_row || a == 0)
+    return true;
+
+  const int width = end_col - start_col;
+  const int Bpp = bitmap->GetBPP() / 8;
+  for (int row = start_row; row < end_row; ++row) {
+    const uint8_t* src_scan =
+        pGlyph->GetScanline(row - top) + (start_col - left);
+    uint8_t* dest_scan = bitmap->GetWritableScanline(row) + start_col * Bpp;
+    switch (format) {
+      case FXDIB_Format::k8bppMask:
+        CompositeGlyphRowToMask(src_scan, width, a, dest_scan);
+        break;
+      case FXDIB_Format::kArgb:
+        CompositeGlyphRowToArgb(src_scan, width, a, r, g, b, dest_scan);
+        break;
+      default:
+        CompositeGlyphRowToRgb(src_scan, width, a, r, g, b, Bpp, dest_scan);
+        break;
+    }
+  }
+  return true;
+}
+
 bool ShouldDrawDeviceText(const CFX_Font* pFont,
                           const CFX_TextRenderOptions& options) {
 #if defined(OS_APPLE)
@@ -1189,6 +1316,9 @@ bool CFX_RenderDevice::DrawNormalText(int nChars,
     int ncols = pGlyph->GetWidth();
     int nrows = pGlyph->GetHeight();
     if (anti_alias == FT_RENDER_MODE_NORMAL) {
+      if (CompositeGlyphMask(bitmap, pGlyph, point->x, point->y, fill_color))
+        continue;
+
       if (!bitmap->CompositeMask(point.value().x, point.value().y, ncols, nrows,
                                  pGlyph, fill_color, 0, 0, BlendMode::kNormal,
                                  nullptr, false)) {
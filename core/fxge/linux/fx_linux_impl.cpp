@@ -171,6 +171,9 @@ class CLinuxPlatform : public CFX_GEModule::PlatformIface {
       pInfo->AddPath("/usr/share/X11/fonts/TTF");
       pInfo->AddPath("/usr/local/share/fonts");
     }
+    const char* catalog_path = CFX_GEModule::Get()->GetFontCatalogPath();
+    if (catalog_path)
+      pInfo->SetCatalogPath(catalog_path);
     return pInfo;
   }
 };
@@ -7,6 +7,8 @@
 #ifndef CORE_FXGE_SYSTEMFONTINFO_IFACE_H_
 #define CORE_FXGE_SYSTEMFONTINFO_IFACE_H_
 
+#include "core/fxcrt/cfx_mappedfile.h"
+#include "core/fxcrt/retain_ptr.h"
 #include "core/fxge/cfx_fontmapper.h"
 #include "third_party/base/span.h"
 
@@ -27,6 +29,11 @@ class SystemFontInfoIface {
   virtual uint32_t GetFontData(void* hFont,
                                uint32_t table,
                                pdfium::span<uint8_t> buffer) = 0;
+  // Returns the same data as GetFontData() for table 0 or kTableTTCF, without
+  // copying it, or nullptr if the font is not in a file that can be mapped.
+  virtual RetainPtr<CFX_MappedFile> MapFontFile(void* hFont) {
+    return nullptr;
+  }
   virtual bool GetFaceName(void* hFont, ByteString* name) = 0;
   virtual bool GetFontCharset(void* hFont, int* charset) = 0;
   virtual void DeleteFont(void* hFont) = 0;
@@ -35,6 +35,8 @@ class CPDF_RenderOptions;
 class CPDF_Stream;
 class CPDF_StructElement;
 class CPDF_StructTree;
+class CPDF_DocTextIterator;
+class CPDF_TextIndex;
 class CPDF_TextPage;
 class CPDF_TextPageFind;
 class CPDFSDK_FormFillEnvironment;
@@ -192,6 +194,22 @@ inline CPDF_TextPage* CPDFTextPageFromFPDFTextPage(FPDF_TEXTPAGE page) {
   return reinterpret_cast<CPDF_TextPage*>(page);
 }
 
+inline FPDF_TEXTINDEX FPDFTextIndexFromCPDFTextIndex(CPDF_TextIndex* index) {
+  return reinterpret_cast<FPDF_TEXTINDEX>(index);
+}
+inline CPDF_TextIndex* CPDFTextIndexFromFPDFTextIndex(FPDF_TEXTINDEX index) {
+  return reinterpret_cast<CPDF_TextIndex*>(index);
+}
+
+inline FPDF_TEXTITERATOR FPDFTextIteratorFromCPDFDocTextIterator(
+    CPDF_DocTextIterator* iterator) {
+  return reinterpret_cast<FPDF_TEXTITERATOR>(iterator);
+}
+inline CPDF_DocTextIterator* CPDFDocTextIteratorFromFPDFTextIterator(
+    FPDF_TEXTITERATOR iterator) {
+  return reinterpret_cast<CPDF_DocTextIterator*>(iterator);
+}
+
 inline FPDF_SCHHANDLE FPDFSchHandleFromCPDFTextPageFind(
     CPDF_TextPageFind* handle) {
   return reinterpret_cast<FPDF_SCHHANDLE>(handle);
@@ -6,8 +6,10 @@
 
 #include "public/fpdf_dataavail.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/page/cpdf_docpagedata.h"
 #include "core/fpdfapi/parser/cpdf_data_avail.h"
@@ -19,6 +21,7 @@
 #include "core/fxcrt/unowned_ptr.h"
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "public/fpdf_formfill.h"
+#include "third_party/base/numerics/safe_conversions.h"
 
 #ifdef PDF_ENABLE_XFA
 #include "fpdfsdk/fpdfxfa/cpdfxfa_context.h"
@@ -111,6 +114,22 @@ class FPDF_DownloadHintsContext final : public CPDF_DataAvail::DownloadHints {
   UnownedPtr<FX_DOWNLOADHINTS> m_pDownloadHints;
 };
 
+class FPDF_ByteRangeCollector final : public CPDF_DataAvail::DownloadHints {
+ public:
+  FPDF_ByteRangeCollector() = default;
+  ~FPDF_ByteRangeCollector() override = default;
+
+  // CPDF_DataAvail::DownloadHints:
+  void AddSegment(FX_FILESIZE offset, size_t size) override {
+    ranges_.push_back({static_cast<size_t>(offset), size});
+  }
+
+  const std::vector<FPDF_BYTE_RANGE>& ranges() const { return ranges_; }
+
+ private:
+  std::vector<FPDF_BYTE_RANGE> ranges_;
+};
+
 class FPDF_AvailContext {
  public:
   FPDF_AvailContext(FX_FILEAVAIL* file_avail, FPDF_FILEACCESS* file)
@@ -196,6 +215,38 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsPageAvail(FPDF_AVAIL avail,
   return avail_context->data_avail()->IsPageAvail(page_index, &hints_context);
 }
 
+FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_GetPageRanges(FPDF_AVAIL avail,
+                                                      int page_index,
+                                                      FPDF_BYTE_RANGE* ranges,
+                                                      int count) {
+  auto* avail_context = FPDFAvailContextFromFPDFAvail(avail);
+  if (!avail_context || page_index < 0 || count < 0)
+    return -1;
+
+  // The data availability checker already merges what it finds missing into
+  // a few large reads before handing it to the hints.
+  FPDF_ByteRangeCollector collector;
+  switch (avail_context->data_avail()->IsPageAvail(page_index, &collector)) {
+    case CPDF_DataAvail::kDataAvailable:
+      return 0;
+    case CPDF_DataAvail::kDataNotAvailable:
+      break;
+    default:
+      return -1;
+  }
+
+  // Nothing to fetch would leave the caller waiting forever.
+  const std::vector<FPDF_BYTE_RANGE>& needed = collector.ranges();
+  if (needed.empty())
+    return -1;
+
+  if (ranges) {
+    std::copy_n(needed.begin(), std::min<size_t>(needed.size(), count),
+                ranges);
+  }
+  return pdfium::base::checked_cast<int>(needed.size());
+}
+
 FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsFormAvail(FPDF_AVAIL avail,
                                                     FX_DOWNLOADHINTS* hints) {
   auto* avail_context = FPDFAvailContextFromFPDFAvail(avail);
@@ -10,10 +10,13 @@
 
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/widestring.h"
+#include "public/cpp/fpdf_scopers.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
+#include "testing/fake_file_access.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/range_set.h"
+#include "testing/test_loader.h"
 #include "testing/utils/file_util.h"
 #include "testing/utils/path_service.h"
 
@@ -155,6 +158,37 @@ class TestAsyncLoader final : public FX_DOWNLOADHINTS, FX_FILEAVAIL {
   RangeSet available_ranges_;
 };
 
+// Serves a test file through FakeFileAccess, so that data only arrives when it
+// is requested, one round trip at a time.
+class NetworkFile {
+ public:
+  explicit NetworkFile(const std::string& file_name) {
+    std::string file_path;
+    if (!PathService::GetTestFilePath(file_name, &file_path))
+      return;
+    file_contents_ = GetFileContents(file_path.c_str(), &file_length_);
+    if (!file_contents_)
+      return;
+
+    loader_ = std::make_unique<TestLoader>(
+        pdfium::make_span(file_contents_.get(), file_length_));
+    file_access_.m_FileLen = static_cast<unsigned long>(file_length_);
+    file_access_.m_GetBlock = TestLoader::GetBlock;
+    file_access_.m_Param = loader_.get();
+    network_ = std::make_unique<FakeFileAccess>(&file_access_);
+  }
+
+  FakeFileAccess* network() const { return network_.get(); }
+  size_t file_length() const { return file_length_; }
+
+ private:
+  std::unique_ptr<char, pdfium::FreeDeleter> file_contents_;
+  size_t file_length_ = 0;
+  std::unique_ptr<TestLoader> loader_;
+  FPDF_FILEACCESS file_access_ = {};
+  std::unique_ptr<FakeFileAccess> network_;
+};
+
 }  // namespace
 
 class FPDFDataAvailEmbedderTest : public EmbedderTest {};
@@ -391,3 +425,87 @@ TEST_F(FPDFDataAvailEmbedderTest, NegativePageIndex) {
   EXPECT_EQ(PDF_DATA_NOTAVAIL,
             FPDFAvail_IsPageAvail(avail_, -1, loader.hints()));
 }
+
+TEST_F(FPDFDataAvailEmbedderTest, RoundTripsPerPageWithXRefStream) {
+  NetworkFile file("non_linearized_xref_stream.pdf");
+  FakeFileAccess* network = file.network();
+  ASSERT_TRUE(network);
+  ScopedFPDFAvail avail(
+      FPDFAvail_Create(network->GetFileAvail(), network->GetFileAccess()));
+
+  int status = PDF_DATA_NOTAVAIL;
+  while (status == PDF_DATA_NOTAVAIL) {
+    network->SetRequestedDataAvailable();
+    status = FPDFAvail_IsDocAvail(avail.get(), network->GetDownloadHints());
+  }
+  ASSERT_EQ(PDF_DATA_AVAIL, status);
+  EXPECT_EQ(PDF_NOT_LINEARIZED, FPDFAvail_IsLinearized(avail.get()));
+  // Header, linearization check, then the trailer with the cross-reference
+  // stream.
+  EXPECT_EQ(3, network->GetRoundTripCount());
+
+  ScopedFPDFDocument document(FPDFAvail_GetDocument(avail.get(), nullptr));
+  ASSERT_TRUE(document);
+  const int page_count = FPDF_GetPageCount(document.get());
+  ASSERT_EQ(4, page_count);
+  for (int i = 0; i < page_count; ++i) {
+    const int round_trips = network->GetRoundTripCount();
+    status = PDF_DATA_NOTAVAIL;
+    while (status == PDF_DATA_NOTAVAIL) {
+      network->SetRequestedDataAvailable();
+      status =
+          FPDFAvail_IsPageAvail(avail.get(), i, network->GetDownloadHints());
+    }
+    ASSERT_EQ(PDF_DATA_AVAIL, status);
+    // One round trip for the page, resources and content, and one for the
+    // fonts and images they refer to, instead of one per level of nesting.
+    EXPECT_LE(network->GetRoundTripCount() - round_trips, 2);
+    if (i == 0)
+      EXPECT_FALSE(network->IsDataAvail(0, file.file_length()));
+
+    ScopedFPDFPage page(FPDF_LoadPage(document.get(), i));
+    EXPECT_TRUE(page);
+  }
+}
+
+TEST_F(FPDFDataAvailEmbedderTest, GetPageRanges) {
+  NetworkFile file("non_linearized_xref_stream.pdf");
+  FakeFileAccess* network = file.network();
+  ASSERT_TRUE(network);
+  ScopedFPDFAvail avail(
+      FPDFAvail_Create(network->GetFileAvail(), network->GetFileAccess()));
+  EXPECT_EQ(-1, FPDFAvail_GetPageRanges(nullptr, 0, nullptr, 0));
+  // No document yet.
+  EXPECT_EQ(-1, FPDFAvail_GetPageRanges(avail.get(), 0, nullptr, 0));
+
+  int status = PDF_DATA_NOTAVAIL;
+  while (status == PDF_DATA_NOTAVAIL) {
+    network->SetRequestedDataAvailable();
+    status = FPDFAvail_IsDocAvail(avail.get(), network->GetDownloadHints());
+  }
+  ASSERT_EQ(PDF_DATA_AVAIL, status);
+  ScopedFPDFDocument document(FPDFAvail_GetDocument(avail.get(), nullptr));
+  ASSERT_TRUE(document);
+  EXPECT_EQ(-1, FPDFAvail_GetPageRanges(avail.get(), -1, nullptr, 0));
+  EXPECT_EQ(-1, FPDFAvail_GetPageRanges(avail.get(), 1, nullptr, -1));
+
+  const int round_trips = network->GetRoundTripCount();
+  int needed = FPDFAvail_GetPageRanges(avail.get(), 1, nullptr, 0);
+  for (int round = 0; needed > 0 && round < 10; ++round) {
+    std::vector<FPDF_BYTE_RANGE> ranges(needed);
+    ASSERT_EQ(needed, FPDFAvail_GetPageRanges(avail.get(), 1, ranges.data(),
+                                              needed));
+    for (size_t i = 1; i < ranges.size(); ++i)
+      EXPECT_GT(ranges[i].offset, ranges[i - 1].offset + ranges[i - 1].size);
+    for (const FPDF_BYTE_RANGE& range : ranges)
+      network->AddSegment(range.offset, range.size);
+    network->SetRequestedDataAvailable();
+    needed = FPDFAvail_GetPageRanges(avail.get(), 1, nullptr, 0);
+  }
+  ASSERT_EQ(0, needed);
+  EXPECT_LE(network->GetRoundTripCount() - round_trips, 2);
+  EXPECT_EQ(PDF_DATA_AVAIL, FPDFAvail_IsPageAvail(avail.get(), 1, nullptr));
+
+  ScopedFPDFPage page(FPDF_LoadPage(document.get(), 1));
+  EXPECT_TRUE(page);
+}
@@ -9,8 +9,11 @@
 
 #include "build/build_config.h"
 #include "core/fpdfapi/font/cpdf_font.h"
+#include "core/fpdfapi/page/cpdf_form.h"
+#include "core/fpdfapi/page/cpdf_formobject.h"
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pathobject.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
@@ -915,6 +918,69 @@ TEST_F(FPDFEditEmbedderTest, RemovePageObject) {
   FPDFPageObj_Destroy(page_object);
 }
 
+TEST_F(FPDFEditEmbedderTest, RenderDamagedRects) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  EXPECT_EQ(0, FPDFPage_CountDamagedRects(page));
+
+  // Keep one bitmap around and only repaint the damaged parts of it.
+  ScopedFPDFBitmap bitmap(FPDFBitmap_Create(200, 200, 0));
+  FPDFBitmap_FillRect(bitmap.get(), 0, 0, 200, 200, 0xFFFFFFFF);
+  FPDF_RenderPageBitmap(bitmap.get(), page, 0, 0, 200, 200, 0, 0);
+
+  // Add a red rectangle.
+  FPDF_PAGEOBJECT rect = FPDFPageObj_CreateNewRect(20, 30, 40, 50);
+  EXPECT_TRUE(FPDFPageObj_SetFillColor(rect, 255, 0, 0, 255));
+  EXPECT_TRUE(FPDFPath_SetDrawMode(rect, FPDF_FILLMODE_ALTERNATE, 0));
+  FPDFPage_InsertObject(page, rect);
+  ASSERT_EQ(1, FPDFPage_CountDamagedRects(page));
+  FS_RECTF damaged;
+  ASSERT_TRUE(FPDFPage_GetDamagedRect(page, 0, &damaged));
+  EXPECT_FLOAT_EQ(20.0f, damaged.left);
+  EXPECT_FLOAT_EQ(80.0f, damaged.top);
+  EXPECT_FLOAT_EQ(60.0f, damaged.right);
+  EXPECT_FLOAT_EQ(30.0f, damaged.bottom);
+  EXPECT_FALSE(FPDFPage_GetDamagedRect(page, 1, &damaged));
+  EXPECT_FALSE(FPDFPage_GetDamagedRect(page, -1, &damaged));
+
+  FPDF_RenderPageBitmapDamage(bitmap.get(), page, 0, 0, 200, 200, 0, 0,
+                              0xFFFFFFFF);
+  FPDFPage_ClearDamage(page);
+  EXPECT_EQ(0, FPDFPage_CountDamagedRects(page));
+  {
+    ScopedFPDFBitmap expected_bitmap = RenderPage(page);
+    EXPECT_EQ(HashBitmap(expected_bitmap.get()), HashBitmap(bitmap.get()));
+  }
+
+  // Moving the rectangle damages both where it was and where it is now.
+  FPDFPageObj_Transform(rect, 1, 0, 0, 1, 100, 100);
+  EXPECT_EQ(2, FPDFPage_CountDamagedRects(page));
+  FPDF_RenderPageBitmapDamage(bitmap.get(), page, 0, 0, 200, 200, 0, 0,
+                              0xFFFFFFFF);
+  FPDFPage_ClearDamage(page);
+  {
+    ScopedFPDFBitmap expected_bitmap = RenderPage(page);
+    EXPECT_EQ(HashBitmap(expected_bitmap.get()), HashBitmap(bitmap.get()));
+  }
+
+  // Remove the "Hello, world!" text.
+  FPDF_PAGEOBJECT text = FPDFPage_GetObject(page, 0);
+  ASSERT_TRUE(text);
+  EXPECT_TRUE(FPDFPage_RemoveObject(page, text));
+  EXPECT_GE(FPDFPage_CountDamagedRects(page), 1);
+  FPDF_RenderPageBitmapDamage(bitmap.get(), page, 0, 0, 200, 200, 0, 0,
+                              0xFFFFFFFF);
+  FPDFPage_ClearDamage(page);
+  {
+    ScopedFPDFBitmap expected_bitmap = RenderPage(page);
+    EXPECT_EQ(HashBitmap(expected_bitmap.get()), HashBitmap(bitmap.get()));
+  }
+
+  UnloadPage(page);
+  FPDFPageObj_Destroy(text);
+}
+
 void CheckMarkCounts(FPDF_PAGE page,
                      int start_from,
                      int expected_object_count,
@@ -1492,6 +1558,47 @@ TEST_F(FPDFEditEmbedderTest, GetContentStream) {
   UnloadPage(page);
 }
 
+TEST_F(FPDFEditEmbedderTest, ObjectsSplitAcrossStreams) {
+  // The TJ array and the BDC properties each start in one content stream and
+  // end in the next.
+  ASSERT_TRUE(OpenDocument("split_streams_objects.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  ScopedFPDFTextPage text_page(FPDFText_LoadPage(page));
+  ASSERT_TRUE(text_page);
+
+  ASSERT_EQ(2, FPDFPage_CountObjects(page));
+  static const wchar_t* const kExpectedText[] = {L"Hello", L"world"};
+  for (int i = 0; i < 2; ++i) {
+    FPDF_PAGEOBJECT text_obj = FPDFPage_GetObject(page, i);
+    ASSERT_EQ(FPDF_PAGEOBJ_TEXT, FPDFPageObj_GetType(text_obj));
+    unsigned long size = FPDFTextObj_GetText(text_obj, text_page.get(),
+                                             /*buffer=*/nullptr, /*length=*/0);
+    ASSERT_GT(size, 0u);
+    std::vector<FPDF_WCHAR> buffer = GetFPDFWideStringBuffer(size);
+    ASSERT_EQ(size, FPDFTextObj_GetText(text_obj, text_page.get(),
+                                        buffer.data(), size));
+    EXPECT_EQ(kExpectedText[i], GetPlatformWString(buffer.data()));
+  }
+
+  FPDF_PAGEOBJECT marked_obj = FPDFPage_GetObject(page, 1);
+  ASSERT_EQ(1, FPDFPageObj_CountMarks(marked_obj));
+  FPDF_PAGEOBJECTMARK mark = FPDFPageObj_GetMark(marked_obj, 0);
+  ASSERT_TRUE(mark);
+  int mcid = -1;
+  EXPECT_TRUE(FPDFPageObjMark_GetParamIntValue(mark, "MCID", &mcid));
+  EXPECT_EQ(0, mcid);
+
+  // Objects belong to the stream in which they end.
+  for (int i = 0; i < 2; ++i) {
+    CPDF_PageObject* cpdf_page_object =
+        CPDFPageObjectFromFPDFPageObject(FPDFPage_GetObject(page, i));
+    EXPECT_EQ(i + 1, cpdf_page_object->GetContentStream()) << i;
+  }
+
+  UnloadPage(page);
+}
+
 TEST_F(FPDFEditEmbedderTest, RemoveAllFromStream) {
   // Load document with some text split across streams.
   ASSERT_TRUE(OpenDocument("split_streams.pdf"));
@@ -2537,6 +2644,94 @@ TEST_F(FPDFEditEmbedderTest, FormGetObjects) {
   UnloadPage(page);
 }
 
+TEST_F(FPDFEditEmbedderTest, FormObjectsShareParsedContent) {
+  ASSERT_TRUE(OpenDocument("form_object_repeated.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  ASSERT_EQ(3, FPDFPage_CountObjects(page));
+
+  FPDF_PAGEOBJECT forms[3];
+  CPDF_FormObject* form_objects[3];
+  const CPDF_Form* parsed_forms[3];
+  for (int i = 0; i < 3; ++i) {
+    forms[i] = FPDFPage_GetObject(page, i);
+    ASSERT_EQ(FPDF_PAGEOBJ_FORM, FPDFPageObj_GetType(forms[i]));
+    ASSERT_EQ(1, FPDFFormObj_CountObjects(forms[i]));
+    form_objects[i] = CPDFPageObjectFromFPDFPageObject(forms[i])->AsForm();
+    ASSERT_TRUE(form_objects[i]);
+    parsed_forms[i] = form_objects[i]->form();
+  }
+
+  // The first two forms are drawn with the same inherited states, so they
+  // share one parsed copy of the form content. Each keeps its own matrix.
+  // The third one inherits a different fill color.
+  EXPECT_EQ(parsed_forms[0], parsed_forms[1]);
+  EXPECT_NE(parsed_forms[0], parsed_forms[2]);
+  FS_MATRIX matrix;
+  ASSERT_TRUE(FPDFPageObj_GetMatrix(forms[1], &matrix));
+  EXPECT_FLOAT_EQ(70.0f, matrix.e);
+
+  // Page objects handed out through the API belong to one form object only,
+  // so the first form gets its own copy, and the second one keeps the
+  // original.
+  FPDF_PAGEOBJECT paths[3];
+  for (int i = 0; i < 3; ++i) {
+    paths[i] = FPDFFormObj_GetObject(forms[i], 0);
+    ASSERT_EQ(FPDF_PAGEOBJ_PATH, FPDFPageObj_GetType(paths[i]));
+  }
+  EXPECT_NE(paths[0], paths[1]);
+  EXPECT_NE(parsed_forms[0], form_objects[0]->form());
+  EXPECT_EQ(parsed_forms[1], form_objects[1]->form());
+  EXPECT_EQ(parsed_forms[2], form_objects[2]->form());
+
+  unsigned int r;
+  unsigned int g;
+  unsigned int b;
+  unsigned int a;
+  ASSERT_TRUE(FPDFPageObj_GetFillColor(paths[0], &r, &g, &b, &a));
+  EXPECT_EQ(0u, r);
+  ASSERT_TRUE(FPDFPageObj_GetFillColor(paths[2], &r, &g, &b, &a));
+  EXPECT_EQ(255u, r);
+
+  // Editing the copy leaves the other form objects alone.
+  ASSERT_TRUE(FPDFPageObj_SetFillColor(paths[0], 0, 0, 255, 255));
+  ASSERT_TRUE(FPDFPageObj_GetFillColor(paths[0], &r, &g, &b, &a));
+  EXPECT_EQ(255u, b);
+  ASSERT_TRUE(FPDFPageObj_GetFillColor(paths[1], &r, &g, &b, &a));
+  EXPECT_EQ(0u, b);
+  EXPECT_EQ(1, FPDFFormObj_CountObjects(forms[1]));
+
+  UnloadPage(page);
+}
+
+TEST_F(FPDFEditEmbedderTest, PathObjectsShareIdenticalPoints) {
+  ASSERT_TRUE(OpenDocument("path_repeated.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  ASSERT_EQ(3, FPDFPage_CountObjects(page));
+
+  const CPDF_PathObject* paths[3];
+  for (int i = 0; i < 3; ++i) {
+    CPDF_PageObject* obj =
+        CPDFPageObjectFromFPDFPageObject(FPDFPage_GetObject(page, i));
+    ASSERT_TRUE(obj);
+    paths[i] = obj->AsPath();
+    ASSERT_TRUE(paths[i]);
+  }
+
+  // The first two paths only differ by their matrices.
+  EXPECT_EQ(paths[0]->path().GetObject(), paths[1]->path().GetObject());
+  EXPECT_NE(paths[0]->path().GetObject(), paths[2]->path().GetObject());
+
+  // Editing one of them must not change the other.
+  FPDF_PAGEOBJECT first = FPDFPage_GetObject(page, 0);
+  EXPECT_TRUE(FPDFPath_LineTo(first, 10, 10));
+  EXPECT_EQ(4, FPDFPath_CountSegments(first));
+  EXPECT_EQ(3, FPDFPath_CountSegments(FPDFPage_GetObject(page, 1)));
+
+  UnloadPage(page);
+}
+
 TEST_F(FPDFEditEmbedderTest, ModifyFormObject) {
 #if defined(_SKIA_SUPPORT_) || defined(_SKIA_SUPPORT_PATHS_)
 #if defined(OS_WIN)
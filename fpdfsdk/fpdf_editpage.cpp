@@ -34,6 +34,7 @@
 #include "core/fpdfdoc/cpdf_annot.h"
 #include "core/fpdfdoc/cpdf_annotlist.h"
 #include "core/fxcrt/fx_extension.h"
+#include "core/fxcrt/stl_util.h"
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "public/fpdf_formfill.h"
 #include "third_party/base/notreached.h"
@@ -600,6 +601,35 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_GenerateContent(FPDF_PAGE page) {
   return true;
 }
 
+FPDF_EXPORT int FPDF_CALLCONV FPDFPage_CountDamagedRects(FPDF_PAGE page) {
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage)
+    return -1;
+
+  return fxcrt::CollectionSize<int>(pPage->GetDamagedRects());
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_GetDamagedRect(FPDF_PAGE page,
+                                                            int index,
+                                                            FS_RECTF* rect) {
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage || !rect)
+    return false;
+
+  const std::vector<CFX_FloatRect>& damaged_rects = pPage->GetDamagedRects();
+  if (!fxcrt::IndexInBounds(damaged_rects, index))
+    return false;
+
+  *rect = FSRectFFromCFXFloatRect(damaged_rects[index]);
+  return true;
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDFPage_ClearDamage(FPDF_PAGE page) {
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (pPage)
+    pPage->ClearDamagedRects();
+}
+
 FPDF_EXPORT void FPDF_CALLCONV
 FPDFPageObj_Transform(FPDF_PAGEOBJECT page_object,
                       double a,
@@ -971,10 +1001,11 @@ FPDFFormObj_CountObjects(FPDF_PAGEOBJECT form_object) {
 
 FPDF_EXPORT FPDF_PAGEOBJECT FPDF_CALLCONV
 FPDFFormObj_GetObject(FPDF_PAGEOBJECT form_object, unsigned long index) {
-  const auto* pObjectList = CPDFPageObjHolderFromFPDFFormObject(form_object);
-  if (!pObjectList)
+  CPDF_FormObject* pFormObject = CPDFFormObjectFromFPDFPageObject(form_object);
+  if (!pFormObject)
     return nullptr;
 
+  // The returned object may be edited, so it must not be shared.
   return FPDFPageObjectFromCPDFPageObject(
-      pObjectList->GetPageObjectByIndex(index));
+      pFormObject->GetMutableForm()->GetPageObjectByIndex(index));
 }
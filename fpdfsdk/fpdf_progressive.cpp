@@ -10,6 +10,9 @@
 #include <utility>
 
 #include "core/fpdfapi/page/cpdf_page.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_page_tree_index.h"
+#include "core/fpdfapi/render/cpdf_pagerendercache.h"
 #include "core/fpdfapi/render/cpdf_pagerendercontext.h"
 #include "core/fpdfapi/render/cpdf_progressiverenderer.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
@@ -41,6 +44,47 @@ int ToFPDFStatus(CPDF_ProgressiveRenderer::Status status) {
 
 }  // namespace
 
+FPDF_EXPORT FPDF_PAGE FPDF_CALLCONV
+FPDF_LoadPageForProgressiveRender(FPDF_DOCUMENT document, int page_index) {
+  auto* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return nullptr;
+
+#ifdef PDF_ENABLE_XFA
+  if (pDoc->GetExtension())
+    return FPDF_LoadPage(document, page_index);
+#endif  // PDF_ENABLE_XFA
+
+  if (page_index < 0 || page_index >= FPDF_GetPageCount(document))
+    return nullptr;
+
+  CPDF_Dictionary* pDict = pDoc->GetPageDictionary(page_index);
+  if (!pDict)
+    return nullptr;
+
+  auto pPage = pdfium::MakeRetain<CPDF_Page>(pDoc, pDict);
+  pPage->SetRenderCache(std::make_unique<CPDF_PageRenderCache>(pPage.Get()));
+  pPage->StartParseContent();
+  return FPDFPageFromIPDFPage(pPage.Leak());
+}
+
+FPDF_EXPORT int FPDF_CALLCONV FPDF_LoadPageIndex(FPDF_DOCUMENT document,
+                                                 IFSDK_PAUSE* pause) {
+  if (pause && pause->version != 1)
+    return FPDF_RENDER_FAILED;
+
+  auto* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return FPDF_RENDER_FAILED;
+
+  std::unique_ptr<CPDFSDK_PauseAdapter> pause_adapter;
+  if (pause)
+    pause_adapter = std::make_unique<CPDFSDK_PauseAdapter>(pause);
+  if (!pDoc->GetPageTreeIndex()->Continue(pause_adapter.get()))
+    return FPDF_RENDER_TOBECONTINUED;
+  return FPDF_RENDER_DONE;
+}
+
 FPDF_EXPORT int FPDF_CALLCONV
 FPDF_RenderPageBitmapWithColorScheme_Start(FPDF_BITMAP bitmap,
                                            FPDF_PAGE page,
@@ -136,5 +180,6 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPage_Close(FPDF_PAGE page) {
     }
 #endif
     pPage->SetRenderContext(nullptr);
+    pPage->ParseContent();
   }
 }
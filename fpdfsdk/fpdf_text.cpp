@@ -15,7 +15,9 @@
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/page/cpdf_textobject.h"
 #include "core/fpdfdoc/cpdf_viewerpreferences.h"
+#include "core/fpdftext/cpdf_doctextiterator.h"
 #include "core/fpdftext/cpdf_linkextract.h"
+#include "core/fpdftext/cpdf_textindex.h"
 #include "core/fpdftext/cpdf_textpage.h"
 #include "core/fpdftext/cpdf_textpagefind.h"
 #include "core/fxcrt/stl_util.h"
@@ -266,6 +268,59 @@ FPDFText_GetCharOrigin(FPDF_TEXTPAGE text_page,
   return true;
 }
 
+FPDF_EXPORT int FPDF_CALLCONV
+FPDFText_GetCharInfoRange(FPDF_TEXTPAGE text_page,
+                          int start_index,
+                          int count,
+                          unsigned int* unicodes,
+                          FS_RECTF* char_boxes,
+                          FS_POINTF* origins,
+                          float* font_sizes,
+                          int* font_ids,
+                          unsigned int* flags) {
+  CPDF_TextPage* textpage = GetTextPageForValidIndex(text_page, start_index);
+  if (!textpage || count < 0)
+    return -1;
+
+  pdfium::span<const CPDF_TextPage::CharInfo> charinfos =
+      textpage->GetCharInfos().subspan(start_index);
+  const size_t char_count =
+      std::min(charinfos.size(), static_cast<size_t>(count));
+  for (size_t i = 0; i < char_count; ++i) {
+    const CPDF_TextPage::CharInfo& charinfo = charinfos[i];
+    if (unicodes)
+      unicodes[i] = charinfo.m_Unicode;
+    if (char_boxes)
+      char_boxes[i] = FSRectFFromCFXFloatRect(charinfo.m_CharBox);
+    if (origins) {
+      origins[i].x = charinfo.m_Origin.x;
+      origins[i].y = charinfo.m_Origin.y;
+    }
+    if (font_sizes)
+      font_sizes[i] = textpage->GetCharFontSize(start_index + i);
+    if (font_ids)
+      font_ids[i] = textpage->GetCharFontId(start_index + i);
+    if (flags) {
+      unsigned int char_flags = 0;
+      switch (charinfo.m_CharType) {
+        case CPDF_TextPage::CharType::kGenerated:
+          char_flags = FPDF_TEXTCHAR_GENERATED;
+          break;
+        case CPDF_TextPage::CharType::kHyphen:
+          char_flags = FPDF_TEXTCHAR_HYPHEN;
+          break;
+        case CPDF_TextPage::CharType::kNotUnicode:
+          char_flags = FPDF_TEXTCHAR_UNICODEMAPERROR;
+          break;
+        default:
+          break;
+      }
+      flags[i] = char_flags;
+    }
+  }
+  return pdfium::base::checked_cast<int>(char_count);
+}
+
 FPDF_EXPORT int FPDF_CALLCONV
 FPDFText_GetCharIndexAtPos(FPDF_TEXTPAGE text_page,
                            double x,
@@ -433,6 +488,103 @@ FPDF_EXPORT void FPDF_CALLCONV FPDFText_FindClose(FPDF_SCHHANDLE handle) {
       CPDFTextPageFindFromFPDFSchHandle(handle));
 }
 
+FPDF_EXPORT FPDF_TEXTITERATOR FPDF_CALLCONV
+FPDFText_OpenDocumentIterator(FPDF_DOCUMENT document) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return nullptr;
+
+  CPDF_ViewerPreferences viewRef(pDoc);
+  auto iterator =
+      std::make_unique<CPDF_DocTextIterator>(pDoc, viewRef.IsDirectionR2L());
+
+  // Caller takes ownership.
+  return FPDFTextIteratorFromCPDFDocTextIterator(iterator.release());
+}
+
+FPDF_EXPORT FPDF_TEXTPAGE FPDF_CALLCONV
+FPDFText_NextPage(FPDF_TEXTITERATOR iterator, int* page_index) {
+  CPDF_DocTextIterator* pIterator =
+      CPDFDocTextIteratorFromFPDFTextIterator(iterator);
+  if (!pIterator)
+    return nullptr;
+
+  CPDF_TextPage* textpage = pIterator->Next();
+  if (textpage && page_index)
+    *page_index = pIterator->GetPageIndex();
+
+  // Iterator retains ownership.
+  return FPDFTextPageFromCPDFTextPage(textpage);
+}
+
+FPDF_EXPORT void FPDF_CALLCONV
+FPDFText_CloseDocumentIterator(FPDF_TEXTITERATOR iterator) {
+  // PDFium takes ownership.
+  std::unique_ptr<CPDF_DocTextIterator> iterator_deleter(
+      CPDFDocTextIteratorFromFPDFTextIterator(iterator));
+}
+
+FPDF_EXPORT FPDF_TEXTINDEX FPDF_CALLCONV
+FPDFText_LoadDocumentIndex(FPDF_DOCUMENT document) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return nullptr;
+
+  CPDF_ViewerPreferences viewRef(pDoc);
+  CPDF_DocTextIterator iterator(pDoc, viewRef.IsDirectionR2L());
+  auto index = std::make_unique<CPDF_TextIndex>();
+  while (const CPDF_TextPage* textpage = iterator.Next())
+    index->AddPage(iterator.GetPageIndex(), textpage);
+
+  // Caller takes ownership.
+  return FPDFTextIndexFromCPDFTextIndex(index.release());
+}
+
+FPDF_EXPORT int FPDF_CALLCONV
+FPDFText_FindInDocumentIndex(FPDF_TEXTINDEX text_index,
+                             const FPDF_WIDESTRING* queries,
+                             int query_count,
+                             unsigned long flags,
+                             FPDF_TEXTINDEX_MATCH* matches,
+                             int max_matches) {
+  CPDF_TextIndex* index = CPDFTextIndexFromFPDFTextIndex(text_index);
+  if (!index || !queries || query_count < 0 || max_matches < 0 ||
+      (max_matches > 0 && !matches)) {
+    return -1;
+  }
+
+  std::vector<WideString> query_strings;
+  query_strings.reserve(query_count);
+  for (int i = 0; i < query_count; ++i) {
+    query_strings.push_back(
+        queries[i] ? WideStringFromFPDFWideString(queries[i]) : WideString());
+  }
+
+  CPDF_TextIndex::Options options;
+  options.bMatchCase = !!(flags & FPDF_MATCHCASE);
+  options.bMatchWholeWord = !!(flags & FPDF_MATCHWHOLEWORD);
+  options.bConsecutive = !!(flags & FPDF_CONSECUTIVE);
+  std::vector<CPDF_TextIndex::Match> results =
+      index->FindAll(query_strings, options);
+
+  const size_t copy_count =
+      std::min(results.size(), static_cast<size_t>(max_matches));
+  for (size_t i = 0; i < copy_count; ++i) {
+    matches[i].query_index = static_cast<int>(results[i].query_index);
+    matches[i].page_index = results[i].page_index;
+    matches[i].char_index = results[i].char_index;
+    matches[i].char_count = results[i].char_count;
+  }
+  return pdfium::base::checked_cast<int>(results.size());
+}
+
+FPDF_EXPORT void FPDF_CALLCONV
+FPDFText_CloseDocumentIndex(FPDF_TEXTINDEX text_index) {
+  // PDFium takes ownership.
+  std::unique_ptr<CPDF_TextIndex> index_deleter(
+      CPDFTextIndexFromFPDFTextIndex(text_index));
+}
+
 // web link
 FPDF_EXPORT FPDF_PAGELINK FPDF_CALLCONV
 FPDFLink_LoadWebLinks(FPDF_TEXTPAGE text_page) {
@@ -8,7 +8,11 @@
 #include <vector>
 
 #include "build/build_config.h"
+#include "core/fpdfapi/page/cpdf_page.h"
+#include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxge/fx_font.h"
+#include "fpdfsdk/cpdfsdk_helpers.h"
 #include "public/cpp/fpdf_scopers.h"
 #include "public/fpdf_text.h"
 #include "public/fpdf_transformpage.h"
@@ -38,7 +42,43 @@ bool check_unsigned_shorts(const char* expected,
 
 }  // namespace
 
-class FPDFTextEmbedderTest : public EmbedderTest {};
+class FPDFTextEmbedderTest : public EmbedderTest {
+ protected:
+  // Checks that iterating over the open document visits every page, and that
+  // each text page matches the one built by FPDFText_LoadPage().
+  void VerifyDocumentIterator() {
+    ScopedFPDFTextIterator iterator(FPDFText_OpenDocumentIterator(document()));
+    ASSERT_TRUE(iterator);
+
+    const int page_count = FPDF_GetPageCount(document());
+    for (int i = 0; i < page_count; ++i) {
+      int page_index = -1;
+      FPDF_TEXTPAGE text_only_page =
+          FPDFText_NextPage(iterator.get(), &page_index);
+      ASSERT_TRUE(text_only_page);
+      EXPECT_EQ(i, page_index);
+
+      FPDF_PAGE page = LoadPage(i);
+      ASSERT_TRUE(page);
+      ScopedFPDFTextPage text_page(FPDFText_LoadPage(page));
+      ASSERT_TRUE(text_page);
+
+      const int char_count = FPDFText_CountChars(text_page.get());
+      ASSERT_EQ(char_count, FPDFText_CountChars(text_only_page));
+      std::vector<unsigned short> expected(char_count + 1);
+      std::vector<unsigned short> actual(char_count + 1);
+      ASSERT_EQ(char_count + 1, FPDFText_GetText(text_page.get(), 0,
+                                                 char_count, expected.data()));
+      ASSERT_EQ(char_count + 1, FPDFText_GetText(text_only_page, 0,
+                                                 char_count, actual.data()));
+      EXPECT_EQ(expected, actual);
+      text_page.reset();
+      UnloadPage(page);
+    }
+    EXPECT_FALSE(FPDFText_NextPage(iterator.get(), nullptr));
+    EXPECT_FALSE(FPDFText_NextPage(iterator.get(), nullptr));
+  }
+};
 
 TEST_F(FPDFTextEmbedderTest, Text) {
   ASSERT_TRUE(OpenDocument("hello_world.pdf"));
@@ -493,6 +533,92 @@ TEST_F(FPDFTextEmbedderTest, TextSearchConsecutive) {
   UnloadPage(page);
 }
 
+TEST_F(FPDFTextEmbedderTest, DocumentIterator) {
+  EXPECT_FALSE(FPDFText_OpenDocumentIterator(nullptr));
+  EXPECT_FALSE(FPDFText_NextPage(nullptr, nullptr));
+
+  ASSERT_TRUE(OpenDocument("cropped_text.pdf"));
+  VerifyDocumentIterator();
+}
+
+TEST_F(FPDFTextEmbedderTest, DocumentIteratorSkipsImages) {
+  ASSERT_TRUE(OpenDocument("embedded_images.pdf"));
+  VerifyDocumentIterator();
+}
+
+TEST_F(FPDFTextEmbedderTest, TextOnlyParse) {
+  ASSERT_TRUE(OpenDocument("embedded_images.pdf"));
+  CPDF_Document* doc = CPDFDocumentFromFPDFDocument(document());
+  ASSERT_TRUE(doc);
+
+  auto page = pdfium::MakeRetain<CPDF_Page>(doc, doc->GetPageDictionary(0));
+  page->ParseContent();
+  size_t text_object_count = 0;
+  for (const auto& object : *page) {
+    if (object->IsText())
+      ++text_object_count;
+  }
+  EXPECT_EQ(39u, page->GetPageObjectCount());
+  EXPECT_LT(text_object_count, page->GetPageObjectCount());
+
+  auto text_only_page =
+      pdfium::MakeRetain<CPDF_Page>(doc, doc->GetPageDictionary(0));
+  text_only_page->SetTextOnly(true);
+  text_only_page->ParseContent();
+  EXPECT_EQ(text_object_count, text_only_page->GetPageObjectCount());
+  for (const auto& object : *text_only_page)
+    EXPECT_TRUE(object->IsText());
+}
+
+TEST_F(FPDFTextEmbedderTest, DocumentIndexSearch) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+
+  EXPECT_FALSE(FPDFText_LoadDocumentIndex(nullptr));
+  ScopedFPDFTextIndex text_index(FPDFText_LoadDocumentIndex(document()));
+  ASSERT_TRUE(text_index);
+
+  ScopedFPDFWideString world = GetFPDFWideString(L"world");
+  ScopedFPDFWideString goodbye_caps = GetFPDFWideString(L"GOODBYE");
+  ScopedFPDFWideString nope = GetFPDFWideString(L"nope");
+  const FPDF_WIDESTRING queries[] = {world.get(), goodbye_caps.get(),
+                                     nope.get()};
+
+  // Invalid arguments.
+  EXPECT_EQ(-1, FPDFText_FindInDocumentIndex(nullptr, queries, 3, 0, nullptr,
+                                             0));
+  EXPECT_EQ(-1, FPDFText_FindInDocumentIndex(text_index.get(), nullptr, 3, 0,
+                                             nullptr, 0));
+  EXPECT_EQ(-1, FPDFText_FindInDocumentIndex(text_index.get(), queries, 3, 0,
+                                             nullptr, 1));
+
+  // Counting only.
+  EXPECT_EQ(3, FPDFText_FindInDocumentIndex(text_index.get(), queries, 3, 0,
+                                            nullptr, 0));
+
+  FPDF_TEXTINDEX_MATCH matches[3] = {};
+  ASSERT_EQ(3, FPDFText_FindInDocumentIndex(text_index.get(), queries, 3, 0,
+                                            matches, 3));
+  EXPECT_EQ(0, matches[0].query_index);
+  EXPECT_EQ(0, matches[0].page_index);
+  EXPECT_EQ(7, matches[0].char_index);
+  EXPECT_EQ(5, matches[0].char_count);
+  EXPECT_EQ(1, matches[1].query_index);
+  EXPECT_EQ(0, matches[1].page_index);
+  EXPECT_EQ(15, matches[1].char_index);
+  EXPECT_EQ(7, matches[1].char_count);
+  EXPECT_EQ(0, matches[2].query_index);
+  EXPECT_EQ(0, matches[2].page_index);
+  EXPECT_EQ(24, matches[2].char_index);
+  EXPECT_EQ(5, matches[2].char_count);
+
+  // Case sensitive, with a short output buffer.
+  FPDF_TEXTINDEX_MATCH match = {};
+  ASSERT_EQ(2, FPDFText_FindInDocumentIndex(text_index.get(), queries, 3,
+                                            FPDF_MATCHCASE, &match, 1));
+  EXPECT_EQ(0, match.query_index);
+  EXPECT_EQ(7, match.char_index);
+}
+
 // Fails on Windows. https://crbug.com/pdfium/1370
 #if defined(OS_WIN)
 #define MAYBE_TextSearchLatinExtended DISABLED_TextSearchLatinExtended
@@ -857,6 +983,90 @@ TEST_F(FPDFTextEmbedderTest, GetFontSize) {
   UnloadPage(page);
 }
 
+TEST_F(FPDFTextEmbedderTest, GetCharInfoRange) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  FPDF_TEXTPAGE textpage = FPDFText_LoadPage(page);
+  ASSERT_TRUE(textpage);
+
+  const int char_count = FPDFText_CountChars(textpage);
+  ASSERT_EQ(30, char_count);
+
+  // Check that edge cases are handled gracefully.
+  EXPECT_EQ(-1, FPDFText_GetCharInfoRange(nullptr, 0, 1, nullptr, nullptr,
+                                          nullptr, nullptr, nullptr, nullptr));
+  EXPECT_EQ(-1, FPDFText_GetCharInfoRange(textpage, -1, 1, nullptr, nullptr,
+                                          nullptr, nullptr, nullptr, nullptr));
+  EXPECT_EQ(-1,
+            FPDFText_GetCharInfoRange(textpage, char_count, 1, nullptr, nullptr,
+                                      nullptr, nullptr, nullptr, nullptr));
+  EXPECT_EQ(-1, FPDFText_GetCharInfoRange(textpage, 0, -1, nullptr, nullptr,
+                                          nullptr, nullptr, nullptr, nullptr));
+  EXPECT_EQ(0, FPDFText_GetCharInfoRange(textpage, 0, 0, nullptr, nullptr,
+                                         nullptr, nullptr, nullptr, nullptr));
+
+  std::vector<unsigned int> unicodes(char_count);
+  std::vector<FS_RECTF> char_boxes(char_count);
+  std::vector<FS_POINTF> origins(char_count);
+  std::vector<float> font_sizes(char_count);
+  std::vector<int> font_ids(char_count);
+  std::vector<unsigned int> flags(char_count);
+  ASSERT_EQ(char_count,
+            FPDFText_GetCharInfoRange(textpage, 0, char_count + 10,
+                                      unicodes.data(), char_boxes.data(),
+                                      origins.data(), font_sizes.data(),
+                                      font_ids.data(), flags.data()));
+
+  // The bulk results match the per-character APIs.
+  for (int i = 0; i < char_count; ++i) {
+    EXPECT_EQ(FPDFText_GetUnicode(textpage, i), unicodes[i]);
+
+    double left;
+    double right;
+    double bottom;
+    double top;
+    ASSERT_TRUE(FPDFText_GetCharBox(textpage, i, &left, &right, &bottom, &top));
+    EXPECT_FLOAT_EQ(left, char_boxes[i].left);
+    EXPECT_FLOAT_EQ(right, char_boxes[i].right);
+    EXPECT_FLOAT_EQ(bottom, char_boxes[i].bottom);
+    EXPECT_FLOAT_EQ(top, char_boxes[i].top);
+
+    double x;
+    double y;
+    ASSERT_TRUE(FPDFText_GetCharOrigin(textpage, i, &x, &y));
+    EXPECT_FLOAT_EQ(x, origins[i].x);
+    EXPECT_FLOAT_EQ(y, origins[i].y);
+
+    EXPECT_FLOAT_EQ(FPDFText_GetFontSize(textpage, i), font_sizes[i]);
+  }
+
+  // "Hello, world!" and "Goodbye, world!" use different fonts, separated by a
+  // generated line break.
+  EXPECT_EQ(0, font_ids[0]);
+  EXPECT_EQ(0, font_ids[12]);
+  EXPECT_EQ(1, font_ids[15]);
+  EXPECT_EQ(1, font_ids[29]);
+  EXPECT_EQ(0u, flags[0]);
+  EXPECT_EQ(static_cast<unsigned int>(FPDF_TEXTCHAR_GENERATED), flags[13]);
+  EXPECT_EQ(static_cast<unsigned int>(FPDF_TEXTCHAR_GENERATED), flags[14]);
+  EXPECT_EQ(0u, flags[15]);
+
+  // Partial ranges, and skipped arrays.
+  unsigned int unicode_range[4];
+  int font_id_range[4];
+  EXPECT_EQ(2, FPDFText_GetCharInfoRange(textpage, 28, 4, unicode_range,
+                                         nullptr, nullptr, nullptr,
+                                         font_id_range, nullptr));
+  EXPECT_EQ(static_cast<unsigned int>('d'), unicode_range[0]);
+  EXPECT_EQ(static_cast<unsigned int>('!'), unicode_range[1]);
+  EXPECT_EQ(1, font_id_range[0]);
+
+  FPDFText_ClosePage(textpage);
+  UnloadPage(page);
+}
+
 TEST_F(FPDFTextEmbedderTest, GetFontInfo) {
   ASSERT_TRUE(OpenDocument("hello_world.pdf"));
   FPDF_PAGE page = LoadPage(0);
@@ -6,12 +6,15 @@
 
 #include "public/fpdfview.h"
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "build/build_config.h"
+#include "constants/page_object.h"
+#include "constants/transparency.h"
 #include "core/fpdfapi/page/cpdf_docpagedata.h"
 #include "core/fpdfapi/page/cpdf_occontext.h"
 #include "core/fpdfapi/page/cpdf_page.h"
@@ -20,6 +23,7 @@
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_page_tree_index.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
@@ -31,6 +35,7 @@
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfdoc/cpdf_nametree.h"
+#include "core/fpdfdoc/cpdf_pagelabel.h"
 #include "core/fpdfdoc/cpdf_viewerpreferences.h"
 #include "core/fxcrt/cfx_readonlymemorystream.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -160,6 +165,42 @@ FPDF_DOCUMENT LoadDocumentImpl(
   return FPDFDocumentFromCPDFDocument(pDocument.release());
 }
 
+// The geometry CPDF_Page::UpdateDimensions() computes, taken from the page
+// dictionary without creating the page.
+struct PageGeometry {
+  CFX_FloatRect mediabox;
+  CFX_FloatRect bbox;
+  int rotation;
+  CFX_SizeF size;
+};
+
+PageGeometry GetPageGeometry(CPDF_PageTreeIndex* pIndex,
+                             const CPDF_Dictionary* pPageDict) {
+  using Attr = CPDF_PageTreeIndex::Attr;
+  PageGeometry geometry;
+  CFX_FloatRect mediabox = CPDF_Page::GetBoxFromAttr(
+      pIndex->GetPageAttr(pPageDict, Attr::kMediaBox));
+  // Without a crop box, this is the media box with the default applied.
+  geometry.mediabox = CPDF_Page::CalculateBBox(mediabox, CFX_FloatRect());
+  geometry.bbox = CPDF_Page::CalculateBBox(
+      mediabox, CPDF_Page::GetBoxFromAttr(
+                    pIndex->GetPageAttr(pPageDict, Attr::kCropBox)));
+  geometry.rotation = CPDF_Page::GetRotationFromAttr(
+      pIndex->GetPageAttr(pPageDict, Attr::kRotate));
+  geometry.size = CFX_SizeF(geometry.bbox.Width(), geometry.bbox.Height());
+  if (geometry.rotation % 2)
+    std::swap(geometry.size.width, geometry.size.height);
+  return geometry;
+}
+
+// Returns the box |key| of the page itself, or |fallback| if it has none.
+FS_RECTF GetPageBoxOr(const CPDF_Dictionary* pPageDict,
+                      const char* key,
+                      const CFX_FloatRect& fallback) {
+  CFX_FloatRect box = CPDF_Page::GetBoxFromAttr(pPageDict->GetArrayFor(key));
+  return FSRectFFromCFXFloatRect(box.IsEmpty() ? fallback : box);
+}
+
 }  // namespace
 
 FPDF_EXPORT void FPDF_CALLCONV FPDF_InitLibrary() {
@@ -172,7 +213,10 @@ FPDF_InitLibraryWithConfig(const FPDF_LIBRARY_CONFIG* config) {
     return;
 
   FXMEM_InitializePartitionAlloc();
-  CFX_GEModule::Create(config ? config->m_pUserFontPaths : nullptr);
+  const char** user_font_paths = config ? config->m_pUserFontPaths : nullptr;
+  const char* font_catalog_path =
+      config && config->version >= 4 ? config->m_pFontCatalogPath : nullptr;
+  CFX_GEModule::Create(user_font_paths, font_catalog_path);
   CPDF_PageModule::Create();
 
 #ifdef PDF_ENABLE_XFA
@@ -674,6 +718,61 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                      /*color_scheme=*/nullptr);
 }
 
+FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageBitmapDamage(FPDF_BITMAP bitmap,
+                                                           FPDF_PAGE page,
+                                                           int start_x,
+                                                           int start_y,
+                                                           int size_x,
+                                                           int size_y,
+                                                           int rotate,
+                                                           int flags,
+                                                           FPDF_DWORD color) {
+  if (!bitmap)
+    return;
+
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage)
+    return;
+
+  // Anti-aliasing and glyphs extending past their font bbox can touch pixels
+  // just outside an object's rect.
+  constexpr float kDamageMargin = 2;
+
+  RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
+  FX_RECT display_rect(start_x, start_y, start_x + size_x, start_y + size_y);
+  const CFX_Matrix matrix = pPage->GetDisplayMatrix(display_rect, rotate);
+  display_rect.Intersect(
+      FX_RECT(0, 0, pBitmap->GetWidth(), pBitmap->GetHeight()));
+  for (const CFX_FloatRect& damaged_rect : pPage->GetDamagedRects()) {
+    CFX_FloatRect device_rect = matrix.TransformRect(damaged_rect);
+    device_rect.Inflate(kDamageMargin, kDamageMargin);
+    FX_RECT clip_rect = device_rect.GetOuterRect();
+    clip_rect.Intersect(display_rect);
+    if (clip_rect.IsEmpty())
+      continue;
+
+    FPDFBitmap_FillRect(bitmap, clip_rect.left, clip_rect.top,
+                        clip_rect.Width(), clip_rect.Height(), color);
+
+    auto pOwnedContext = std::make_unique<CPDF_PageRenderContext>();
+    CPDF_PageRenderContext* pContext = pOwnedContext.get();
+    CPDF_Page::RenderContextClearer clearer(pPage);
+    pPage->SetRenderContext(std::move(pOwnedContext));
+
+    auto pOwnedDevice = std::make_unique<CFX_DefaultRenderDevice>();
+    CFX_DefaultRenderDevice* pDevice = pOwnedDevice.get();
+    pContext->m_pDevice = std::move(pOwnedDevice);
+    pDevice->Attach(pBitmap, !!(flags & FPDF_REVERSE_BYTE_ORDER), nullptr,
+                    false);
+    CPDFSDK_RenderPage(pContext, pPage, matrix, clip_rect, flags,
+                       /*color_scheme=*/nullptr);
+#if defined(_SKIA_SUPPORT_PATHS_)
+    pDevice->Flush(true);
+    pBitmap->UnPreMultiply();
+#endif
+  }
+}
+
 #if defined(_SKIA_SUPPORT_)
 FPDF_EXPORT FPDF_RECORDER FPDF_CALLCONV FPDF_RenderPageSkp(FPDF_PAGE page,
                                                            int size_x,
@@ -917,10 +1016,10 @@ FPDF_GetPageSizeByIndexF(FPDF_DOCUMENT document,
   if (!pDict)
     return false;
 
-  auto page = pdfium::MakeRetain<CPDF_Page>(pDoc, pDict);
-  page->SetRenderCache(std::make_unique<CPDF_PageRenderCache>(page.Get()));
-  size->width = page->GetPageWidth();
-  size->height = page->GetPageHeight();
+  const PageGeometry geometry =
+      GetPageGeometry(pDoc->GetPageTreeIndex(), pDict);
+  size->width = geometry.size.width;
+  size->height = geometry.size.height;
   return true;
 }
 
@@ -940,6 +1039,80 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_GetPageSizeByIndex(FPDF_DOCUMENT document,
   return true;
 }
 
+FPDF_EXPORT int FPDF_CALLCONV
+FPDF_GetPageInfoRange(FPDF_DOCUMENT document,
+                      int start_index,
+                      int count,
+                      FPDF_PAGE_INFO* infos,
+                      void* label_buffer,
+                      unsigned long label_buflen) {
+  auto* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc || !infos || start_index < 0 || count < 0)
+    return -1;
+
+#ifdef PDF_ENABLE_XFA
+  if (pDoc->GetExtension())
+    return -1;
+#endif  // PDF_ENABLE_XFA
+
+  const int page_count = pDoc->GetPageCount();
+  if (start_index > page_count)
+    return -1;
+
+  count = std::min(count, page_count - start_index);
+  CPDF_PageTreeIndex* pIndex = pDoc->GetPageTreeIndex();
+  CPDF_PageLabel page_label(pDoc);
+  std::vector<ByteString> labels;
+  pdfium::base::CheckedNumeric<unsigned long> label_total = 0;
+  int filled = 0;
+  for (; filled < count; ++filled) {
+    const int page_index = start_index + filled;
+    const CPDF_Dictionary* pDict = pDoc->GetPageDictionary(page_index);
+    if (!pDict)
+      break;
+
+    const PageGeometry geometry = GetPageGeometry(pIndex, pDict);
+    FPDF_PAGE_INFO& info = infos[filled];
+    info.width = geometry.size.width;
+    info.height = geometry.size.height;
+    info.rotation = geometry.rotation;
+    info.media_box = FSRectFFromCFXFloatRect(geometry.mediabox);
+    info.crop_box = FSRectFFromCFXFloatRect(geometry.bbox);
+    info.bleed_box = GetPageBoxOr(pDict, pdfium::page_object::kBleedBox,
+                                  geometry.bbox);
+    info.trim_box =
+        GetPageBoxOr(pDict, pdfium::page_object::kTrimBox, geometry.bbox);
+    info.art_box =
+        GetPageBoxOr(pDict, pdfium::page_object::kArtBox, geometry.bbox);
+    const float user_unit = pDict->GetNumberFor("UserUnit");
+    info.user_unit = user_unit > 0 ? user_unit : 1.0f;
+    const CPDF_Array* pAnnots = pDict->GetArrayFor("Annots");
+    info.has_annotations = pAnnots && !pAnnots->IsEmpty();
+    const CPDF_Dictionary* pGroup = pDict->GetDictFor("Group");
+    info.has_transparency_group =
+        pGroup && pGroup->GetStringFor(pdfium::transparency::kGroupSubType) ==
+                      pdfium::transparency::kTransparency;
+
+    Optional<WideString> label = page_label.GetLabel(page_index);
+    labels.push_back(label.has_value() ? label.value().ToUTF16LE()
+                                       : ByteString());
+    info.label_offset = label_total.ValueOrDefault(0);
+    info.label_length = labels.back().GetLength();
+    label_total += info.label_length;
+  }
+
+  if (label_buffer && label_total.IsValid() &&
+      label_total.ValueOrDie() <= label_buflen) {
+    for (int i = 0; i < filled; ++i) {
+      if (!labels[i].IsEmpty()) {
+        memcpy(static_cast<uint8_t*>(label_buffer) + infos[i].label_offset,
+               labels[i].c_str(), labels[i].GetLength());
+      }
+    }
+  }
+  return filled;
+}
+
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
 FPDF_VIEWERREF_GetPrintScaling(FPDF_DOCUMENT document) {
   const CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
@@ -121,6 +121,7 @@ int CheckPDFiumCApi() {
     CHK(FPDFAvail_Destroy);
     CHK(FPDFAvail_GetDocument);
     CHK(FPDFAvail_GetFirstPageNum);
+    CHK(FPDFAvail_GetPageRanges);
     CHK(FPDFAvail_IsDocAvail);
     CHK(FPDFAvail_IsFormAvail);
     CHK(FPDFAvail_IsLinearized);
@@ -212,9 +213,12 @@ int CheckPDFiumCApi() {
     CHK(FPDFPageObj_SetStrokeColor);
     CHK(FPDFPageObj_SetStrokeWidth);
     CHK(FPDFPageObj_Transform);
+    CHK(FPDFPage_ClearDamage);
+    CHK(FPDFPage_CountDamagedRects);
     CHK(FPDFPage_CountObjects);
     CHK(FPDFPage_Delete);
     CHK(FPDFPage_GenerateContent);
+    CHK(FPDFPage_GetDamagedRect);
     CHK(FPDFPage_GetObject);
     CHK(FPDFPage_GetRotation);
     CHK(FPDFPage_HasTransparency);
@@ -317,6 +321,8 @@ int CheckPDFiumCApi() {
     CHK(FPDF_NewXObjectFromPage);
 
     // fpdf_progressive.h
+    CHK(FPDF_LoadPageForProgressiveRender);
+    CHK(FPDF_LoadPageIndex);
     CHK(FPDF_RenderPageBitmapWithColorScheme_Start);
     CHK(FPDF_RenderPageBitmap_Start);
     CHK(FPDF_RenderPage_Close);
@@ -370,10 +376,13 @@ int CheckPDFiumCApi() {
     CHK(FPDFLink_GetTextRange);
     CHK(FPDFLink_GetURL);
     CHK(FPDFLink_LoadWebLinks);
+    CHK(FPDFText_CloseDocumentIndex);
+    CHK(FPDFText_CloseDocumentIterator);
     CHK(FPDFText_ClosePage);
     CHK(FPDFText_CountChars);
     CHK(FPDFText_CountRects);
     CHK(FPDFText_FindClose);
+    CHK(FPDFText_FindInDocumentIndex);
     CHK(FPDFText_FindNext);
     CHK(FPDFText_FindPrev);
     CHK(FPDFText_FindStart);
@@ -381,6 +390,7 @@ int CheckPDFiumCApi() {
     CHK(FPDFText_GetCharAngle);
     CHK(FPDFText_GetCharBox);
     CHK(FPDFText_GetCharIndexAtPos);
+    CHK(FPDFText_GetCharInfoRange);
     CHK(FPDFText_GetCharOrigin);
     CHK(FPDFText_GetFillColor);
     CHK(FPDFText_GetFontInfo);
@@ -395,7 +405,10 @@ int CheckPDFiumCApi() {
     CHK(FPDFText_GetText);
     CHK(FPDFText_GetTextRenderMode);
     CHK(FPDFText_GetUnicode);
+    CHK(FPDFText_LoadDocumentIndex);
     CHK(FPDFText_LoadPage);
+    CHK(FPDFText_NextPage);
+    CHK(FPDFText_OpenDocumentIterator);
 
     // fpdf_thumbnail.h
     CHK(FPDFPage_GetDecodedThumbnailData);
@@ -456,6 +469,7 @@ int CheckPDFiumCApi() {
     CHK(FPDF_GetPageCount);
     CHK(FPDF_GetPageHeight);
     CHK(FPDF_GetPageHeightF);
+    CHK(FPDF_GetPageInfoRange);
     CHK(FPDF_GetPageSizeByIndex);
     CHK(FPDF_GetPageSizeByIndexF);
     CHK(FPDF_GetPageWidth);
@@ -480,6 +494,7 @@ int CheckPDFiumCApi() {
     CHK(FPDF_RenderPage);
 #endif
     CHK(FPDF_RenderPageBitmap);
+    CHK(FPDF_RenderPageBitmapDamage);
     CHK(FPDF_RenderPageBitmapWithMatrix);
 #if defined(_SKIA_SUPPORT_)
     CHK(FPDF_RenderPageSkp);
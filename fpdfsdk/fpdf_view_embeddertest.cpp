@@ -13,6 +13,9 @@
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "fpdfsdk/fpdf_view_c_api_test.h"
 #include "public/cpp/fpdf_scopers.h"
+#include "public/fpdf_doc.h"
+#include "public/fpdf_edit.h"
+#include "public/fpdf_progressive.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
 #include "testing/embedder_test_constants.h"
@@ -1038,6 +1041,128 @@ TEST_F(FPDFViewEmbedderTest, FPDF_GetPageSizeByIndexF) {
   UnloadPage(page);
 }
 
+TEST_F(FPDFViewEmbedderTest, FPDF_GetPageSizeByIndexFInheritedAttrs) {
+  // The pages inherit their media box, and one of them is rotated.
+  ASSERT_TRUE(OpenDocument("rectangles_multi_pages.pdf"));
+  const int page_count = FPDF_GetPageCount(document());
+  ASSERT_EQ(5, page_count);
+
+  EXPECT_EQ(FPDF_RENDER_FAILED, FPDF_LoadPageIndex(nullptr, nullptr));
+  EXPECT_EQ(FPDF_RENDER_DONE, FPDF_LoadPageIndex(document(), nullptr));
+
+  std::vector<FS_SIZEF> sizes(page_count);
+  for (int i = 0; i < page_count; ++i)
+    ASSERT_TRUE(FPDF_GetPageSizeByIndexF(document(), i, &sizes[i]));
+
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document());
+#ifndef PDF_ENABLE_XFA
+  EXPECT_EQ(0u, pDoc->GetParsedPageCountForTesting());
+#endif  // PDF_ENABLE_XFA
+
+  for (int i = 0; i < page_count; ++i) {
+    FPDF_PAGE page = LoadPage(i);
+    ASSERT_TRUE(page);
+    EXPECT_FLOAT_EQ(sizes[i].width, FPDF_GetPageWidthF(page));
+    EXPECT_FLOAT_EQ(sizes[i].height, FPDF_GetPageHeightF(page));
+    UnloadPage(page);
+  }
+  EXPECT_FLOAT_EQ(200.0f, sizes[0].width);
+  EXPECT_FLOAT_EQ(250.0f, sizes[0].height);
+  EXPECT_FLOAT_EQ(250.0f, sizes[1].width);
+  EXPECT_FLOAT_EQ(200.0f, sizes[1].height);
+}
+
+TEST_F(FPDFViewEmbedderTest, FPDF_GetPageInfoRange) {
+  ASSERT_TRUE(OpenDocument("rectangles_multi_pages.pdf"));
+  FPDF_PAGE_INFO infos[8];
+  EXPECT_EQ(-1, FPDF_GetPageInfoRange(nullptr, 0, 1, infos, nullptr, 0));
+  EXPECT_EQ(-1, FPDF_GetPageInfoRange(document(), 0, 1, nullptr, nullptr, 0));
+  EXPECT_EQ(-1, FPDF_GetPageInfoRange(document(), -1, 1, infos, nullptr, 0));
+  EXPECT_EQ(-1, FPDF_GetPageInfoRange(document(), 0, -1, infos, nullptr, 0));
+  EXPECT_EQ(-1, FPDF_GetPageInfoRange(document(), 6, 1, infos, nullptr, 0));
+  EXPECT_EQ(0, FPDF_GetPageInfoRange(document(), 5, 1, infos, nullptr, 0));
+
+  // Ranges past the last page are cut short.
+  ASSERT_EQ(3, FPDF_GetPageInfoRange(document(), 2, 8, infos, nullptr, 0));
+  ASSERT_EQ(5, FPDF_GetPageInfoRange(document(), 0, 8, infos, nullptr, 0));
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document());
+  EXPECT_EQ(0u, pDoc->GetParsedPageCountForTesting());
+
+  // The media box is inherited and page 1 is rotated.
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_FLOAT_EQ(0.0f, infos[i].media_box.left);
+    EXPECT_FLOAT_EQ(0.0f, infos[i].media_box.bottom);
+    EXPECT_FLOAT_EQ(200.0f, infos[i].media_box.right);
+    EXPECT_FLOAT_EQ(250.0f, infos[i].media_box.top);
+    EXPECT_FLOAT_EQ(200.0f, infos[i].art_box.right);
+    EXPECT_FLOAT_EQ(1.0f, infos[i].user_unit);
+    EXPECT_FALSE(infos[i].has_annotations);
+    EXPECT_FALSE(infos[i].has_transparency_group);
+    EXPECT_EQ(0u, infos[i].label_length);
+
+    ScopedFPDFPage page(FPDF_LoadPage(document(), i));
+    ASSERT_TRUE(page);
+    EXPECT_FLOAT_EQ(FPDF_GetPageWidthF(page.get()), infos[i].width);
+    EXPECT_FLOAT_EQ(FPDF_GetPageHeightF(page.get()), infos[i].height);
+    EXPECT_EQ(FPDFPage_GetRotation(page.get()), infos[i].rotation);
+    FS_RECTF bbox;
+    ASSERT_TRUE(FPDF_GetPageBoundingBox(page.get(), &bbox));
+    EXPECT_FLOAT_EQ(bbox.left, infos[i].crop_box.left);
+    EXPECT_FLOAT_EQ(bbox.top, infos[i].crop_box.top);
+    EXPECT_FLOAT_EQ(bbox.right, infos[i].crop_box.right);
+    EXPECT_FLOAT_EQ(bbox.bottom, infos[i].crop_box.bottom);
+  }
+  EXPECT_EQ(1, infos[1].rotation);
+}
+
+TEST_F(FPDFViewEmbedderTest, FPDF_GetPageInfoRangeLabels) {
+  ASSERT_TRUE(OpenDocument("page_labels.pdf"));
+  FPDF_PAGE_INFO infos[7];
+  ASSERT_EQ(7, FPDF_GetPageInfoRange(document(), 0, 7, infos, nullptr, 0));
+  const unsigned long total = infos[6].label_offset + infos[6].label_length;
+
+  // Too small a buffer is left alone.
+  std::vector<unsigned short> buf(total / 2, 0xffff);
+  ASSERT_EQ(7, FPDF_GetPageInfoRange(document(), 0, 7, infos, buf.data(),
+                                     total - 1));
+  EXPECT_EQ(0xffff, buf[0]);
+
+  ASSERT_EQ(7,
+            FPDF_GetPageInfoRange(document(), 0, 7, infos, buf.data(), total));
+  for (int i = 0; i < 7; ++i) {
+    unsigned short expected[128];
+    ASSERT_EQ(FPDF_GetPageLabel(document(), i, expected, sizeof(expected)),
+              infos[i].label_length);
+    EXPECT_EQ(0, memcmp(expected, &buf[infos[i].label_offset / 2],
+                        infos[i].label_length));
+  }
+
+  // A range starting in the middle of a labelling range.
+  ASSERT_EQ(2,
+            FPDF_GetPageInfoRange(document(), 4, 2, infos, buf.data(), total));
+  EXPECT_EQ(0u, infos[0].label_offset);
+  EXPECT_EQ(8u, infos[0].label_length);
+  EXPECT_EQ(WideString(L"zzA"), WideString::FromUTF16LE(&buf[0], 3));
+  EXPECT_EQ(WideString(L"zzB"), WideString::FromUTF16LE(&buf[4], 3));
+}
+
+TEST_F(FPDFViewEmbedderTest, FPDF_GetPageInfoRangeAnnotations) {
+  ASSERT_TRUE(OpenDocument("annots.pdf"));
+  FPDF_PAGE_INFO infos[2];
+  ASSERT_EQ(2, FPDF_GetPageInfoRange(document(), 0, 2, infos, nullptr, 0));
+  EXPECT_TRUE(infos[0].has_annotations);
+  EXPECT_TRUE(infos[1].has_annotations);
+  EXPECT_FALSE(infos[0].has_transparency_group);
+}
+
+TEST_F(FPDFViewEmbedderTest, FPDF_GetPageInfoRangeTransparencyGroup) {
+  ASSERT_TRUE(OpenDocument("tagged_table.pdf"));
+  FPDF_PAGE_INFO infos[1];
+  ASSERT_EQ(1, FPDF_GetPageInfoRange(document(), 0, 1, infos, nullptr, 0));
+  EXPECT_TRUE(infos[0].has_transparency_group);
+  EXPECT_FALSE(infos[0].has_annotations);
+}
+
 TEST_F(FPDFViewEmbedderTest, FPDF_GetPageSizeByIndex) {
   ASSERT_TRUE(OpenDocument("rectangles.pdf"));
 
@@ -79,6 +79,18 @@ struct FPDFTextFindDeleter {
   inline void operator()(FPDF_SCHHANDLE handle) { FPDFText_FindClose(handle); }
 };
 
+struct FPDFTextIndexDeleter {
+  inline void operator()(FPDF_TEXTINDEX index) {
+    FPDFText_CloseDocumentIndex(index);
+  }
+};
+
+struct FPDFTextIteratorDeleter {
+  inline void operator()(FPDF_TEXTITERATOR iterator) {
+    FPDFText_CloseDocumentIterator(iterator);
+  }
+};
+
 struct FPDFTextPageDeleter {
   inline void operator()(FPDF_TEXTPAGE text) { FPDFText_ClosePage(text); }
 };
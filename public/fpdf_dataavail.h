@@ -158,6 +158,40 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsPageAvail(FPDF_AVAIL avail,
                                                     int page_index,
                                                     FX_DOWNLOADHINTS* hints);
 
+// Experimental API.
+// A range of bytes of the file.
+typedef struct _FPDF_BYTE_RANGE {
+  // Offset of the first byte of the range in the file.
+  size_t offset;
+  // Number of bytes in the range.
+  size_t size;
+} FPDF_BYTE_RANGE;
+
+// Experimental API.
+// Check if |page_index| is ready for loading, like FPDFAvail_IsPageAvail(),
+// but get all the data needed for the next step as one batch of large reads,
+// for applications that fetch the file over a network.
+//
+//   avail      - handle to document availability provider.
+//   page_index - index number of the page. Zero for the first page.
+//   ranges     - array that receives up to |count| ranges, sorted by offset
+//                and not overlapping. Optional.
+//   count      - number of elements in |ranges|.
+//
+// Returns the number of ranges needed, which may be larger than |count|, 0 if
+// the page is available, or -1 on error.
+//
+// This function can be called only after FPDFAvail_GetDocument() is called.
+// Applications should fetch all the returned ranges, in parallel if possible,
+// and call this function again until it returns 0 or -1. Data the page needs
+// can only be found once the data referring to it has arrived, so for
+// non-linearized files this takes about as many rounds as the page has levels
+// of nested objects, e.g. page, resources, font, font file.
+FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_GetPageRanges(FPDF_AVAIL avail,
+                                                      int page_index,
+                                                      FPDF_BYTE_RANGE* ranges,
+                                                      int count);
+
 // Check if form data is ready for initialization, if not, get the
 // |FX_DOWNLOADHINTS|.
 //
@@ -199,6 +199,36 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_HasTransparency(FPDF_PAGE page);
 // |FPDFPage_GenerateContent| or any changes to |page| will be lost.
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_GenerateContent(FPDF_PAGE page);
 
+// Experimental API.
+// Get the number of areas of |page| that have to be repainted because page
+// objects were added, removed or changed since the page was loaded, or since
+// the last call to FPDFPage_ClearDamage(). Changes to objects inside form
+// XObjects or annotations are not tracked.
+//
+//   page - handle to a page.
+//
+// Returns the number of damaged areas, or -1 on failure.
+FPDF_EXPORT int FPDF_CALLCONV FPDFPage_CountDamagedRects(FPDF_PAGE page);
+
+// Experimental API.
+// Get a damaged area of |page|, in page coordinates.
+//
+//   page  - handle to a page.
+//   index - index of the area, less than FPDFPage_CountDamagedRects().
+//   rect  - receives the area.
+//
+// Returns TRUE on success.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_GetDamagedRect(FPDF_PAGE page,
+                                                            int index,
+                                                            FS_RECTF* rect);
+
+// Experimental API.
+// Forget the damaged areas of |page|, e.g. after they were re-rendered with
+// FPDF_RenderPageBitmapDamage().
+//
+//   page - handle to a page.
+FPDF_EXPORT void FPDF_CALLCONV FPDFPage_ClearDamage(FPDF_PAGE page);
+
 // Destroy |page_obj| by releasing its resources. |page_obj| must have been
 // created by FPDFPageObj_CreateNew{Path|Rect}() or
 // FPDFPageObj_New{Text|Image}Obj(). This function must be called on
@@ -1233,7 +1263,9 @@ FPDFFormObj_CountObjects(FPDF_PAGEOBJECT form_object);
 //   form_object - handle to a form object.
 //   index       - the 0-based index of a page object.
 //
-// Returns the handle to the page object, or NULL on error.
+// Returns the handle to the page object, or NULL on error. Changes to the
+// returned object only affect |form_object|, even if other form objects
+// draw the same form XObject.
 FPDF_EXPORT FPDF_PAGEOBJECT FPDF_CALLCONV
 FPDFFormObj_GetObject(FPDF_PAGEOBJECT form_object, unsigned long index);
 
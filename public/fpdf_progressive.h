@@ -46,6 +46,51 @@ typedef struct _IFSDK_PAUSE {
   void* user;
 } IFSDK_PAUSE;
 
+// Experimental API.
+// Function: FPDF_LoadPageForProgressiveRender
+//          Load a page without parsing its content. The progressive rendering
+//          functions then parse the content a step at a time and draw the
+//          objects of each step right away, so that the first objects of a
+//          large page show up before its content is fully parsed.
+// Parameters:
+//          document    -   Handle to document, as returned by
+//                          FPDF_LoadDocument().
+//          page_index  -   Index number of the page. 0 for the first page.
+// Return value:
+//          A handle to the loaded page, or NULL if page load fails.
+// Comments:
+//          Until FPDF_RenderPage_Close() is called, functions that read the
+//          page objects see only the ones parsed so far, and the page must
+//          not be edited. This includes FPDFPage_HasTransparency() and
+//          FPDFText_LoadPage(). FPDF_RenderPage_Close() finishes parsing,
+//          after which the page can be used like one returned by
+//          FPDF_LoadPage().
+FPDF_EXPORT FPDF_PAGE FPDF_CALLCONV
+FPDF_LoadPageForProgressiveRender(FPDF_DOCUMENT document, int page_index);
+
+// Experimental API.
+// Function: FPDF_LoadPageIndex
+//          Resolve the page dictionaries of all pages of a document up front,
+//          so that later calls taking a page index, e.g.
+//          FPDF_GetPageSizeByIndexF(), do not walk the page tree. Calling it
+//          is optional and only makes those calls cheaper.
+// Parameters:
+//          document    -   Handle to document, as returned by
+//                          FPDF_LoadDocument().
+//          pause       -   The IFSDK_PAUSE interface, checked every few pages
+//                          to let indexing be spread over several calls. This
+//                          can be NULL to index all pages in one call.
+// Return value:
+//          FPDF_RENDER_DONE once all pages are indexed,
+//          FPDF_RENDER_TOBECONTINUED if |pause| asked to stop first, in which
+//          case call it again to continue, or FPDF_RENDER_FAILED if
+//          |document| or |pause| is invalid.
+// Comments:
+//          For documents being downloaded, only call this once all pages are
+//          available.
+FPDF_EXPORT int FPDF_CALLCONV FPDF_LoadPageIndex(FPDF_DOCUMENT document,
+                                                 IFSDK_PAUSE* pause);
+
 // Experimental API.
 // Function: FPDF_RenderPageBitmapWithColorScheme_Start
 //          Start to render page contents to a device independent bitmap
@@ -145,7 +190,8 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_RenderPage_Continue(FPDF_PAGE page,
 // Function: FPDF_RenderPage_Close
 //          Release the resource allocate during page rendering. Need to be
 //          called after finishing rendering or
-//          cancel the rendering.
+//          cancel the rendering. Also finishes parsing pages loaded with
+//          FPDF_LoadPageForProgressiveRender().
 // Parameters:
 //          page        -   Handle to the page, as returned by FPDF_LoadPage().
 // Return value:
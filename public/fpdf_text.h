@@ -301,6 +301,59 @@ FPDFText_GetCharOrigin(FPDF_TEXTPAGE text_page,
                        double* x,
                        double* y);
 
+// Flags returned by FPDFText_GetCharInfoRange.
+//
+// The character was inserted by PDFium, e.g. a space or line break, and does
+// not come from the page content.
+#define FPDF_TEXTCHAR_GENERATED 0x00000001
+// The character is a hyphen at the end of a line.
+#define FPDF_TEXTCHAR_HYPHEN 0x00000002
+// The character's unicode value could not be determined from its font.
+#define FPDF_TEXTCHAR_UNICODEMAPERROR 0x00000004
+
+// Experimental API.
+// Function: FPDFText_GetCharInfoRange
+//          Get information about a range of characters in a single call.
+// Parameters:
+//          text_page   -   Handle to a text page information structure.
+//                          Returned by FPDFText_LoadPage function.
+//          start_index -   Zero-based index of the first character.
+//          count       -   Number of characters to retrieve. Clamped to the
+//                          number of characters after |start_index|.
+//          unicodes    -   Array receiving the unicode value of each
+//                          character, as FPDFText_GetUnicode.
+//          char_boxes  -   Array receiving the box of each character, as
+//                          FPDFText_GetCharBox.
+//          origins     -   Array receiving the origin of each character, as
+//                          FPDFText_GetCharOrigin.
+//          font_sizes  -   Array receiving the font size of each character,
+//                          as FPDFText_GetFontSize.
+//          font_ids    -   Array receiving an id for the font of each
+//                          character, or -1 if it has none. All characters of
+//                          the text page sharing a font have the same id. Use
+//                          FPDFText_GetFontInfo with the index of any of them
+//                          to get details of the font.
+//          flags       -   Array receiving FPDF_TEXTCHAR_* flags for each
+//                          character.
+// Return Value:
+//          The number of characters written to each array, or -1 if
+//          |text_page| is invalid or |start_index| is out of bounds.
+// Comments:
+//          Each array may be NULL, in which case it is skipped. Otherwise, it
+//          must have room for |count| entries. All positions are measured in
+//          PDF "user space".
+//
+FPDF_EXPORT int FPDF_CALLCONV
+FPDFText_GetCharInfoRange(FPDF_TEXTPAGE text_page,
+                          int start_index,
+                          int count,
+                          unsigned int* unicodes,
+                          FS_RECTF* char_boxes,
+                          FS_POINTF* origins,
+                          float* font_sizes,
+                          int* font_ids,
+                          unsigned int* flags);
+
 // Function: FPDFText_GetCharIndexAtPos
 //          Get the index of a character at or nearby a certain position on the
 //          page.
@@ -505,6 +558,124 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFText_GetSchCount(FPDF_SCHHANDLE handle);
 //
 FPDF_EXPORT void FPDF_CALLCONV FPDFText_FindClose(FPDF_SCHHANDLE handle);
 
+// Experimental API.
+// Function: FPDFText_OpenDocumentIterator
+//          Start extracting the text of a document one page at a time.
+// Parameters:
+//          document    -   Handle to a document.
+// Return Value:
+//          A handle to the iterator, or NULL if |document| is invalid.
+//          FPDFText_CloseDocumentIterator must be called to release this
+//          handle.
+// Comments:
+//          Pages are parsed in a text-only mode that skips paths, clip paths,
+//          images and shadings, which is considerably faster than
+//          FPDF_LoadPage followed by FPDFText_LoadPage. Only the current page
+//          is kept in memory.
+//
+FPDF_EXPORT FPDF_TEXTITERATOR FPDF_CALLCONV
+FPDFText_OpenDocumentIterator(FPDF_DOCUMENT document);
+
+// Experimental API.
+// Function: FPDFText_NextPage
+//          Advance a document iterator to the next page.
+// Parameters:
+//          iterator    -   Handle returned by FPDFText_OpenDocumentIterator.
+//          page_index  -   Optional pointer receiving the zero-based index of
+//                          the returned page.
+// Return Value:
+//          A text page that may be used with all FPDFText_* functions, or NULL
+//          once every page has been visited. The text page is owned by
+//          |iterator| and remains valid until the next call to this function
+//          or to FPDFText_CloseDocumentIterator. It must not be passed to
+//          FPDFText_ClosePage.
+// Comments:
+//          Pages that cannot be loaded are skipped.
+//
+FPDF_EXPORT FPDF_TEXTPAGE FPDF_CALLCONV
+FPDFText_NextPage(FPDF_TEXTITERATOR iterator, int* page_index);
+
+// Experimental API.
+// Function: FPDFText_CloseDocumentIterator
+//          Release a document iterator and its current text page.
+// Parameters:
+//          iterator    -   Handle returned by FPDFText_OpenDocumentIterator.
+// Return Value:
+//          None.
+//
+FPDF_EXPORT void FPDF_CALLCONV
+FPDFText_CloseDocumentIterator(FPDF_TEXTITERATOR iterator);
+
+// Experimental API.
+// Function: FPDFText_LoadDocumentIndex
+//          Extract the text of every page of a document into an index that
+//          can be searched repeatedly with FPDFText_FindInDocumentIndex.
+// Parameters:
+//          document    -   Handle to a document.
+// Return Value:
+//          A handle to the text index, or NULL if |document| is invalid.
+//          FPDFText_CloseDocumentIndex must be called to release this handle.
+// Comments:
+//          Pages are visited as by FPDFText_OpenDocumentIterator.
+//          The index holds a copy of the text, so it remains valid if the
+//          document is modified, but does not reflect those changes.
+//
+FPDF_EXPORT FPDF_TEXTINDEX FPDF_CALLCONV
+FPDFText_LoadDocumentIndex(FPDF_DOCUMENT document);
+
+// Experimental API.
+// A single search result from FPDFText_FindInDocumentIndex.
+typedef struct _FPDF_TEXTINDEX_MATCH {
+  // Index into the |queries| array of the query that matched.
+  int query_index;
+  // Zero-based index of the page containing the match.
+  int page_index;
+  // Start char index and char count of the match on that page, in the same
+  // terms as FPDFText_GetSchResultIndex and FPDFText_GetSchCount.
+  int char_index;
+  int char_count;
+} FPDF_TEXTINDEX_MATCH;
+
+// Experimental API.
+// Function: FPDFText_FindInDocumentIndex
+//          Search a text index for all occurrences of several queries at once.
+// Parameters:
+//          text_index  -   Handle returned by FPDFText_LoadDocumentIndex.
+//          queries     -   Array of |query_count| unicode strings. Each is
+//                          matched literally; empty queries never match.
+//          query_count -   Number of entries in |queries|.
+//          flags       -   Option flags, as for FPDFText_FindStart.
+//          matches     -   Caller-allocated array to receive the results, in
+//                          page order, then by starting position. May be
+//                          NULL if |max_matches| is 0.
+//          max_matches -   Number of entries available in |matches|.
+// Return Value:
+//          The total number of matches, which may be larger than
+//          |max_matches|, or -1 on invalid arguments. Only the first
+//          |max_matches| results are written to |matches|.
+// Comments:
+//          Matches never span two pages. Unless FPDF_CONSECUTIVE is set,
+//          occurrences of the same query do not overlap.
+//
+FPDF_EXPORT int FPDF_CALLCONV
+FPDFText_FindInDocumentIndex(FPDF_TEXTINDEX text_index,
+                             const FPDF_WIDESTRING* queries,
+                             int query_count,
+                             unsigned long flags,
+                             FPDF_TEXTINDEX_MATCH* matches,
+                             int max_matches);
+
+// Experimental API.
+// Function: FPDFText_CloseDocumentIndex
+//          Release a text index.
+// Parameters:
+//          text_index  -   Handle returned by FPDFText_LoadDocumentIndex.
+// Return Value:
+//          None.
+//
+FPDF_EXPORT void FPDF_CALLCONV
+FPDFText_CloseDocumentIndex(FPDF_TEXTINDEX text_index);
+
 // Function: FPDFLink_LoadWebLinks
 //          Prepare information about weblinks in a page.
 // Parameters:
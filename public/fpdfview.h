@@ -75,6 +75,8 @@ typedef struct fpdf_schhandle_t__* FPDF_SCHHANDLE;
 typedef struct fpdf_signature_t__* FPDF_SIGNATURE;
 typedef struct fpdf_structelement_t__* FPDF_STRUCTELEMENT;
 typedef struct fpdf_structtree_t__* FPDF_STRUCTTREE;
+typedef struct fpdf_textindex_t__* FPDF_TEXTINDEX;
+typedef struct fpdf_textiterator_t__* FPDF_TEXTITERATOR;
 typedef struct fpdf_textpage_t__* FPDF_TEXTPAGE;
 typedef struct fpdf_widget_t__* FPDF_WIDGET;
 typedef struct fpdf_xobject_t__* FPDF_XOBJECT;
@@ -249,6 +251,15 @@ typedef struct FPDF_LIBRARY_CONFIG_ {
   // Pointer to the V8::Platform to use.
   void* m_pPlatform;
 
+  // Version 4 - Experimental.
+
+  // Path of a file in which to keep the list of fonts found when scanning
+  // |m_pUserFontPaths| or the default paths, so that later processes can
+  // skip the scan. The file is rewritten whenever the scanned directories
+  // change. May be NULL to always scan. May be ignored entirely depending
+  // upon the platform.
+  const char* m_pFontCatalogPath;
+
 } FPDF_LIBRARY_CONFIG;
 
 // Function: FPDF_InitLibraryWithConfig
@@ -761,6 +772,70 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_GetPageSizeByIndex(FPDF_DOCUMENT document,
                                                       double* width,
                                                       double* height);
 
+// Experimental API.
+// Geometry and metadata of a page, as filled in by FPDF_GetPageInfoRange().
+typedef struct FPDF_PAGE_INFO_ {
+  // Page size in points, as returned by FPDF_GetPageSizeByIndexF().
+  float width;
+  float height;
+  // Page rotation, as returned by FPDFPage_GetRotation().
+  int rotation;
+  // Page boxes, with the defaults of the PDF specification applied. The crop
+  // box is clipped to the media box, and the bleed, trim and art boxes
+  // default to the crop box.
+  FS_RECTF media_box;
+  FS_RECTF crop_box;
+  FS_RECTF bleed_box;
+  FS_RECTF trim_box;
+  FS_RECTF art_box;
+  // Size of a user space unit, in multiples of 1/72 inch.
+  float user_unit;
+  // Whether the page has any annotations.
+  FPDF_BOOL has_annotations;
+  // Whether the page dictionary declares a transparency group. Unlike
+  // FPDFPage_HasTransparency(), this does not look at the page content.
+  FPDF_BOOL has_transparency_group;
+  // Offset of the page label in the label buffer, and its length, in bytes.
+  // The label is encoded like for FPDF_GetPageLabel(). The length is 0 if
+  // the document has no page labels.
+  unsigned long label_offset;
+  unsigned long label_length;
+} FPDF_PAGE_INFO;
+
+// Experimental API.
+// Function: FPDF_GetPageInfoRange
+//          Get the geometry and metadata of a range of pages in one call,
+//          from the page dictionaries only. Neither the pages nor their
+//          content are loaded.
+// Parameters:
+//          document        -   Handle to document. Returned by
+//                              FPDF_LoadDocument().
+//          start_index     -   Index of the first page of the range.
+//          count           -   Number of pages in the range. Pages past the
+//                              end of the document are left out.
+//          infos           -   Array of at least |count| FPDF_PAGE_INFO
+//                              structs to receive the page information.
+//          label_buffer    -   A buffer for the labels of all the pages of
+//                              the range, one after the other. May be NULL.
+//          label_buflen    -   The length of |label_buffer|, in bytes.
+// Return value:
+//          The number of pages filled into |infos|, or -1 on error, e.g. for
+//          an invalid document or range. Filling stops before the first page
+//          that cannot be loaded.
+// Comments:
+//          If |label_buflen| is less than the total length of the labels, or
+//          |label_buffer| is NULL, |label_buffer| is not modified. The total
+//          length is label_offset + label_length of the last filled page, so
+//          callers can allocate a buffer and call again. Not supported for
+//          XFA documents.
+FPDF_EXPORT int FPDF_CALLCONV
+FPDF_GetPageInfoRange(FPDF_DOCUMENT document,
+                      int start_index,
+                      int count,
+                      FPDF_PAGE_INFO* infos,
+                      void* label_buffer,
+                      unsigned long label_buflen);
+
 // Page rendering flags. They can be combined with bit-wise OR.
 //
 // Set if annotations are to be rendered.
@@ -898,6 +973,37 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                                 const FS_RECTF* clipping,
                                 int flags);
 
+// Experimental API.
+// Function: FPDF_RenderPageBitmapDamage
+//          Re-render the areas of a page that were changed by edits to its
+//          page objects, see FPDFPage_CountDamagedRects().
+// Parameters:
+//          bitmap      -   Handle to a bitmap that holds a rendering of the
+//                          page made by FPDF_RenderPageBitmap() with the
+//                          same |start_x|, |start_y|, |size_x|, |size_y|,
+//                          |rotate| and |flags|, before the edits.
+//          page        -   Handle to the page.
+//          start_x     -   Same as for FPDF_RenderPageBitmap().
+//          start_y     -   Same as for FPDF_RenderPageBitmap().
+//          size_x      -   Same as for FPDF_RenderPageBitmap().
+//          size_y      -   Same as for FPDF_RenderPageBitmap().
+//          rotate      -   Same as for FPDF_RenderPageBitmap().
+//          flags       -   Same as for FPDF_RenderPageBitmap().
+//          color       -   The background the changed areas are filled with
+//                          before rendering, as for FPDFBitmap_FillRect().
+// Return value:
+//          None. The damaged areas are kept; call FPDFPage_ClearDamage() once
+//          every bitmap showing the page has been updated.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageBitmapDamage(FPDF_BITMAP bitmap,
+                                                           FPDF_PAGE page,
+                                                           int start_x,
+                                                           int start_y,
+                                                           int size_x,
+                                                           int size_y,
+                                                           int rotate,
+                                                           int flags,
+                                                           FPDF_DWORD color);
+
 #if defined(_SKIA_SUPPORT_)
 FPDF_EXPORT FPDF_RECORDER FPDF_CALLCONV FPDF_RenderPageSkp(FPDF_PAGE page,
                                                            int size_x,
@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <chrono>
 #include <functional>
 #include <iterator>
 #include <map>
@@ -115,6 +116,7 @@ struct Options {
   bool no_smoothtext = false;
   bool no_smoothimage = false;
   bool no_smoothpath = false;
+  bool render_while_parsing = false;
   bool reverse_byte_order = false;
   bool save_attachments = false;
   bool save_images = false;
@@ -131,6 +133,7 @@ struct Options {
 #endif  // PDF_ENABLE_V8
   bool pages = false;
   bool md5 = false;
+  bool show_timing = false;
 #ifdef ENABLE_CALLGRIND
   bool callgrind_delimiters = false;
 #endif
@@ -143,6 +146,7 @@ struct Options {
   std::string exe_path;
   std::string bin_directory;
   std::string font_directory;
+  std::string font_catalog;
   int first_page = 0;  // First 0-based page number to renderer.
   int last_page = 0;   // Last 0-based page number to renderer.
   time_t time = -1;
@@ -216,6 +220,9 @@ struct FPDF_FORMFILLINFO_PDFiumTest final : public FPDF_FORMFILLINFO {
   // Hold a pointer of FPDF_FORMHANDLE so that PDFium app hooks can
   // make use of it.
   FPDF_FORMHANDLE form_handle;
+
+  // Load pages with FPDF_LoadPageForProgressiveRender().
+  bool render_while_parsing = false;
 };
 
 FPDF_FORMFILLINFO_PDFiumTest* ToPDFiumTestFormFillInfo(
@@ -448,6 +455,8 @@ bool ParseCommandLine(const std::vector<std::string>& args,
       options->no_smoothimage = true;
     } else if (cur_arg == "--no-smoothpath") {
       options->no_smoothpath = true;
+    } else if (cur_arg == "--render-while-parsing") {
+      options->render_while_parsing = true;
     } else if (cur_arg == "--reverse-byte-order") {
       options->reverse_byte_order = true;
     } else if (cur_arg == "--save-attachments") {
@@ -545,6 +554,12 @@ bool ParseCommandLine(const std::vector<std::string>& args,
       }
 
       options->font_directory = expanded_path.value();
+    } else if (ParseSwitchKeyValue(cur_arg, "--font-catalog=", &value)) {
+      if (!options->font_catalog.empty()) {
+        fprintf(stderr, "Duplicate --font-catalog argument\n");
+        return false;
+      }
+      options->font_catalog = value;
 
 #ifdef _WIN32
     } else if (cur_arg == "--emf") {
@@ -633,6 +648,8 @@ bool ParseCommandLine(const std::vector<std::string>& args,
       }
     } else if (cur_arg == "--md5") {
       options->md5 = true;
+    } else if (cur_arg == "--show-timing") {
+      options->show_timing = true;
     } else if (ParseSwitchKeyValue(cur_arg, "--time=", &value)) {
       if (options->time > -1) {
         fprintf(stderr, "Duplicate --time argument\n");
@@ -654,6 +671,12 @@ bool ParseCommandLine(const std::vector<std::string>& args,
   for (size_t i = cur_idx; i < args.size(); i++)
     files->push_back(args[i]);
 
+  if (options->render_while_parsing && options->render_oneshot) {
+    fprintf(stderr,
+            "--render-while-parsing requires the progressive renderer\n");
+    return false;
+  }
+
   return true;
 }
 
@@ -704,7 +727,9 @@ FPDF_PAGE GetPageForIndex(FPDF_FORMFILLINFO* param,
   if (iter != loaded_pages.end())
     return iter->second.get();
 
-  ScopedFPDFPage page(FPDF_LoadPage(doc, index));
+  ScopedFPDFPage page(form_fill_info->render_while_parsing
+                          ? FPDF_LoadPageForProgressiveRender(doc, index)
+                          : FPDF_LoadPage(doc, index));
   if (!page)
     return nullptr;
 
@@ -733,9 +758,23 @@ bool ProcessPage(const std::string& name,
                  const Options& options,
                  const std::string& events,
                  const std::function<void()>& idler) {
+  const auto start_time = std::chrono::steady_clock::now();
   FPDF_PAGE page = GetPageForIndex(form_fill_info, doc, page_index);
   if (!page)
     return false;
+
+  const auto load_time = std::chrono::steady_clock::now();
+  auto first_paint_time = load_time;
+
+  // With --render-while-parsing, the page is parsed by the renderer. Anything
+  // else that needs its objects first has to finish parsing up front.
+  if (options.render_while_parsing &&
+      (options.send_events || options.save_images ||
+       options.save_rendered_images ||
+       options.output_format == OutputFormat::kPageInfo ||
+       options.output_format == OutputFormat::kStructure)) {
+    FPDF_RenderPage_Close(page);
+  }
   if (options.send_events)
     SendPageEvents(form, page, events, idler);
   if (options.save_images)
@@ -757,14 +796,15 @@ bool ProcessPage(const std::string& name,
     return true;
   }
 
-  ScopedFPDFTextPage text_page(FPDFText_LoadPage(page));
   double scale = 1.0;
   if (!options.scale_factor_as_string.empty())
     std::stringstream(options.scale_factor_as_string) >> scale;
 
   auto width = static_cast<int>(FPDF_GetPageWidthF(page) * scale);
   auto height = static_cast<int>(FPDF_GetPageHeightF(page) * scale);
-  int alpha = FPDFPage_HasTransparency(page) ? 1 : 0;
+  // Whether the page needs alpha is only known once it is parsed.
+  int alpha =
+      !options.render_while_parsing && FPDFPage_HasTransparency(page) ? 1 : 0;
   ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, alpha));
 
   if (bitmap) {
@@ -777,6 +817,7 @@ bool ProcessPage(const std::string& name,
       // progressive calls. The progressive calls are if you need to pause the
       // rendering to update the UI, the PDF renderer will break when possible.
       FPDF_RenderPageBitmap(bitmap.get(), page, 0, 0, width, height, 0, flags);
+      first_paint_time = std::chrono::steady_clock::now();
     } else {
       IFSDK_PAUSE pause;
       pause.version = 1;
@@ -792,6 +833,7 @@ bool ProcessPage(const std::string& name,
       int rv = FPDF_RenderPageBitmapWithColorScheme_Start(
           bitmap.get(), page, 0, 0, width, height, 0, flags,
           options.forced_color ? &color_scheme : nullptr, &pause);
+      first_paint_time = std::chrono::steady_clock::now();
       while (rv == FPDF_RENDER_TOBECONTINUED)
         rv = FPDF_RenderPage_Continue(page, &pause);
     }
@@ -804,6 +846,19 @@ bool ProcessPage(const std::string& name,
       idler();
     }
 
+    if (options.show_timing) {
+      const auto end_time = std::chrono::steady_clock::now();
+      auto to_ms = [start_time](std::chrono::steady_clock::time_point time) {
+        return std::chrono::duration<double, std::milli>(time - start_time)
+            .count();
+      };
+      printf("Page %d: loaded %.3f ms, first paint %.3f ms, rendered %.3f ms\n",
+             page_index, to_ms(load_time), to_ms(first_paint_time),
+             to_ms(end_time));
+    }
+
+    ScopedFPDFTextPage text_page(FPDFText_LoadPage(page));
+
     int stride = FPDFBitmap_GetStride(bitmap.get());
     void* buffer = FPDFBitmap_GetBuffer(bitmap.get());
 
@@ -973,6 +1028,7 @@ void ProcessPdf(const std::string& name,
   form_callbacks.version = 1;
 #endif  // PDF_ENABLE_XFA
   form_callbacks.FFI_GetPage = GetPageForIndex;
+  form_callbacks.render_while_parsing = options.render_while_parsing;
 
 #ifdef PDF_ENABLE_V8
   if (!options.disable_javascript)
@@ -1096,6 +1152,8 @@ constexpr char kUsageString[] =
     "  --no-smoothtext        - render disabling text anti-aliasing\n"
     "  --no-smoothimage       - render disabling image anti-alisasing\n"
     "  --no-smoothpath        - render disabling path anti-aliasing\n"
+    "  --render-while-parsing - load pages unparsed and parse them while "
+    "rendering progressively; renders without alpha\n"
     "  --reverse-byte-order   - render to BGRA, if supported by the output "
     "format\n"
     "  --save-attachments     - write embedded attachments "
@@ -1126,6 +1184,8 @@ constexpr char kUsageString[] =
 #endif
     "  --bin-dir=<path>       - override path to v8 external data\n"
     "  --font-dir=<path>      - override path to external fonts\n"
+    "  --font-catalog=<path>  - keep the list of system fonts in the given "
+    "file\n"
     "  --scale=<number>       - scale output size by number (e.g. 0.5)\n"
     "  --password=<secret>    - password to decrypt the PDF with\n"
     "  --pages=<number>(-<number>) - only render the given 0-based page(s)\n"
@@ -1145,6 +1205,8 @@ constexpr char kUsageString[] =
     "  --skp   - write page images <pdf-name>.<page-number>.skp\n"
 #endif
     "  --md5   - write output image paths and their md5 hashes to stdout.\n"
+    "  --show-timing - print how long each page took to load, to draw its "
+    "first objects and to render.\n"
     "  --time=<number> - Seconds since the epoch to set system time.\n"
     "";
 
@@ -1170,11 +1232,13 @@ int main(int argc, const char* argv[]) {
   }
 
   FPDF_LIBRARY_CONFIG config;
-  config.version = 3;
+  config.version = 4;
   config.m_pUserFontPaths = nullptr;
   config.m_pIsolate = nullptr;
   config.m_v8EmbedderSlot = 0;
   config.m_pPlatform = nullptr;
+  config.m_pFontCatalogPath =
+      options.font_catalog.empty() ? nullptr : options.font_catalog.c_str();
 
   std::function<void()> idler = []() {};
 #ifdef PDF_ENABLE_V8
@@ -108,6 +108,8 @@ int FakeFileAccess::GetBlock(unsigned long position,
 }
 
 void FakeFileAccess::SetRequestedDataAvailable() {
+  if (!requested_data_.IsEmpty())
+    ++round_trip_count_;
   available_data_.Union(requested_data_);
   requested_data_.Clear();
 }
@@ -27,9 +27,13 @@ class FakeFileAccess {
   unsigned long GetFileSize();
 
   int GetBlock(unsigned long position, unsigned char* pBuf, unsigned long size);
+  // Makes the data requested since the last call available, as if it had
+  // been fetched in one round trip.
   void SetRequestedDataAvailable();
   void SetWholeFileAvailable();
 
+  int GetRoundTripCount() const { return round_trip_count_; }
+
  private:
   UnownedPtr<FPDF_FILEACCESS> file_access_;
   std::unique_ptr<FPDF_FILEACCESS> file_access_wrapper_;
@@ -37,6 +41,7 @@ class FakeFileAccess {
   std::unique_ptr<FX_DOWNLOADHINTS> download_hints_;
   RangeSet available_data_;
   RangeSet requested_data_;
+  int round_trip_count_ = 0;
 };
 
 #endif  // TESTING_FAKE_FILE_ACCESS_H_
@@ -12,7 +12,7 @@ PDFTestEnvironment::~PDFTestEnvironment() = default;
 
 // testing::Environment:
 void PDFTestEnvironment::SetUp() {
-  CFX_GEModule::Create(nullptr);
+  CFX_GEModule::Create(nullptr, nullptr);
 }
 
 void PDFTestEnvironment::TearDown() {